@@ -0,0 +1,1249 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 9:14:08am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../DSP/ChorusEngine.h"
+#include "../DSP/ChorusEngineBatch.h"
+#include "../PluginState.h"
+
+//==============================================================================
+// chorus-bench voices
+//     plots the cost against the number of voices for each interpolation and fits the cost of one voice
+// chorus-bench interpolation
+//     measures the cost of a delay read and the thd+n of a modulated delay for each interpolation and its quality tier
+// chorus-bench mix
+//     compares each mode at a settled dry, mixed and wet mix to show the work that's left out
+// chorus-bench small-blocks
+//     compares the cost of small blocks with the same number of samples in 512 sample blocks
+// chorus-bench control-rate
+//     compares the lfos evaluated every sample with the plugin's control rate at 44.1, 96 and 192 kHz
+// chorus-bench layout
+//     compares filling the chorus block with the dry signal and adding the voices with writing dry + the voices at once
+// chorus-bench cost [configurations]
+//     calibrates the cost model on this machine and prints it in the form of ChorusEngine::costModel, then checks how the
+//     costs of random configurations compare in it and the built in model and fails if the built in model is further off
+//     than the tolerance
+// chorus-bench batch
+//     compares the streams per core of a ChorusEngineBatch with one ChorusEngine for each stream
+// chorus-bench clips [clips] [seconds per clip] [threads] [runs]
+//     renders clips with the settings of Source/Python/benchmark.py and one engine per thread, the native side of its numbers
+// chorus-bench state [instances]
+//     times writing and reading the binary plugin state of many instances, with and without morph snapshots
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const double sampleRate{ 48000.0 };
+    const size_t defaultBlockSize{ 512 };
+
+    // the plugin's lfo control rate at full quality
+    const float pluginControlRate{ 2500.0f };
+
+    // each measurement processes this much of the signal, after one pass to let the smoothed values settle
+    const double signalSeconds{ 0.5 };
+    const size_t numRepeats{ 7 };
+
+    //==============================================================================
+    // channels of samples with a block view, the engines read the input and write to a separate output
+    template<typename SampleType>
+    class Buffer
+    {
+    public:
+        Buffer(size_t numChannels, size_t numSamples) : m_samples(numChannels, std::vector<SampleType>(numSamples))
+        {
+            for (auto& channel : m_samples)
+                m_channels.push_back(channel.data());
+        }
+
+        void fillWithNoise(unsigned seed)
+        {
+            std::mt19937 random(seed);
+            std::uniform_real_distribution<SampleType> noise(SampleType(-1), SampleType(1));
+
+            for (auto& channel : m_samples)
+                for (auto& sample : channel)
+                    sample = noise(random);
+        }
+
+        size_t getNumChannels() const { return m_samples.size(); }
+        size_t getNumSamples() const { return m_samples.empty() ? 0 : m_samples[0].size(); }
+
+        dingus::AudioBlock<SampleType> getBlock(size_t startSample, size_t numSamples)
+        {
+            return dingus::AudioBlock<SampleType>(m_channels.data(), m_channels.size(), startSample, numSamples);
+        }
+
+        // a block of some of the channels
+        dingus::AudioBlock<SampleType> getBlock(size_t firstChannel, size_t numChannels, size_t startSample, size_t numSamples)
+        {
+            return dingus::AudioBlock<SampleType>(m_channels.data() + firstChannel, numChannels, startSample, numSamples);
+        }
+
+    private:
+        std::vector<std::vector<SampleType>> m_samples;
+        std::vector<SampleType*> m_channels;
+    };
+
+
+    //==============================================================================
+    // applies the settings the cost depends on, the rest are the plugin defaults
+    template<typename EngineType>
+    void applySettings(EngineType& engine, const dingus::CostSettings& settings)
+    {
+        engine.setRate(2.0f);
+        engine.setDepth(0.5f);
+        engine.setDelayTime(0.005f);
+        engine.setLfoControlRate(pluginControlRate);
+        engine.setMode(settings.mode);
+        engine.setNumVoice(settings.numVoices);
+        engine.setFilterBypass(settings.filterBypass);
+        engine.setInterpolation(settings.interpolation);
+        engine.setMix(static_cast<float>(settings.mix));
+    }
+
+    // processes the whole input in blocks of blockSize
+    template<typename SampleType, typename EngineType>
+    void processSignal(EngineType& engine, Buffer<SampleType>& input, Buffer<SampleType>& output, size_t blockSize)
+    {
+        auto numSamples = input.getNumSamples();
+
+        for (size_t start = 0; start < numSamples; start += blockSize)
+        {
+            auto blockLength = std::min(blockSize, numSamples - start);
+            dingus::AudioBlock<const SampleType> inputBlock = input.getBlock(start, blockLength);
+            auto outputBlock = output.getBlock(start, blockLength);
+
+            dingus::ProcessContextNonReplacing<SampleType> context(inputBlock, outputBlock);
+            engine.process(context);
+        }
+    }
+
+    // returns the time in ns it took to process one sample on every channel of the input
+    template<typename SampleType, typename EngineType>
+    double timeSignal(EngineType& engine, Buffer<SampleType>& input, Buffer<SampleType>& output, size_t blockSize)
+    {
+        auto start = Clock::now();
+        processSignal(engine, input, output, blockSize);
+        auto nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        return nanoseconds / static_cast<double>(input.getNumSamples());
+    }
+
+    // returns the time in ns to process one sample on every channel
+    // the fastest pass is used since it's the one the rest of the system got in the way of the least
+    template<typename SampleType, typename EngineType>
+    double measure(EngineType& engine, Buffer<SampleType>& input, Buffer<SampleType>& output, size_t blockSize)
+    {
+        processSignal(engine, input, output, blockSize);
+
+        double fastestTime = std::numeric_limits<double>::max();
+
+        for (size_t repeat = 0; repeat < numRepeats; ++repeat)
+            fastestTime = std::min(fastestTime, timeSignal(engine, input, output, blockSize));
+
+        return fastestTime;
+    }
+
+    // returns a new engine prepared for the channels of the input with the settings
+    template<typename EngineType>
+    std::unique_ptr<EngineType> createEngine(const dingus::CostSettings& settings, size_t numChannels, size_t blockSize,
+        double engineSampleRate = sampleRate)
+    {
+        auto engine = std::make_unique<EngineType>();
+        engine->prepare({ engineSampleRate, static_cast<std::uint32_t>(blockSize), static_cast<std::uint32_t>(numChannels) });
+        applySettings(*engine, settings);
+
+        return engine;
+    }
+
+    // prepares a new engine with the settings and measures it, so nothing carries over from the last measurement
+    template<typename EngineType, typename SampleType>
+    double measureSettings(const dingus::CostSettings& settings, Buffer<SampleType>& input, Buffer<SampleType>& output,
+        size_t blockSize = defaultBlockSize)
+    {
+        auto engine = createEngine<EngineType>(settings, input.getNumChannels(), blockSize);
+        return measure(*engine, input, output, blockSize);
+    }
+
+    //==============================================================================
+    // prints a bar for each voice count and the slope of a least squares line through the costs
+    int benchVoices()
+    {
+        const size_t voiceCounts[]{ 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64 };
+        const char* interpolationNames[]{ "linear", "hermite", "lagrange", "thiran" };
+        const size_t plotWidth{ 60 };
+
+        Buffer<float> input(2, static_cast<size_t>(signalSeconds * sampleRate));
+        Buffer<float> output(2, input.getNumSamples());
+        input.fillWithNoise(1);
+
+        for (size_t interpolation = 0; interpolation < static_cast<size_t>(dingus::Interpolation::MAX); ++interpolation)
+        {
+            std::vector<double> costs;
+
+            for (auto numVoices : voiceCounts)
+            {
+                dingus::CostSettings settings;
+                settings.numVoices = numVoices;
+                settings.interpolation = static_cast<dingus::Interpolation>(interpolation);
+                costs.push_back(measureSettings<dingus::ChorusEngine<float>>(settings, input, output));
+            }
+
+            double meanVoices = 0.0;
+            double meanCost = 0.0;
+
+            for (size_t i = 0; i < costs.size(); ++i)
+            {
+                meanVoices += static_cast<double>(voiceCounts[i]) / static_cast<double>(costs.size());
+                meanCost += costs[i] / static_cast<double>(costs.size());
+            }
+
+            double covariance = 0.0;
+            double variance = 0.0;
+
+            for (size_t i = 0; i < costs.size(); ++i)
+            {
+                covariance += (static_cast<double>(voiceCounts[i]) - meanVoices) * (costs[i] - meanCost);
+                variance += (static_cast<double>(voiceCounts[i]) - meanVoices) * (static_cast<double>(voiceCounts[i]) - meanVoices);
+            }
+
+            double slope = covariance / variance;
+
+            // the plot is per channel like the slope
+            std::printf("stereo float engine, %s interpolation, ns per sample and channel\n", interpolationNames[interpolation]);
+            double maxCost = *std::max_element(costs.begin(), costs.end());
+
+            for (size_t i = 0; i < costs.size(); ++i)
+            {
+                auto barLength = static_cast<size_t>(static_cast<double>(plotWidth) * costs[i] / maxCost + 0.5);
+                std::printf("%3zu voices %8.1f |%s\n", voiceCounts[i], 0.5 * costs[i], std::string(barLength, '#').c_str());
+            }
+
+            std::printf("each voice adds %.2f ns, the engine without voices costs %.1f ns\n\n", 0.5 * slope,
+                0.5 * (meanCost - slope * meanVoices));
+            std::fflush(stdout);
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    // returns the error of a modulated delay against the ideal delayed sine in dB below the sine, which is its thd+n
+    // a copy of the delay's lfo gives the delay time of each sample, a tap reads the buffer before the input is pushed so
+    // the ideal output is one sample later than the delay time
+    double getDelayError(dingus::Interpolation interpolation, double frequency)
+    {
+        const float rate{ 1.0f };
+        const double delayTime{ 0.01 };
+        const double maxDepth{ 1.0e-3 };
+        const auto numSamples = static_cast<size_t>(sampleRate);
+
+        dingus::ProcessSpec spec{ sampleRate, static_cast<std::uint32_t>(numSamples), 1 };
+        dingus::ModDelay<float, 64> delay;
+        delay.prepare(spec);
+        delay.setLfoType(dingus::WaveType::SINE);
+        delay.setRate(rate);
+        delay.setDepth(1.0f);
+        delay.setTapDelayTime(0, static_cast<float>(delayTime), 0, true);
+        delay.setInterpolation(interpolation);
+
+        dingus::Oscillator<float> lfo;
+        lfo.prepare(spec);
+        lfo.setFrequency(rate);
+        lfo.setType(dingus::WaveType::SINE);
+
+        double phaseDelta = 2.0 * 3.141592653589793 * frequency / sampleRate;
+        std::vector<float> input(numSamples);
+        std::vector<float> output(numSamples);
+        std::vector<float> dry(numSamples, 0.0f);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            input[i] = static_cast<float>(std::sin(phaseDelta * static_cast<double>(i)));
+
+        delay.processTaps(input.data(), output.data(), numSamples, 0, 1, 1.0f, dry.data());
+
+        // the first half is left out while the depth ramps up from 0
+        double errorPower = 0.0;
+        double signalPower = 0.0;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            double delaySamples = (delayTime + (static_cast<double>(lfo.processSample()) + 2.0) * 0.5 * maxDepth) * sampleRate;
+
+            if (i < numSamples / 2)
+                continue;
+
+            double ideal = std::sin(phaseDelta * (static_cast<double>(i) - delaySamples - 1.0));
+            errorPower += (output[i] - ideal) * (output[i] - ideal);
+            signalPower += ideal * ideal;
+        }
+
+        return 10.0 * std::log10(errorPower / signalPower);
+    }
+
+    // the cost is of 64 taps on one delay line, which is what a channel of the plugin runs at the most voices
+    // linear is used for playback at every quality tier and lagrange for offline renders
+    int benchInterpolation()
+    {
+        const char* interpolationNames[]{ "linear", "hermite", "lagrange", "thiran" };
+        const char* tierNames[]{ "realtime", "", "offline", "" };
+        const double frequencies[]{ 1000.0, 5000.0, 10000.0 };
+        const size_t numTaps{ 64 };
+
+        Buffer<float> input(1, static_cast<size_t>(signalSeconds * sampleRate));
+        Buffer<float> output(1, input.getNumSamples());
+        input.fillWithNoise(1);
+
+        std::printf("float delay at 48kHz, thd+n of a sine through 11 ms +- 0.5 ms at 2 Hz and ns per read of %zu taps\n", numTaps);
+        std::printf("%-10s %-10s %-9s %-9s %-9s %s\n", "", "tier", "1 kHz", "5 kHz", "10 kHz", "ns/read");
+
+        for (size_t interpolation = 0; interpolation < static_cast<size_t>(dingus::Interpolation::MAX); ++interpolation)
+        {
+            auto type = static_cast<dingus::Interpolation>(interpolation);
+            std::printf("%-10s %-10s", interpolationNames[interpolation], tierNames[interpolation]);
+
+            for (auto frequency : frequencies)
+                std::printf(" %-9s", (std::to_string(static_cast<int>(std::round(getDelayError(type, frequency)))) + " dB").c_str());
+
+            dingus::ModDelay<float, numTaps> delay;
+            delay.prepare({ sampleRate, static_cast<std::uint32_t>(defaultBlockSize), 1 });
+            delay.setRate(2.0f);
+            delay.setDepth(0.5f);
+            delay.setInterpolation(type);
+
+            for (size_t tap = 0; tap < numTaps; ++tap)
+                delay.setTapDelayTime(tap, 0.005f + 0.0002f * static_cast<float>(tap), 0, true);
+
+            auto* inputSamples = input.getBlock(0, input.getNumSamples()).getChannelPointer(0);
+            auto* outputSamples = output.getBlock(0, output.getNumSamples()).getChannelPointer(0);
+            double fastestTime = std::numeric_limits<double>::max();
+
+            for (size_t repeat = 0; repeat <= numRepeats; ++repeat)
+            {
+                auto start = Clock::now();
+
+                for (size_t i = 0; i < input.getNumSamples(); i += defaultBlockSize)
+                {
+                    auto numSamples = std::min(defaultBlockSize, input.getNumSamples() - i);
+                    delay.processTaps(inputSamples + i, outputSamples + i, numSamples, 0, numTaps, 1.0f, inputSamples + i);
+                }
+
+                auto nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+                // the first pass lets the depth settle
+                if (repeat > 0)
+                    fastestTime = std::min(fastestTime, nanoseconds / static_cast<double>(input.getNumSamples() * numTaps));
+            }
+
+            std::printf(" %.2f\n", fastestTime);
+            std::fflush(stdout);
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    // the mix only leaves out work once it has settled, the first pass of each measurement lets it settle
+    int benchMix()
+    {
+        const char* modeNames[]{ "stereo", "mono", "dimension", "vibrato" };
+        const double mixes[]{ 0.0, 0.5, 1.0 };
+        const size_t voiceCounts[]{ 1, 8 };
+
+        Buffer<float> input(2, static_cast<size_t>(signalSeconds * sampleRate));
+        Buffer<float> output(2, input.getNumSamples());
+        input.fillWithNoise(1);
+
+        std::printf("stereo float engine, ns per sample, the saving is against the mix at 0.5\n");
+        std::printf("%-10s %-7s %-9s %-9s %-9s %8s  %8s\n", "mode", "voices", "dry", "mixed", "wet", "dry save", "wet save");
+
+        for (size_t mode = 0; mode < 4; ++mode)
+        {
+            for (auto numVoices : voiceCounts)
+            {
+                double costs[3];
+
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    dingus::CostSettings settings;
+                    settings.mode = static_cast<dingus::Mode>(mode);
+                    settings.numVoices = numVoices;
+                    settings.mix = mixes[i];
+                    costs[i] = measureSettings<dingus::ChorusEngine<float>>(settings, input, output);
+                }
+
+                std::printf("%-10s %-7zu %-9.1f %-9.1f %-9.1f %7.0f%%  %7.0f%%\n", modeNames[mode], numVoices, costs[0], costs[1], costs[2],
+                    100.0 * (1.0 - costs[0] / costs[1]), 100.0 * (1.0 - costs[2] / costs[1]));
+                std::fflush(stdout);
+            }
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    // before the voices took a dry block the engine copied the dry signal into the chorus block and the voices added to it,
+    // so every output sample was written twice, the voices are timed on their own in both ways in alternating passes
+    // a held delay uses the constant delay kernel, where the memory traffic is the larger part of the cost
+    int benchLayout()
+    {
+        const size_t blockSizes[]{ 64, 512, 4096 };
+        const size_t channelCounts[]{ 2, 8 };
+        const float depths[]{ 0.0f, 0.5f };
+
+        std::printf("float voices, 1 voice, ns per sample and channel copying the dry signal first and writing it with the voices\n");
+        std::printf("%-9s %-9s %-10s %-9s %-9s %s\n", "delay", "channels", "block", "copy", "dry", "saving");
+
+        for (auto depth : depths)
+        {
+            for (auto numChannels : channelCounts)
+            {
+                Buffer<float> input(numChannels, static_cast<size_t>(signalSeconds * sampleRate));
+                Buffer<float> output(numChannels, input.getNumSamples());
+                input.fillWithNoise(1);
+                auto numSamples = input.getNumSamples();
+
+                for (auto blockSize : blockSizes)
+                {
+                    dingus::ChorusVoices<float> voices[2];
+
+                    for (auto& voice : voices)
+                    {
+                        voice.prepare({ sampleRate, static_cast<std::uint32_t>(blockSize), static_cast<std::uint32_t>(numChannels) });
+                        voice.setLfoControlRate(pluginControlRate);
+                        voice.setDepth(depth);
+                        voice.setDelayTime(0.005f);
+                    }
+
+                    // the first pass of each lets the delay times settle
+                    double costs[2]{ std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+
+                    for (size_t repeat = 0; repeat <= numRepeats; ++repeat)
+                    {
+                        for (size_t layout = 0; layout < 2; ++layout)
+                        {
+                            auto start = Clock::now();
+
+                            for (size_t i = 0; i < numSamples; i += blockSize)
+                            {
+                                auto blockLength = std::min(blockSize, numSamples - i);
+                                dingus::AudioBlock<const float> inputBlock = input.getBlock(i, blockLength);
+                                auto outputBlock = output.getBlock(i, blockLength);
+                                dingus::ProcessContextNonReplacing<float> context(inputBlock, outputBlock);
+
+                                if (layout == 0)
+                                {
+                                    for (size_t channel = 0; channel < numChannels; ++channel)
+                                        std::copy(inputBlock.getChannelPointer(channel), inputBlock.getChannelPointer(channel) + blockLength,
+                                            outputBlock.getChannelPointer(channel));
+
+                                    voices[layout].process(context);
+                                }
+                                else
+                                {
+                                    voices[layout].process(context, inputBlock);
+                                }
+                            }
+
+                            auto nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+                            if (repeat > 0)
+                                costs[layout] = std::min(costs[layout], nanoseconds / static_cast<double>(numSamples * numChannels));
+                        }
+                    }
+
+                    std::printf("%-9s %-9zu %-10zu %-9.2f %-9.2f %5.0f%%\n", depth == 0.0f ? "held" : "moving", numChannels, blockSize,
+                        costs[0], costs[1], 100.0 * (1.0 - costs[1] / costs[0]));
+                    std::fflush(stdout);
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    // the cost of a block over the cost of its samples in large blocks is the overhead of each call
+    // the two block sizes are timed in alternating passes so they both see the same changes in the speed of the machine
+    int benchSmallBlocks()
+    {
+        const size_t blockSizes[]{ 1, 2, 4, 8, 16, 32, 64, 128 };
+        const size_t voiceCounts[]{ 1, 8 };
+
+        Buffer<float> input(2, static_cast<size_t>(signalSeconds * sampleRate));
+        Buffer<float> output(2, input.getNumSamples());
+        input.fillWithNoise(1);
+
+        std::printf("stereo float engine, ns per block, and the ratio to the same samples in %zu sample blocks\n", defaultBlockSize);
+
+        for (auto numVoices : voiceCounts)
+        {
+            dingus::CostSettings settings;
+            settings.numVoices = numVoices;
+            std::printf("%zu voices\n", numVoices);
+
+            for (auto blockSize : blockSizes)
+            {
+                auto largeBlockEngine = createEngine<dingus::ChorusEngine<float>>(settings, 2, defaultBlockSize);
+                auto smallBlockEngine = createEngine<dingus::ChorusEngine<float>>(settings, 2, blockSize);
+                processSignal(*largeBlockEngine, input, output, defaultBlockSize);
+                processSignal(*smallBlockEngine, input, output, blockSize);
+
+                double sampleCost = std::numeric_limits<double>::max();
+                double blockCost = std::numeric_limits<double>::max();
+
+                for (size_t repeat = 0; repeat < numRepeats; ++repeat)
+                {
+                    sampleCost = std::min(sampleCost, timeSignal(*largeBlockEngine, input, output, defaultBlockSize));
+                    blockCost = std::min(blockCost, static_cast<double>(blockSize) * timeSignal(*smallBlockEngine, input, output, blockSize));
+                }
+
+                std::printf("%5zu samples %10.1f ns %6.2fx\n", blockSize, blockCost, blockCost / (static_cast<double>(blockSize) * sampleCost));
+                std::fflush(stdout);
+            }
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    // without a control rate the lfo of each channel is evaluated every sample, the voices share it so the saving is the
+    // same for any number of voices, the two are timed in alternating passes like the small blocks
+    int benchControlRate()
+    {
+        const double sampleRates[]{ 44100.0, 96000.0, 192000.0 };
+        const size_t voiceCounts[]{ 1, 8, 64 };
+
+        std::printf("stereo float engine, %zu sample blocks, ns per sample with the lfos evaluated every sample and at %.0f Hz\n",
+            defaultBlockSize, pluginControlRate);
+        std::printf("%-12s %-9s %-9s %-12s %-12s %s\n", "sample rate", "interval", "voices", "per sample", "control rate", "saving");
+
+        for (auto engineSampleRate : sampleRates)
+        {
+            Buffer<float> input(2, static_cast<size_t>(signalSeconds * engineSampleRate));
+            Buffer<float> output(2, input.getNumSamples());
+            input.fillWithNoise(1);
+
+            for (auto numVoices : voiceCounts)
+            {
+                dingus::CostSettings settings;
+                settings.numVoices = numVoices;
+
+                auto sampleEngine = createEngine<dingus::ChorusEngine<float>>(settings, 2, defaultBlockSize, engineSampleRate);
+                auto controlEngine = createEngine<dingus::ChorusEngine<float>>(settings, 2, defaultBlockSize, engineSampleRate);
+                sampleEngine->setLfoControlRate(0.0f);
+                processSignal(*sampleEngine, input, output, defaultBlockSize);
+                processSignal(*controlEngine, input, output, defaultBlockSize);
+
+                double sampleCost = std::numeric_limits<double>::max();
+                double controlCost = std::numeric_limits<double>::max();
+
+                for (size_t repeat = 0; repeat < numRepeats; ++repeat)
+                {
+                    sampleCost = std::min(sampleCost, timeSignal(*sampleEngine, input, output, defaultBlockSize));
+                    controlCost = std::min(controlCost, timeSignal(*controlEngine, input, output, defaultBlockSize));
+                }
+
+                std::printf("%-12.0f %-9zu %-9zu %-12.1f %-12.1f %5.0f%%\n", engineSampleRate,
+                    dingus::getControlInterval(engineSampleRate, pluginControlRate), numVoices, sampleCost, controlCost,
+                    100.0 * (1.0 - controlCost / sampleCost));
+                std::fflush(stdout);
+            }
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    // times engines in alternating passes with a reference engine, each time is scaled by how much faster or slower the
+    // reference was than its first measurement, so changes in the speed of the machine don't end up in the results
+    template<typename SampleType>
+    class RelativeTimer
+    {
+    public:
+        RelativeTimer() : m_input(2, static_cast<size_t>(signalSeconds * sampleRate)), m_output(2, m_input.getNumSamples())
+        {
+            m_input.fillWithNoise(1);
+            m_reference = createEngine<dingus::ChorusEngine<SampleType>>(dingus::CostSettings(), 2, defaultBlockSize);
+            m_referenceTime = measure(*m_reference, m_input, m_output, defaultBlockSize);
+        }
+
+        // returns the cost of the settings over the cost of the default settings in 512 sample blocks
+        // this is the median ratio of pairs of passes, so a pass that something else got in the way of is left out
+        // and the ratio doesn't follow the speed of the machine drifting during the run
+        double getRatio(const dingus::CostSettings& settings, size_t blockSize)
+        {
+            auto engine = createEngine<dingus::ChorusEngine<SampleType>>(settings, 2, blockSize);
+            processSignal(*engine, m_input, m_output, blockSize);
+
+            std::vector<double> ratios;
+
+            for (size_t pair = 0; pair < numPairs; ++pair)
+            {
+                double referenceTime = timeSignal(*m_reference, m_input, m_output, defaultBlockSize);
+                ratios.push_back(timeSignal(*engine, m_input, m_output, blockSize) / referenceTime);
+            }
+
+            std::sort(ratios.begin(), ratios.end());
+            return ratios[numPairs / 2];
+        }
+
+        // returns the time in ns to process one sample on both channels of a stereo engine
+        double getTime(const dingus::CostSettings& settings, size_t blockSize)
+        {
+            return getRatio(settings, blockSize) * m_referenceTime;
+        }
+
+    private:
+        static constexpr size_t numPairs{ 15 };
+
+        Buffer<SampleType> m_input;
+        Buffer<SampleType> m_output;
+        std::unique_ptr<dingus::ChorusEngine<SampleType>> m_reference;
+        double m_referenceTime{ 1.0 };
+    };
+
+    // solves rows * x = targets in the least squares sense with the normal equations
+    std::vector<double> solveLeastSquares(const std::vector<std::vector<double>>& rows, const std::vector<double>& targets)
+    {
+        auto numUnknowns = rows[0].size();
+        std::vector<std::vector<double>> matrix(numUnknowns, std::vector<double>(numUnknowns + 1, 0.0));
+
+        for (size_t row = 0; row < rows.size(); ++row)
+        {
+            for (size_t i = 0; i < numUnknowns; ++i)
+            {
+                for (size_t j = 0; j < numUnknowns; ++j)
+                    matrix[i][j] += rows[row][i] * rows[row][j];
+
+                matrix[i][numUnknowns] += rows[row][i] * targets[row];
+            }
+        }
+
+        // gaussian elimination with partial pivoting
+        for (size_t column = 0; column < numUnknowns; ++column)
+        {
+            auto pivot = column;
+
+            for (size_t i = column + 1; i < numUnknowns; ++i)
+                if (std::abs(matrix[i][column]) > std::abs(matrix[pivot][column]))
+                    pivot = i;
+
+            std::swap(matrix[column], matrix[pivot]);
+
+            for (size_t i = column + 1; i < numUnknowns; ++i)
+            {
+                double factor = matrix[i][column] / matrix[column][column];
+
+                for (size_t j = column; j <= numUnknowns; ++j)
+                    matrix[i][j] -= factor * matrix[column][j];
+            }
+        }
+
+        std::vector<double> solution(numUnknowns);
+
+        for (size_t i = numUnknowns; i-- > 0;)
+        {
+            double sum = matrix[i][numUnknowns];
+
+            for (size_t j = i + 1; j < numUnknowns; ++j)
+                sum -= matrix[i][j] * solution[j];
+
+            solution[i] = sum / matrix[i][i];
+        }
+
+        return solution;
+    }
+
+    // fits the model to configurations that cover every mode and interpolation with random voices, filters and block sizes
+    // the rows are divided by the measured cost so the fit minimises the relative error, like the check
+    template<typename SampleType>
+    dingus::CostModel calibrate(RelativeTimer<SampleType>& timer)
+    {
+        const size_t voiceCounts[]{ 1, 2, 4, 8, 16, 32, 64 };
+        const size_t blockSizes[]{ 32, 64, 256, 1024 };
+        const size_t numInterpolations{ static_cast<size_t>(dingus::Interpolation::MAX) };
+
+        std::mt19937 random(2);
+
+        // the mixed rows are mode, filter, voices for each interpolation and 1 / block size
+        // the dry rows are mode and 1 / block size
+        std::vector<std::vector<double>> mixedRows;
+        std::vector<double> mixedTargets;
+        std::vector<std::vector<double>> dryRows;
+        std::vector<double> dryTargets;
+
+        auto addMixedRow = [&](const dingus::CostSettings& settings, size_t blockSize)
+        {
+            double cost = 0.5 * timer.getTime(settings, blockSize);
+            std::vector<double> row(4 + 1 + numInterpolations + 1, 0.0);
+            row[static_cast<size_t>(settings.mode)] = 1.0;
+            row[4] = settings.filterBypass ? 0.0 : 1.0;
+            row[5 + static_cast<size_t>(settings.interpolation)] = static_cast<double>(settings.numVoices);
+            row[5 + numInterpolations] = 1.0 / static_cast<double>(blockSize);
+
+            for (auto& value : row)
+                value /= cost;
+
+            mixedRows.push_back(row);
+            mixedTargets.push_back(1.0);
+        };
+
+        for (size_t repeat = 0; repeat < 3; ++repeat)
+        {
+            for (size_t mode = 0; mode < 4; ++mode)
+            {
+                for (size_t interpolation = 0; interpolation < numInterpolations; ++interpolation)
+                {
+                    dingus::CostSettings settings;
+                    settings.mode = static_cast<dingus::Mode>(mode);
+                    settings.numVoices = voiceCounts[random() % 7];
+                    settings.filterBypass = random() % 2 == 0;
+                    settings.interpolation = static_cast<dingus::Interpolation>(interpolation);
+                    addMixedRow(settings, blockSizes[random() % 4]);
+                }
+            }
+        }
+
+        // the dry cost doesn't depend on the voices or the filters, each dry configuration is quick so it's measured twice
+        for (size_t repeat = 0; repeat < 2; ++repeat)
+        {
+            for (size_t mode = 0; mode < 4; ++mode)
+            {
+                for (auto blockSize : blockSizes)
+                {
+                    dingus::CostSettings settings;
+                    settings.mode = static_cast<dingus::Mode>(mode);
+                    settings.mix = 0.0;
+
+                    double cost = 0.5 * timer.getTime(settings, blockSize);
+                    std::vector<double> row(4 + 1, 0.0);
+                    row[mode] = 1.0 / cost;
+                    row[4] = 1.0 / (static_cast<double>(blockSize) * cost);
+
+                    dryRows.push_back(row);
+                    dryTargets.push_back(1.0);
+                }
+            }
+        }
+
+        auto mixed = solveLeastSquares(mixedRows, mixedTargets);
+        auto dry = solveLeastSquares(dryRows, dryTargets);
+
+        dingus::CostModel model{};
+
+        for (size_t mode = 0; mode < 4; ++mode)
+        {
+            model.modeCost[mode] = mixed[mode];
+            model.dryCost[mode] = dry[mode];
+        }
+
+        model.filterCost = mixed[4];
+
+        for (size_t interpolation = 0; interpolation < numInterpolations; ++interpolation)
+            model.voiceCost[interpolation] = mixed[5 + interpolation];
+
+        model.blockCost = mixed[5 + numInterpolations];
+        model.dryBlockCost = dry[4];
+
+        return model;
+    }
+
+    void printCostModel(const dingus::CostModel& model)
+    {
+        std::printf("CostModel{ { %.2f, %.2f, %.2f, %.2f }, %.2f, { %.2f, %.2f, %.2f, %.2f }, %.1f, { %.2f, %.2f, %.2f, %.2f }, %.1f }\n",
+            model.modeCost[0], model.modeCost[1], model.modeCost[2], model.modeCost[3], model.filterCost,
+            model.voiceCost[0], model.voiceCost[1], model.voiceCost[2], model.voiceCost[3], model.blockCost,
+            model.dryCost[0], model.dryCost[1], model.dryCost[2], model.dryCost[3], model.dryBlockCost);
+    }
+
+    struct CostError
+    {
+        double mean{ 0.0 };
+        double max{ 0.0 };
+        dingus::CostSettings worstSettings;
+        size_t worstBlockSize{ 0 };
+    };
+
+    // a configuration of the check with its measured cost relative to the reference and its estimates
+    struct CostSample
+    {
+        dingus::CostSettings settings;
+        size_t blockSize;
+        double measured;
+        double estimate;
+        double builtInEstimate;
+    };
+
+    // the models are only checked on how the costs of the configurations compare, so each is scaled by the median
+    // of the measured over the estimated costs, this takes out the speed of the machine the built in model wasn't fitted on
+    // the errors are relative to the measured cost, costs under minimumRatio of the reference are compared with
+    // minimumRatio instead, eg. a dry mix, the difference is within the noise of the timing
+    double getScale(const std::vector<CostSample>& samples, bool isBuiltIn)
+    {
+        std::vector<double> scales;
+
+        for (auto& sample : samples)
+            scales.push_back(sample.measured / (isBuiltIn ? sample.builtInEstimate : sample.estimate));
+
+        std::sort(scales.begin(), scales.end());
+        return scales[scales.size() / 2];
+    }
+
+    const double minimumRatio{ 0.25 };
+
+    double getError(const CostSample& sample, double scale, bool isBuiltIn)
+    {
+        double estimate = scale * (isBuiltIn ? sample.builtInEstimate : sample.estimate);
+        return std::abs(estimate - sample.measured) / std::max(sample.measured, minimumRatio);
+    }
+
+    CostError getCostError(const std::vector<CostSample>& samples, bool isBuiltIn)
+    {
+        double scale = getScale(samples, isBuiltIn);
+        CostError costError;
+
+        for (auto& sample : samples)
+        {
+            double error = getError(sample, scale, isBuiltIn);
+            costError.mean += error / static_cast<double>(samples.size());
+
+            if (error > costError.max)
+            {
+                costError.max = error;
+                costError.worstSettings = sample.settings;
+                costError.worstBlockSize = sample.blockSize;
+            }
+        }
+
+        return costError;
+    }
+
+    // measures random configurations relative to the reference and compares them with the estimates of both models
+    // a configuration that either model misses by more than the tolerance is measured twice more and the median is used,
+    // so a single measurement that the rest of the system got in the way of doesn't decide the check
+    template<typename SampleType>
+    void validate(RelativeTimer<SampleType>& timer, const dingus::CostModel& model, size_t numConfigurations, double tolerance,
+        CostError& modelError, CostError& builtInError)
+    {
+        const size_t voiceCounts[]{ 1, 2, 3, 4, 8, 16, 32, 64 };
+        const double mixes[]{ 0.0, 0.3, 0.5, 1.0 };
+        const size_t blockSizes[]{ 64, 128, 256, 512, 1024 };
+
+        std::mt19937 random(1);
+        std::vector<CostSample> samples;
+
+        for (size_t i = 0; i < numConfigurations; ++i)
+        {
+            CostSample sample;
+            sample.settings.mode = static_cast<dingus::Mode>(random() % 4);
+            sample.settings.numVoices = voiceCounts[random() % 8];
+            sample.settings.filterBypass = random() % 2 == 0;
+            sample.settings.interpolation = static_cast<dingus::Interpolation>(random() % 4);
+            sample.settings.mix = mixes[random() % 4];
+            sample.blockSize = blockSizes[random() % 5];
+
+            dingus::ProcessSpec spec{ sampleRate, static_cast<std::uint32_t>(sample.blockSize), 2 };
+            sample.measured = timer.getRatio(sample.settings, sample.blockSize);
+            sample.estimate = dingus::ChorusEngine<SampleType>::estimateCost(spec, sample.settings, model);
+            sample.builtInEstimate = dingus::ChorusEngine<SampleType>::estimateCost(spec, sample.settings);
+            samples.push_back(sample);
+        }
+
+        double scale = getScale(samples, false);
+        double builtInScale = getScale(samples, true);
+
+        for (auto& sample : samples)
+        {
+            if (getError(sample, scale, false) <= tolerance && getError(sample, builtInScale, true) <= tolerance)
+                continue;
+
+            double measurements[]{ sample.measured, timer.getRatio(sample.settings, sample.blockSize),
+                timer.getRatio(sample.settings, sample.blockSize) };
+            std::sort(std::begin(measurements), std::end(measurements));
+            sample.measured = measurements[1];
+        }
+
+        modelError = getCostError(samples, false);
+        builtInError = getCostError(samples, true);
+    }
+
+    void printCostError(const char* name, const CostError& error, const char* status)
+    {
+        const char* modeNames[]{ "stereo", "mono", "dimension", "vibrato" };
+        const char* interpolationNames[]{ "linear", "hermite", "lagrange", "thiran" };
+        auto& worst = error.worstSettings;
+
+        std::printf("    %-9s mean error %4.1f%%, max error %4.1f%% (%s, %zu voices, %s, mix %.1f, filters %s, %zu sample blocks)%s\n", 
+            name, 100.0 * error.mean, 100.0 * error.max, modeNames[static_cast<size_t>(worst.mode)], worst.numVoices,
+            interpolationNames[static_cast<size_t>(worst.interpolation)], worst.mix, worst.filterBypass ? "off" : "on",
+            error.worstBlockSize, status);
+    }
+
+    // the built in model is what the plugin uses, so it has to estimate the relative costs within the tolerance
+    // it was calibrated on another machine so its absolute costs aren't checked
+    // the model fitted in this run comes from a single calibration, it's printed to update the built in model from but
+    // one noisy calibration row can put a configuration outside the tolerance, so it isn't checked
+    template<typename SampleType>
+    bool checkCostModel(const char* typeName, size_t numConfigurations, double tolerance)
+    {
+        RelativeTimer<SampleType> timer;
+        auto model = calibrate(timer);
+
+        std::printf("%s model: ", typeName);
+        printCostModel(model);
+
+        CostError modelError;
+        CostError builtInError;
+        validate(timer, model, numConfigurations, tolerance, modelError, builtInError);
+
+        bool passed = builtInError.max <= tolerance;
+
+        std::printf("%s over %zu configurations, each model scaled by its median ratio to the measured costs:\n", typeName, numConfigurations);
+        printCostError("this run", modelError, modelError.max <= tolerance ? "" : "  over the tolerance, not checked");
+        printCostError("built in", builtInError, passed ? "" : "  FAILED");
+        std::fflush(stdout);
+
+        return passed;
+    }
+
+    int benchCost(size_t numConfigurations)
+    {
+        const double tolerance{ 0.25 };
+
+        std::printf("stereo engine at %.0fHz, ns per sample and channel, costs are timed against 1 linear voice in stereo mode in 512 sample blocks\n",
+            sampleRate);
+        std::printf("tolerance %.0f%% of the measured cost, or of a quarter of that reference for cheaper configurations\n", 100.0 * tolerance);
+
+        bool passed = checkCostModel<float>("float", numConfigurations, tolerance);
+        passed = checkCostModel<double>("double", numConfigurations, tolerance) && passed;
+
+        return passed ? 0 : 1;
+    }
+
+    //==============================================================================
+    // the batch and the engines process the same streams in alternating passes, a stream per core is a stream in real time
+    int benchBatch()
+    {
+        const size_t streamCounts[]{ 1, 4, 16, 64, 256 };
+        const double batchSeconds{ 0.1 };
+
+        dingus::CostSettings settings;
+        settings.numVoices = 4;
+
+        std::printf("stereo float streams, %zu voices, %zu sample blocks, streams per core\n", settings.numVoices, defaultBlockSize);
+        std::printf("%-8s %-10s %-10s %-8s\n", "streams", "batch", "engines", "speedup");
+
+        for (auto numStreams : streamCounts)
+        {
+            Buffer<float> input(2 * numStreams, static_cast<size_t>(batchSeconds * sampleRate));
+            Buffer<float> output(2 * numStreams, input.getNumSamples());
+            input.fillWithNoise(1);
+
+            dingus::ProcessSpec spec{ sampleRate, static_cast<std::uint32_t>(defaultBlockSize), 2 };
+
+            auto batch = std::make_unique<dingus::ChorusEngineBatch<float>>();
+            batch->prepare(spec, numStreams);
+            applySettings(*batch, settings);
+
+            std::vector<std::unique_ptr<dingus::ChorusEngine<float>>> engines;
+
+            for (size_t stream = 0; stream < numStreams; ++stream)
+                engines.push_back(createEngine<dingus::ChorusEngine<float>>(settings, 2, defaultBlockSize));
+
+            // the engines take turns on each block, like a render server handing out the next block of every stream
+            auto processEngines = [&]()
+            {
+                auto numSamples = input.getNumSamples();
+
+                for (size_t start = 0; start < numSamples; start += defaultBlockSize)
+                {
+                    auto blockLength = std::min(defaultBlockSize, numSamples - start);
+
+                    for (size_t stream = 0; stream < numStreams; ++stream)
+                    {
+                        dingus::AudioBlock<const float> inputBlock = input.getBlock(2 * stream, 2, start, blockLength);
+                        auto outputBlock = output.getBlock(2 * stream, 2, start, blockLength);
+                        dingus::ProcessContextNonReplacing<float> context(inputBlock, outputBlock);
+                        engines[stream]->process(context);
+                    }
+                }
+            };
+
+            processSignal(*batch, input, output, defaultBlockSize);
+            processEngines();
+
+            double batchTime = std::numeric_limits<double>::max();
+            double enginesTime = std::numeric_limits<double>::max();
+
+            for (size_t repeat = 0; repeat < numRepeats; ++repeat)
+            {
+                batchTime = std::min(batchTime, timeSignal(*batch, input, output, defaultBlockSize));
+
+                auto start = Clock::now();
+                processEngines();
+                auto nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                enginesTime = std::min(enginesTime, nanoseconds / static_cast<double>(input.getNumSamples()));
+            }
+
+            // the times are per sample of every stream
+            double realTime = 1.0e9 / sampleRate;
+            std::printf("%-8zu %-10.1f %-10.1f %.2fx\n", numStreams, static_cast<double>(numStreams) * realTime / batchTime,
+                static_cast<double>(numStreams) * realTime / enginesTime, enginesTime / batchTime);
+            std::fflush(stdout);
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    // the settings and parameters of Source/Python/benchmark.py, the rest are the defaults of the bindings
+    template<typename SampleType>
+    std::unique_ptr<dingus::ChorusEngine<SampleType>> createClipEngine()
+    {
+        auto engine = std::make_unique<dingus::ChorusEngine<SampleType>>();
+        engine->setLfoControlRate(SampleType(2500));
+        engine->prepare({ sampleRate, static_cast<std::uint32_t>(defaultBlockSize), 2 });
+
+        engine->setRate(SampleType(1.5));
+        engine->setDepth(SampleType(0.7));
+        engine->setMix(SampleType(1));
+        engine->setDelayTime(SampleType(0.005));
+        engine->setDelayWidth(SampleType(0.3));
+        engine->setMode(dingus::Mode::DIMENSION);
+        engine->setNumVoice(4);
+        engine->setVoiceSpread(SampleType(1));
+        engine->setLfoType(dingus::WaveType::SINE);
+        engine->setPhaseOffset(SampleType(0.5), 0);
+        engine->setPhaseOffset(SampleType(0), 1);
+        engine->setHighPass(SampleType(20));
+        engine->setLowPass(SampleType(20000));
+        engine->setInterpolation(dingus::Interpolation::LAGRANGE);
+
+        return engine;
+    }
+
+    // renders the clips split over the threads like benchmark.py, each clip starts from a reset engine
+    // returns the clips per second of the fastest run
+    template<typename SampleType>
+    double measureClips(size_t numClips, double clipSeconds, size_t numThreads, size_t numRuns)
+    {
+        Buffer<SampleType> input(2, static_cast<size_t>(clipSeconds * sampleRate));
+        input.fillWithNoise(1);
+
+        std::vector<std::unique_ptr<dingus::ChorusEngine<SampleType>>> engines;
+        std::vector<Buffer<SampleType>> outputs;
+
+        for (size_t thread = 0; thread < numThreads; ++thread)
+        {
+            engines.push_back(createClipEngine<SampleType>());
+            outputs.emplace_back(2, input.getNumSamples());
+        }
+
+        double fastest = std::numeric_limits<double>::max();
+
+        for (size_t run = 0; run < numRuns; ++run)
+        {
+            std::vector<std::thread> workers;
+            auto start = Clock::now();
+
+            for (size_t thread = 0; thread < numThreads; ++thread)
+            {
+                size_t count = numClips / numThreads + (thread < numClips % numThreads ? 1 : 0);
+
+                workers.emplace_back([&, thread, count]()
+                {
+                    for (size_t clip = 0; clip < count; ++clip)
+                    {
+                        engines[thread]->reset();
+                        processSignal(*engines[thread], input, outputs[thread], defaultBlockSize);
+                    }
+                });
+            }
+
+            for (auto& worker : workers)
+                worker.join();
+
+            fastest = std::min(fastest, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        return static_cast<double>(numClips) / fastest;
+    }
+
+    // prints in the format of benchmark.py, which reads these lines to work out the overhead of the bindings
+    int benchClips(size_t numClips, double clipSeconds, size_t numThreads, size_t numRuns)
+    {
+        std::vector<size_t> threadCounts{ 1 };
+
+        if (numThreads > 1)
+            threadCounts.push_back(numThreads);
+
+        for (auto count : threadCounts)
+            std::printf("float32, %zu thread(s): %.1f clips/s of %g s\n", count, measureClips<float>(numClips, clipSeconds, count, numRuns), clipSeconds);
+
+        for (auto count : threadCounts)
+            std::printf("float64, %zu thread(s): %.1f clips/s of %g s\n", count, measureClips<double>(numClips, clipSeconds, count, numRuns), clipSeconds);
+
+        return 0;
+    }
+
+    //==============================================================================
+    // a state with random values in the range of each parameter
+    dingus::PluginState getRandomState(std::mt19937& random, size_t numSnapshots)
+    {
+        auto getRandomSnapshot = [&random]()
+        {
+            dingus::ParameterSnapshot snapshot;
+
+            for (size_t i = 0; i < dingus::numParameters; ++i)
+            {
+                auto& range = dingus::parameterRanges[i];
+                std::uniform_real_distribution<float> value(range.minimum, range.maximum);
+                snapshot.values[i] = range.isDiscrete ? std::floor(value(random)) : value(random);
+            }
+
+            return snapshot;
+        };
+
+        dingus::PluginState state;
+        state.values = getRandomSnapshot();
+        state.numSnapshots = numSnapshots;
+
+        for (size_t i = 0; i < numSnapshots; ++i)
+            state.snapshots[i] = getRandomSnapshot();
+
+        return state;
+    }
+
+    // saves and loads every instance like a host saving and reopening a session, the buffers are allocated up front
+    int benchState(size_t numInstances)
+    {
+        std::mt19937 random(1);
+
+        std::printf("%zu instances, ns per instance\n", numInstances);
+        std::printf("%-10s %-8s %-10s %-10s\n", "snapshots", "bytes", "write", "read");
+
+        for (size_t numSnapshots : { size_t(0), dingus::maxMorphSnapshots })
+        {
+            std::vector<dingus::PluginState> states;
+
+            for (size_t i = 0; i < numInstances; ++i)
+                states.push_back(getRandomState(random, numSnapshots));
+
+            auto stateSize = dingus::getStateSize(numSnapshots);
+            std::vector<char> data(numInstances * stateSize);
+            std::vector<dingus::PluginState> loadedStates(numInstances);
+
+            double writeTime = std::numeric_limits<double>::max();
+            double readTime = std::numeric_limits<double>::max();
+
+            for (size_t repeat = 0; repeat < numRepeats; ++repeat)
+            {
+                auto start = Clock::now();
+
+                for (size_t i = 0; i < numInstances; ++i)
+                    dingus::writeState(states[i], data.data() + i * stateSize);
+
+                auto middle = Clock::now();
+
+                for (size_t i = 0; i < numInstances; ++i)
+                {
+                    if (dingus::readState(data.data() + i * stateSize, stateSize, loadedStates[i]) != dingus::StateResult::LOADED)
+                    {
+                        std::fprintf(stderr, "instance %zu didn't load its state\n", i);
+                        return 1;
+                    }
+                }
+
+                auto end = Clock::now();
+                writeTime = std::min(writeTime, std::chrono::duration<double, std::nano>(middle - start).count());
+                readTime = std::min(readTime, std::chrono::duration<double, std::nano>(end - middle).count());
+            }
+
+            // the values are in range so they have to come back unchanged
+            for (size_t i = 0; i < numInstances; ++i)
+            {
+                if (loadedStates[i].values.values != states[i].values.values || loadedStates[i].numSnapshots != numSnapshots)
+                {
+                    std::fprintf(stderr, "instance %zu loaded different values\n", i);
+                    return 1;
+                }
+            }
+
+            std::printf("%-10zu %-8zu %-10.1f %-10.1f\n", numSnapshots, stateSize, writeTime / static_cast<double>(numInstances),
+                readTime / static_cast<double>(numInstances));
+        }
+
+        return 0;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    std::string command = argc > 1 ? argv[1] : "";
+
+    if (command == "voices")
+        return benchVoices();
+
+    if (command == "interpolation")
+        return benchInterpolation();
+
+    if (command == "mix")
+        return benchMix();
+
+    if (command == "small-blocks")
+        return benchSmallBlocks();
+
+    if (command == "control-rate")
+        return benchControlRate();
+
+    if (command == "layout")
+        return benchLayout();
+
+    if (command == "cost")
+    {
+        size_t numConfigurations = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 50;
+        return benchCost(std::max(numConfigurations, size_t(1)));
+    }
+
+    if (command == "batch")
+        return benchBatch();
+
+    if (command == "clips")
+    {
+        size_t numClips = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 40;
+        double clipSeconds = argc > 3 ? std::atof(argv[3]) : 5.0;
+        size_t numThreads = argc > 4 ? static_cast<size_t>(std::atoi(argv[4])) : 4;
+        size_t numRuns = argc > 5 ? static_cast<size_t>(std::atoi(argv[5])) : 3;
+        return benchClips(std::max(numClips, size_t(1)), std::max(clipSeconds, 0.001), std::max(numThreads, size_t(1)),
+            std::max(numRuns, size_t(1)));
+    }
+
+    if (command == "state")
+    {
+        size_t numInstances = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 500;
+        return benchState(std::max(numInstances, size_t(1)));
+    }
+
+    std::printf("usage: %s voices|interpolation|mix|small-blocks|control-rate|layout|cost [configurations]|batch|clips [clips] [seconds] [threads] [runs]|state [instances]\n", argv[0]);
+    return 1;
+}
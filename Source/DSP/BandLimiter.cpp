@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    BandLimiter.cpp
+    Created: 19 Oct 2026 10:12:41am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "BandLimiter.h"
+
+namespace dingus
+{
+
+//==============================================================================
+template <typename SampleType>
+BandLimiter<SampleType>::BandLimiter()
+{
+}
+
+template <typename SampleType>
+void BandLimiter<SampleType>::prepare(const ProcessSpec& spec)
+{
+    m_sampleRate = static_cast<SampleType>(spec.sampleRate);
+
+    m_hiPassState1.resize(spec.numChannels);
+    m_hiPassState2.resize(spec.numChannels);
+    m_lowPassState1.resize(spec.numChannels);
+    m_lowPassState2.resize(spec.numChannels);
+    m_channels.resize(spec.numChannels);
+
+    initTanTable();
+
+    m_hiPassCutoff.reset(spec.sampleRate, 0.5);
+    m_lowPassCutoff.reset(spec.sampleRate, 0.5);
+
+    // the coefficients are always valid, even before the first update
+    m_updateCounter = m_updateRate;
+    updateCoefficients();
+    reset();
+}
+
+template <typename SampleType>
+void BandLimiter<SampleType>::reset()
+{
+    std::fill(m_hiPassState1.begin(), m_hiPassState1.end(), SampleType(0));
+    std::fill(m_hiPassState2.begin(), m_hiPassState2.end(), SampleType(0));
+    std::fill(m_lowPassState1.begin(), m_lowPassState1.end(), SampleType(0));
+    std::fill(m_lowPassState2.begin(), m_lowPassState2.end(), SampleType(0));
+}
+
+//==============================================================================
+
+template <typename SampleType>
+void BandLimiter<SampleType>::setHighPass(SampleType cutoff)
+{
+    m_hiPassCutoff.setTargetValue(cutoff);
+}
+
+template <typename SampleType>
+void BandLimiter<SampleType>::setLowPass(SampleType cutoff)
+{
+    m_lowPassCutoff.setTargetValue(cutoff);
+}
+
+template <typename SampleType>
+void BandLimiter<SampleType>::setBypass(bool bypass)
+{
+    m_bypass = bypass;
+}
+
+template <typename SampleType>
+bool BandLimiter<SampleType>::isBypassed() const
+{
+    return m_bypass;
+}
+
+//==============================================================================
+
+template <typename SampleType>
+void BandLimiter<SampleType>::initTanTable()
+{
+    // the table covers 0 to nyquist, cutoffs are limited to just under nyquist where tan() blows up
+    m_tanTable.resize(m_tanTableSize + 1);
+    m_tanTableScale = static_cast<SampleType>(2 * m_tanTableSize) / m_sampleRate;
+    m_maxCutoff = m_sampleRate * SampleType(0.49);
+
+    for (size_t i = 0; i <= m_tanTableSize; ++i)
+    {
+        auto position = std::min(static_cast<double>(i) / static_cast<double>(2 * m_tanTableSize), 0.49);
+        m_tanTable[i] = static_cast<SampleType>(std::tan(MathConstants<double>::pi * position));
+    }
+}
+
+template <typename SampleType>
+SampleType BandLimiter<SampleType>::getTan(SampleType cutoff) const
+{
+    SampleType position = limit(SampleType(0), m_maxCutoff, cutoff) * m_tanTableScale;
+
+    size_t index0 = static_cast<size_t>(position);
+    size_t index1 = std::min(index0 + 1, m_tanTableSize);
+    SampleType frac = position - static_cast<SampleType>(index0);
+
+    return m_tanTable[index0] + frac * (m_tanTable[index1] - m_tanTable[index0]);
+}
+
+template <typename SampleType>
+void BandLimiter<SampleType>::updateCoefficients(int skip /*= 0*/)
+{
+    // the coefficients only need to change while a cutoff is moving
+    if (skip > 0 && !m_hiPassCutoff.isSmoothing() && !m_lowPassCutoff.isSmoothing())
+        return;
+
+    m_hiPassCutoff.skip(skip);
+    m_lowPassCutoff.skip(skip);
+
+    m_hiPassG = getTan(m_hiPassCutoff.getNextValue());
+    m_hiPassH = SampleType(1) / (SampleType(1) + m_feedback * m_hiPassG + m_hiPassG * m_hiPassG);
+
+    m_lowPassG = getTan(m_lowPassCutoff.getNextValue());
+    m_lowPassH = SampleType(1) / (SampleType(1) + m_feedback * m_lowPassG + m_lowPassG * m_lowPassG);
+}
+
+template <typename SampleType>
+void BandLimiter<SampleType>::processSamples(size_t startSample, size_t numSamples, size_t numChannels) noexcept
+{
+    const SampleType hiPassG = m_hiPassG;
+    const SampleType hiPassH = m_hiPassH;
+    const SampleType hiPassGain = m_hiPassG + m_feedback;
+    const SampleType lowPassG = m_lowPassG;
+    const SampleType lowPassH = m_lowPassH;
+    const SampleType lowPassGain = m_lowPassG + m_feedback;
+
+    SampleType* hiPassState1 = m_hiPassState1.data();
+    SampleType* hiPassState2 = m_hiPassState2.data();
+    SampleType* lowPassState1 = m_lowPassState1.data();
+    SampleType* lowPassState2 = m_lowPassState2.data();
+    SampleType* const* channels = m_channels.data();
+
+    for (size_t i = startSample; i < startSample + numSamples; ++i)
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            SampleType input = channels[channel][i];
+
+            // high pass
+            SampleType hiPass = (input - hiPassGain * hiPassState1[channel] - hiPassState2[channel]) * hiPassH;
+            SampleType hiPassBand = hiPassG * hiPass + hiPassState1[channel];
+            hiPassState1[channel] = hiPassG * hiPass + hiPassBand;
+            SampleType hiPassLow = hiPassG * hiPassBand + hiPassState2[channel];
+            hiPassState2[channel] = hiPassG * hiPassBand + hiPassLow;
+
+            // low pass fed by the high pass
+            SampleType lowPassHigh = (hiPass - lowPassGain * lowPassState1[channel] - lowPassState2[channel]) * lowPassH;
+            SampleType lowPassBand = lowPassG * lowPassHigh + lowPassState1[channel];
+            lowPassState1[channel] = lowPassG * lowPassHigh + lowPassBand;
+            SampleType lowPass = lowPassG * lowPassBand + lowPassState2[channel];
+            lowPassState2[channel] = lowPassG * lowPassBand + lowPass;
+
+            channels[channel][i] = lowPass;
+        }
+    }
+}
+
+//==============================================================================
+
+template class BandLimiter<float>;
+template class BandLimiter<double>;
+
+} // dingus
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    BandLimiter.h
+    Created: 19 Oct 2026 10:12:41am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DspCore.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace dingus
+{
+
+//==============================================================================
+/**
+    A high pass and a low pass filter in series used to band limit the chorus voices.
+    Both are state variable filters using the same TPT structure and resonance as 
+    juce::dsp::StateVariableTPTFilter, but they are processed in a single pass.
+    The channels are processed side by side for each sample, the filter states are 
+    kept in contiguous arrays so that the loop over the channels can be vectorized.
+    The cutoffs are smoothed and the coefficients are only recalculated while a 
+    cutoff is moving, tan() is read from a table which is filled in prepare().
+    Use a float or double audio sample type.
+*/
+template <typename SampleType>
+class BandLimiter
+{
+public:
+    BandLimiter();
+
+    // prepares the filters for playback given a ProcessSpec
+    void prepare(const ProcessSpec& spec);
+
+    // clears the filter states
+    void reset();
+
+    // sets the cutoff of the high pass filter in Hz
+    void setHighPass(SampleType cutoff);
+
+    // sets the cutoff of the low pass filter in Hz
+    void setLowPass(SampleType cutoff);
+
+    // bypassing skips the filters entirely, the cutoffs keep moving towards their targets
+    void setBypass(bool bypass);
+
+    // returns true if the filters are bypassed
+    bool isBypassed() const;
+
+    // processes a block of samples in place using a ProcessContext
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto& outputBlock = context.getOutputBlock();
+        auto numSamples = outputBlock.getNumSamples();
+        auto numChannels = std::min(outputBlock.getNumChannels(), m_channels.size());
+
+        assert(context.usesSeparateInputAndOutputBlocks() == false);
+
+        // the cutoffs keep moving so the coefficients are up to date when the bypass is turned off
+        if (m_bypass || context.isBypassed)
+        {
+            updateCoefficients(static_cast<int>(numSamples));
+            m_updateCounter = m_updateRate;
+            return;
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            m_channels[channel] = outputBlock.getChannelPointer(channel);
+
+        for (size_t pos = 0; pos < numSamples;)
+        {
+            size_t blockSize = std::min(numSamples - pos, m_updateCounter);
+            processSamples(pos, blockSize, numChannels);
+
+            pos += blockSize;
+            m_updateCounter -= blockSize;
+
+            if (m_updateCounter == 0)
+            {
+                m_updateCounter = m_updateRate;
+                updateCoefficients(static_cast<int>(m_updateRate));
+            }
+        }
+    }
+
+private:
+    SampleType m_sampleRate{ SampleType(44100) };
+    bool m_bypass{ false };
+
+    // the cutoffs are smoothed and the coefficients are updated every m_updateRate samples while they move
+    SmoothedValue<SampleType, ValueSmoothingTypes::Multiplicative> m_hiPassCutoff{ SampleType(20) };
+    SmoothedValue<SampleType, ValueSmoothingTypes::Multiplicative> m_lowPassCutoff{ SampleType(20000) };
+    const size_t m_updateRate{ 100 };
+    size_t m_updateCounter{ 100 };
+
+    // tan(pi * cutoff / sampleRate) for cutoffs from 0 up to just under nyquist
+    std::vector<SampleType> m_tanTable;
+    const size_t m_tanTableSize{ 4096 };
+    SampleType m_tanTableScale{};
+    SampleType m_maxCutoff{};
+
+    // coefficients for each filter, g is the warped cutoff and h normalizes the feedback
+    const SampleType m_feedback{ MathConstants<SampleType>::sqrt2 };
+    SampleType m_hiPassG{}, m_hiPassH{};
+    SampleType m_lowPassG{}, m_lowPassH{};
+
+    // filter states for each channel
+    std::vector<SampleType> m_hiPassState1, m_hiPassState2;
+    std::vector<SampleType> m_lowPassState1, m_lowPassState2;
+
+    // the channel pointers of the block being processed
+    std::vector<SampleType*> m_channels;
+
+    // fills the tan table for the current sample rate
+    void initTanTable();
+
+    // returns tan(pi * cutoff / sampleRate) using the table
+    SampleType getTan(SampleType cutoff) const;
+
+    // skips the cutoffs ahead and recalculates the coefficients if either cutoff has moved
+    void updateCoefficients(int skip = 0);
+
+    // processes numSamples samples of every channel starting at startSample
+    void processSamples(size_t startSample, size_t numSamples, size_t numChannels) noexcept;
+};
+//==============================================================================
+
+} // dingus
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+    ChorusCApi.cpp
+    Created: 20 Oct 2026 2:47:19am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "ChorusCApi.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <new>
+#include "ChorusEngine.h"
+
+namespace
+{
+    struct ParameterRange
+    {
+        double minimum;
+        double maximum;
+        double defaultValue;
+        bool isDiscrete;
+    };
+
+    // in the order of dingus_chorus_parameter, the defaults are the plugin defaults with the mix at 100%
+    const std::array<ParameterRange, DINGUS_CHORUS_NUM_PARAMETERS> parameterRanges
+    { {
+        { 0.01, 20.0, 2.0, false },         // rate
+        { 0.0, 1.0, 0.5, false },           // depth
+        { 0.0, 1.0, 1.0, false },           // mix
+        { 0.005, 0.075, 0.005, false },     // delay
+        { 0.0, 1.0, 0.0, false },           // width
+        { 0.0, 3.0, 0.0, true },            // mode
+        { 1.0, 64.0, 1.0, true },           // voices
+        { 0.0, 1.0, 1.0, false },           // spread
+        { 0.0, 1.0, 0.0, true },            // lfo type
+        { 0.0, 1.0, 0.5, false },           // phase left
+        { 0.0, 1.0, 0.0, false },           // phase right
+        { 20.0, 20000.0, 20.0, false },     // high pass
+        { 20.0, 20000.0, 20000.0, false },  // low pass
+        { 0.0, 1.0, 0.0, true },            // filter bypass
+        { 0.0, 1.0, 0.0, true },            // latency mode
+        { 0.001, 0.075, 0.005, false },     // latency reference
+        { 0.0, 3.0, 0.0, true }             // interpolation
+    } };
+
+    // the same control rate as the plugin, the daemon and the python bindings
+    constexpr float lfoControlRate{ 2500.0f };
+}
+
+//==============================================================================
+struct dingus_chorus
+{
+    dingus::ChorusEngine<float> engine;
+    std::array<double, DINGUS_CHORUS_NUM_PARAMETERS> values{};
+    size_t numChannels{ 0 };
+    size_t maxBlockSize{ 0 };
+
+    // the discrete parameters switch straight away until the first block
+    bool hasProcessed{ false };
+
+    // applies the stored value of a parameter to the engine
+    void apply(dingus_chorus_parameter parameter)
+    {
+        auto value = static_cast<float>(values[parameter]);
+
+        switch (parameter)
+        {
+        case DINGUS_CHORUS_RATE:
+            engine.setRate(value);
+            break;
+        case DINGUS_CHORUS_DEPTH:
+            engine.setDepth(value);
+            break;
+        case DINGUS_CHORUS_MIX:
+            engine.setMix(value);
+            break;
+        case DINGUS_CHORUS_DELAY:
+            engine.setDelayTime(value);
+            break;
+        case DINGUS_CHORUS_WIDTH:
+            engine.setDelayWidth(value);
+            break;
+        case DINGUS_CHORUS_SPREAD:
+            engine.setVoiceSpread(value);
+            break;
+        case DINGUS_CHORUS_PHASE_LEFT:
+            engine.setPhaseOffset(value, 0);
+            break;
+        case DINGUS_CHORUS_PHASE_RIGHT:
+            engine.setPhaseOffset(value, 1);
+            break;
+        case DINGUS_CHORUS_HIGH_PASS:
+            engine.setHighPass(value);
+            break;
+        case DINGUS_CHORUS_LOW_PASS:
+            engine.setLowPass(value);
+            break;
+        case DINGUS_CHORUS_FILTER_BYPASS:
+            engine.setFilterBypass(value != 0.0f);
+            break;
+        case DINGUS_CHORUS_LATENCY_MODE:
+            engine.setLatencyMode(static_cast<dingus::LatencyMode>(static_cast<int>(value)));
+            break;
+        case DINGUS_CHORUS_LATENCY_REFERENCE:
+            engine.setReferenceDelay(value);
+            break;
+        case DINGUS_CHORUS_INTERPOLATION:
+            engine.setInterpolation(static_cast<dingus::Interpolation>(static_cast<int>(value)));
+            break;
+        case DINGUS_CHORUS_MODE:
+        case DINGUS_CHORUS_VOICES:
+        case DINGUS_CHORUS_LFO_TYPE:
+        {
+            auto mode = static_cast<dingus::Mode>(static_cast<int>(values[DINGUS_CHORUS_MODE]));
+            auto numVoices = static_cast<size_t>(values[DINGUS_CHORUS_VOICES]);
+            auto lfoType = static_cast<dingus::WaveType>(static_cast<int>(values[DINGUS_CHORUS_LFO_TYPE]));
+
+            if (hasProcessed)
+            {
+                engine.setDiscreteParameters(mode, numVoices, lfoType);
+                break;
+            }
+
+            engine.setMode(mode);
+            engine.setNumVoice(numVoices);
+            engine.setLfoType(lfoType);
+        }
+        break;
+        case DINGUS_CHORUS_NUM_PARAMETERS:
+        default:
+            break;
+        }
+    }
+};
+
+//==============================================================================
+dingus_chorus* dingus_chorus_create(double sampleRate, int numChannels, int maxBlockSize)
+{
+    if (!(sampleRate >= 8000.0 && sampleRate <= 768000.0) || numChannels < 1 || numChannels > 64 || maxBlockSize < 1)
+        return nullptr;
+
+    dingus_chorus* chorus = nullptr;
+
+    // nothing can be thrown across the c interface
+    try
+    {
+        chorus = new dingus_chorus();
+        chorus->numChannels = static_cast<size_t>(numChannels);
+        chorus->maxBlockSize = static_cast<size_t>(maxBlockSize);
+
+        chorus->engine.setLfoControlRate(lfoControlRate);
+        chorus->engine.prepare({ sampleRate, static_cast<std::uint32_t>(maxBlockSize), static_cast<std::uint32_t>(numChannels) });
+    }
+    catch (const std::bad_alloc&)
+    {
+        delete chorus;
+        return nullptr;
+    }
+
+    for (size_t parameter = 0; parameter < parameterRanges.size(); ++parameter)
+    {
+        chorus->values[parameter] = parameterRanges[parameter].defaultValue;
+        chorus->apply(static_cast<dingus_chorus_parameter>(parameter));
+    }
+
+    return chorus;
+}
+
+void dingus_chorus_destroy(dingus_chorus* chorus)
+{
+    delete chorus;
+}
+
+int dingus_chorus_set_parameter(dingus_chorus* chorus, dingus_chorus_parameter parameter, double value)
+{
+    if (chorus == nullptr || parameter < 0 || parameter >= DINGUS_CHORUS_NUM_PARAMETERS)
+        return -1;
+
+    auto& range = parameterRanges[parameter];
+
+    // this is also false for nan
+    if (!(value >= range.minimum && value <= range.maximum))
+        return -1;
+
+    chorus->values[parameter] = range.isDiscrete ? std::round(value) : value;
+    chorus->apply(parameter);
+    return 0;
+}
+
+double dingus_chorus_get_parameter(const dingus_chorus* chorus, dingus_chorus_parameter parameter)
+{
+    if (chorus == nullptr || parameter < 0 || parameter >= DINGUS_CHORUS_NUM_PARAMETERS)
+        return 0.0;
+
+    return chorus->values[parameter];
+}
+
+void dingus_chorus_reset(dingus_chorus* chorus)
+{
+    if (chorus != nullptr)
+        chorus->engine.reset();
+}
+
+void dingus_chorus_process(dingus_chorus* chorus, const float* const* inputs, float* const* outputs, int numSamples)
+{
+    if (chorus == nullptr || inputs == nullptr || outputs == nullptr || numSamples <= 0)
+        return;
+
+    chorus->hasProcessed = true;
+
+    auto numChannels = chorus->numChannels;
+    auto length = static_cast<size_t>(numSamples);
+
+    bool isReplacing = true;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        isReplacing = isReplacing && inputs[channel] == outputs[channel];
+
+    for (size_t start = 0; start < length; start += chorus->maxBlockSize)
+    {
+        size_t blockSize = std::min(chorus->maxBlockSize, length - start);
+        dingus::AudioBlock<float> outputBlock(outputs, numChannels, start, blockSize);
+
+        if (isReplacing)
+        {
+            dingus::ProcessContextReplacing<float> context(outputBlock);
+            chorus->engine.process(context);
+        }
+        else
+        {
+            dingus::AudioBlock<const float> inputBlock(inputs, numChannels, start, blockSize);
+            dingus::ProcessContextNonReplacing<float> context(inputBlock, outputBlock);
+            chorus->engine.process(context);
+        }
+    }
+}
+
+int dingus_chorus_get_latency(const dingus_chorus* chorus)
+{
+    return chorus != nullptr ? chorus->engine.getLatency() : 0;
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    ChorusCApi.h
+    Created: 20 Oct 2026 2:47:19am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// a plain c interface to the chorus engine, eg. for embedding it in a game engine or calling it through an ffi
+// it processes 32 bit float audio with separate channels, the engine has the plugin defaults with the mix at 100%
+//
+//     dingus_chorus* chorus = dingus_chorus_create(48000.0, 2, 512);
+//     dingus_chorus_set_parameter(chorus, DINGUS_CHORUS_VOICES, 4.0);
+//     dingus_chorus_process(chorus, inputs, outputs, numSamples);
+//     dingus_chorus_destroy(chorus);
+//
+// a handle can be used from any thread but only by one thread at a time
+// set_parameter, reset and process don't allocate or lock, so they can be called from an audio callback
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct dingus_chorus dingus_chorus;
+
+// the parameters and their ranges, they match the plugin
+typedef enum dingus_chorus_parameter
+{
+    DINGUS_CHORUS_RATE,                 // the lfo rate, 0.01 to 20 Hz
+    DINGUS_CHORUS_DEPTH,                // 0 to 1
+    DINGUS_CHORUS_MIX,                  // 0 is dry and 1 is wet
+    DINGUS_CHORUS_DELAY,                // the delay time, 0.005 to 0.075 sec
+    DINGUS_CHORUS_WIDTH,                // 0 to 1
+    DINGUS_CHORUS_MODE,                 // 0 stereo, 1 mono, 2 dimension, 3 vibrato
+    DINGUS_CHORUS_VOICES,               // the voices per channel, 1 to 64
+    DINGUS_CHORUS_SPREAD,               // 0 to 1
+    DINGUS_CHORUS_LFO_TYPE,             // 0 triangle, 1 sine
+    DINGUS_CHORUS_PHASE_LEFT,           // 0 to 1
+    DINGUS_CHORUS_PHASE_RIGHT,          // 0 to 1
+    DINGUS_CHORUS_HIGH_PASS,            // 20 to 20000 Hz
+    DINGUS_CHORUS_LOW_PASS,             // 20 to 20000 Hz
+    DINGUS_CHORUS_FILTER_BYPASS,        // 0 or 1
+    DINGUS_CHORUS_LATENCY_MODE,         // 0 zero latency, 1 aligned
+    DINGUS_CHORUS_LATENCY_REFERENCE,    // the delay of the dry signal when aligned, 0.001 to 0.075 sec
+    DINGUS_CHORUS_INTERPOLATION,        // 0 linear, 1 hermite, 2 lagrange, 3 thiran
+    DINGUS_CHORUS_NUM_PARAMETERS
+} dingus_chorus_parameter;
+
+// creates an engine for up to 64 channels and blocks of any length, longer blocks are split into maxBlockSize samples
+// returns null if the arguments are out of range or the engine can't be allocated
+dingus_chorus* dingus_chorus_create(double sampleRate, int numChannels, int maxBlockSize);
+
+// destroys an engine, null is ignored
+void dingus_chorus_destroy(dingus_chorus* chorus);
+
+// sets a parameter, returns 0 or -1 if the parameter or the value is out of range, then nothing changes
+// once the engine has processed audio the mode, voices and lfo type switch behind a short fade of the wet signal
+int dingus_chorus_set_parameter(dingus_chorus* chorus, dingus_chorus_parameter parameter, double value);
+
+// returns the value of a parameter, or 0 if it's out of range
+double dingus_chorus_get_parameter(const dingus_chorus* chorus, dingus_chorus_parameter parameter);
+
+// clears the delay lines and filters and restarts the lfos, eg. between clips
+void dingus_chorus_reset(dingus_chorus* chorus);
+
+// processes numSamples samples of every channel, the outputs may be the inputs
+void dingus_chorus_process(dingus_chorus* chorus, const float* const* inputs, float* const* outputs, int numSamples);
+
+// returns the latency in samples, this is the latency reference in aligned mode and 0 otherwise
+int dingus_chorus_get_latency(const dingus_chorus* chorus);
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,61 +14,114 @@ namespace dingus
 {
 
 //==============================================================================
-template<typename SampleType>
-ChorusEngine<SampleType>::ChorusEngine()
+template<typename SampleType, size_t MaxVoices>
+ChorusEngine<SampleType, MaxVoices>::ChorusEngine()
 {
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setNumInputChannels(size_t numInputChannels)
+{
+    m_numInputChannels = numInputChannels;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setChannelGroups(const std::vector<std::vector<size_t>>& groups)
+{
+    m_channelGroups = groups;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setTaskRunner(TaskRunner* taskRunner)
+{
+    m_taskRunner = taskRunner;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setUseTaskRunner(bool useTaskRunner)
+{
+    m_useTaskRunner = useTaskRunner;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::prepare(const ProcessSpec& spec)
 {
     // resize vectors for the number of channels
-    jassert(spec.numChannels > 0);
-    m_mixLevel.resize(spec.numChannels);
+    assert(spec.numChannels > 0);
+    assert(m_numInputChannels <= spec.numChannels);
+
+    // only a mono input can feed more output channels than it has
+    if (m_numInputChannels != 1)
+        m_numInputChannels = spec.numChannels;
+
+    updateChannelGroups(spec.numChannels);
+    m_voices.setChannelSides(m_channelSides);
+
     m_boostFilters.resize(spec.numChannels);
     m_cutFilters.resize(spec.numChannels);
+    m_dryDelays.resize(spec.numChannels);
 
     m_sampleRate = static_cast<SampleType>(spec.sampleRate);
 
-    // low and high pass filters
-    auto& hiPass = processorChain.get<highPassIndex>();
-    hiPass.setType(juce::dsp::StateVariableTPTFilterType::highpass);
+    // the dry delays need to be able to hold the max reference delay
+    size_t dryDelaySize = static_cast<size_t>(std::ceil(m_maxReferenceDelay * m_sampleRate)) + 1;
+
+    for (auto& dryDelay : m_dryDelays)
+        dryDelay.resize(dryDelaySize);
 
-    auto& lowPass = processorChain.get<lowPassIndex>();
-    lowPass.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    updateDryDelay();
 
     // shelving filters for cut and boost, centered at 200Hz, Q = 1, with 0.3x boost/cut
-    auto boostCoef = juce::dsp::IIR::Coefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(13e-1));
-    auto cutCoef = juce::dsp::IIR::Coefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(7e-1));
+    auto boostCoef = BiquadCoefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(13e-1));
+    auto cutCoef = BiquadCoefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(7e-1));
 
     // initialize all filters
     for (auto& boostFilter : m_boostFilters)
     {
-        boostFilter.prepare(spec);
+        boostFilter.reset();
         boostFilter.coefficients = boostCoef;
     }
 
     for (auto& cutFilter : m_cutFilters)
     {
-        cutFilter.prepare(spec);
+        cutFilter.reset();
         cutFilter.coefficients = cutCoef;
     }
 
-    tempBlock = juce::dsp::AudioBlock<SampleType>(heapBlock, spec.numChannels, spec.maximumBlockSize);
-    processorChain.prepare(spec);
+    tempBlock = tempStorage.allocate(spec.numChannels, spec.maximumBlockSize);
+    dryBlock = dryStorage.allocate(spec.numChannels, spec.maximumBlockSize);
+    modeFadeBlock = modeFadeStorage.allocate(spec.numChannels, spec.maximumBlockSize);
+    m_boostBuffer.assign(spec.maximumBlockSize, SampleType(0));
+    m_cutBuffer.assign(spec.maximumBlockSize, SampleType(0));
+    m_voices.prepare(spec, m_numInputChannels);
+    m_bandLimiter.prepare(spec);
 
     // set ramped values
-    for (auto& mixLevel : m_mixLevel)
-        mixLevel.reset(spec.sampleRate, 0.2);
-
-    m_lowPassCutoff.reset(spec.sampleRate, 0.5);
-    m_hiPassCutoff.reset(spec.sampleRate, 0.5);
+    m_mixLevel.reset(spec.sampleRate, 0.2);
+    m_mixGains.assign(spec.maximumBlockSize, SampleType(0));
+
+    // nothing is playing so a pending switch doesn't need the fade
+    applyPendingSwitch();
+    m_switchFade.reset(spec.sampleRate, static_cast<double>(m_switchFadeTime));
+    m_switchFade.setCurrentAndTargetValue(SampleType(1));
+    m_switchGains.assign(spec.maximumBlockSize, SampleType(1));
+
+    // the same goes for a mode change
+    m_mixMode = m_mode;
+    m_modeFade.reset(spec.sampleRate, static_cast<double>(m_modeFadeTime));
+    m_modeFade.setCurrentAndTargetValue(SampleType(1));
+    m_fadeOutGains.assign(spec.maximumBlockSize, SampleType(0));
+    m_fadeInGains.assign(spec.maximumBlockSize, SampleType(1));
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::reset()
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::reset()
 {
-    processorChain.reset();
+    m_voices.reset();
+    m_bandLimiter.reset();
+
+    for (auto& dryDelay : m_dryDelays)
+        dryDelay.clear();
 
     for (auto& boostFilter : m_boostFilters)
         boostFilter.reset();
@@ -79,120 +132,367 @@ void ChorusEngine<SampleType>::reset()
 
 //==============================================================================
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::updateFilterCutoffs(int skip /*= 0*/)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::updateChannelGroups(size_t numChannels)
+{
+    // every channel has to be in exactly one group
+    bool isValid = !m_channelGroups.empty();
+    std::vector<size_t> groupCount(numChannels, 0);
+
+    for (auto& group : m_channelGroups)
+    {
+        if (group.empty())
+            isValid = false;
+
+        for (auto channel : group)
+        {
+            if (channel < numChannels)
+                ++groupCount[channel];
+            else
+                isValid = false;
+        }
+    }
+
+    isValid = isValid && std::all_of(groupCount.begin(), groupCount.end(), [](size_t count) { return count == 1; });
+
+    // default to pairing channels in order
+    if (!isValid)
+    {
+        m_channelGroups.clear();
+
+        for (size_t channel = 0; channel < numChannels; channel += 2)
+        {
+            if (channel + 1 < numChannels)
+                m_channelGroups.push_back({ channel, channel + 1 });
+            else
+                m_channelGroups.push_back({ channel });
+        }
+    }
+
+    // each channel is paired with the next channel in its group
+    m_channelPartners.resize(numChannels);
+    m_channelSides.resize(numChannels);
+
+    for (auto& group : m_channelGroups)
+    {
+        for (size_t index = 0; index < group.size(); ++index)
+        {
+            m_channelPartners[group[index]] = group[(index + 1) % group.size()];
+            m_channelSides[group[index]] = index % 2;
+        }
+    }
+}
+
+template<typename SampleType, size_t MaxVoices>
+bool ChorusEngine<SampleType, MaxVoices>::updateSwitchFade(size_t numSamples) noexcept
 {
-    m_hiPassCutoff.skip(skip);
-    m_lowPassCutoff.skip(skip);
+    assert(numSamples <= m_switchGains.size());
+
+    if (m_hasPendingSwitch)
+    {
+        // switch at the start of the block after the fade out has finished
+        if (!m_switchFade.isSmoothing() && m_switchFade.getCurrentValue() == SampleType(0))
+        {
+            applyPendingSwitch();
+            m_switchFade.setTargetValue(SampleType(1));
+        }
+        else
+        {
+            m_switchFade.setTargetValue(SampleType(0));
+        }
+    }
+
+    // the gains only need to be filled while fading, or once when the fade has finished
+    if (!m_switchFade.isSmoothing())
+    {
+        SampleType gain = m_switchFade.getTargetValue();
+
+        if (m_switchGains[0] != gain)
+            std::fill(m_switchGains.begin(), m_switchGains.end(), gain);
+
+        return false;
+    }
 
-    auto& hiPass = processorChain.get<highPassIndex>();
-    hiPass.setCutoffFrequency(m_hiPassCutoff.getNextValue());
+    for (size_t i = 0; i < numSamples; ++i)
+        m_switchGains[i] = m_switchFade.getNextValue();
 
-    auto& lowPass = processorChain.get<lowPassIndex>();
-    lowPass.setCutoffFrequency(m_lowPassCutoff.getNextValue());
+    // the rest of the gains are from an earlier block, they're filled here since the check above only looks at the first gain
+    if (!m_switchFade.isSmoothing())
+        std::fill(m_switchGains.begin() + numSamples, m_switchGains.end(), m_switchFade.getTargetValue());
+
+    return true;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::updateMixGains(size_t numSamples, bool isSwitchFading) noexcept
+{
+    assert(numSamples <= m_mixGains.size());
+
+    if (!m_mixLevel.isSmoothing() && !isSwitchFading)
+    {
+        std::fill(m_mixGains.begin(), m_mixGains.begin() + numSamples, m_mixLevel.getTargetValue() * m_switchFade.getTargetValue());
+        return;
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+        m_mixGains[i] = m_mixLevel.getNextValue() * m_switchGains[i];
+}
+
+template<typename SampleType, size_t MaxVoices>
+bool ChorusEngine<SampleType, MaxVoices>::updateModeFade(size_t numSamples) noexcept
+{
+    assert(numSamples <= m_fadeInGains.size());
+
+    // a mode that changes during a crossfade waits for it to finish
+    if (!m_modeFade.isSmoothing() && m_mode != m_mixMode)
+    {
+        m_fadeFromMode = m_mixMode;
+        m_mixMode = m_mode;
+        m_modeFade.setCurrentAndTargetValue(SampleType(0));
+        m_modeFade.setTargetValue(SampleType(1));
+    }
+
+    if (!m_modeFade.isSmoothing())
+        return false;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        SampleType position = m_modeFade.getNextValue() * MathConstants<SampleType>::halfPi;
+        m_fadeOutGains[i] = std::cos(position);
+        m_fadeInGains[i] = std::sin(position);
+    }
+
+    return true;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::applyPendingSwitch()
+{
+    m_mode = m_pendingMode;
+    m_voices.setActiveVoices(std::min(m_pendingNumVoices, m_voiceLimit));
+    m_voices.setLfoType(m_pendingLfoType);
+    m_hasPendingSwitch = false;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::updateDryDelay()
+{
+    m_dryDelaySamples = static_cast<size_t>(roundToInt(m_referenceDelay * m_sampleRate));
 }
 
 //==============================================================================
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setMix(SampleType mix)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setMix(SampleType mix)
 {
-    for (auto& mixLevel : m_mixLevel)
-        mixLevel.setTargetValue(mix);
+    m_mixLevel.setTargetValue(mix);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setHighPass(SampleType cutoff)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setHighPass(SampleType cutoff)
 {
-    m_hiPassCutoff.setTargetValue(cutoff);
+    m_bandLimiter.setHighPass(cutoff);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setLowPass(SampleType cutoff)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setLowPass(SampleType cutoff)
 {
-    m_lowPassCutoff.setTargetValue(cutoff);
+    m_bandLimiter.setLowPass(cutoff);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setFilterBypass(bool bypass)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setFilterBypass(bool bypass)
 {
-    processorChain.setBypassed<highPassIndex>(bypass);
-    processorChain.setBypassed<lowPassIndex>(bypass);
+    m_bandLimiter.setBypass(bypass);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setRate(SampleType rate)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setRate(SampleType rate)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setRate(rate);
+    m_voices.setRate(rate);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setDepth(SampleType depth)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setDepth(SampleType depth)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setDepth(depth);
+    m_voices.setDepth(depth);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setDelayTime(SampleType delayTime)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setLfoControlRate(SampleType controlRate)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setDelayTime(delayTime);
+    m_voices.setLfoControlRate(controlRate);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setDelayWidth(SampleType width)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setInterpolation(Interpolation interpolation)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setDelayWidth(width);
+    m_voices.setInterpolation(interpolation);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setVoiceSpread(SampleType spread)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setDelayTime(SampleType delayTime)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setVoiceSpread(spread);
+    m_voices.setDelayTime(delayTime);
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setMode(Mode mode)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setDelayWidth(SampleType width)
+{
+    m_voices.setDelayWidth(width);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setVoiceSpread(SampleType spread)
+{
+    m_voices.setVoiceSpread(spread);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setMode(Mode mode)
 {
     m_mode = mode;
+    m_pendingMode = mode;
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setNumVoice(size_t numVoices)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setNumVoice(size_t numVoices)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setActiveVoices(numVoices + 1);
+    m_pendingNumVoices = limit(size_t(1), MaxVoices, numVoices);
+    m_voices.setActiveVoices(std::min(m_pendingNumVoices, m_voiceLimit));
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setPhaseOffset(SampleType phaseOffset, size_t channel /*= 0*/)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setVoiceLimit(size_t maxVoices)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setPhaseOffset(phaseOffset, channel);
+    maxVoices = limit(size_t(1), MaxVoices, maxVoices);
+
+    if (maxVoices == m_voiceLimit)
+        return;
+
+    // only fade if the number of active voices actually changes
+    if (std::min(m_pendingNumVoices, maxVoices) != std::min(m_pendingNumVoices, m_voiceLimit))
+        m_hasPendingSwitch = true;
+
+    m_voiceLimit = maxVoices;
 }
 
-template<typename SampleType>
-void ChorusEngine<SampleType>::setLfoType(WaveType type)
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setDiscreteParameters(Mode mode, size_t numVoices, WaveType lfoType)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    chorusVoices.setLfoType(type);
+    numVoices = limit(size_t(1), MaxVoices, numVoices);
+
+    if (mode == m_pendingMode && numVoices == m_pendingNumVoices && lfoType == m_pendingLfoType)
+        return;
+
+    m_pendingMode = mode;
+    m_pendingNumVoices = numVoices;
+    m_pendingLfoType = lfoType;
+    m_hasPendingSwitch = true;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setPhaseOffset(SampleType phaseOffset, size_t side /*= 0*/)
+{
+    m_voices.setPhaseOffset(phaseOffset, side);
 }
 
-template<typename SampleType>
-int ChorusEngine<SampleType>::getLatency() const
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setLfoType(WaveType type)
 {
-    auto& chorusVoices = processorChain.get<voicesIndex>();
-    return juce::roundToInt(chorusVoices.getDelayTime() * m_sampleRate);
+    m_pendingLfoType = type;
+    m_voices.setLfoType(type);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setLatencyMode(LatencyMode mode)
+{
+    m_latencyMode = mode;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngine<SampleType, MaxVoices>::setReferenceDelay(SampleType delayTime)
+{
+    assert(delayTime >= SampleType(0) && delayTime < m_maxReferenceDelay);
+    m_referenceDelay = limit(SampleType(0), m_maxReferenceDelay, delayTime);
+    updateDryDelay();
+}
+
+template<typename SampleType, size_t MaxVoices>
+int ChorusEngine<SampleType, MaxVoices>::getLatency() const
+{
+    if (m_latencyMode == LatencyMode::ALIGNED)
+        return static_cast<int>(m_dryDelaySamples);
+
+    return 0;
+}
+
+template<typename SampleType, size_t MaxVoices>
+double ChorusEngine<SampleType, MaxVoices>::estimateCost(const ProcessSpec& spec, const CostSettings& settings)
+{
+    return estimateCost(spec, settings, costModel);
+}
+
+template<typename SampleType, size_t MaxVoices>
+double ChorusEngine<SampleType, MaxVoices>::estimateCost(const ProcessSpec& spec, const CostSettings& settings, const CostModel& model)
+{
+    assert(settings.interpolation != Interpolation::MAX);
+
+    auto mode = static_cast<size_t>(settings.mode);
+    auto interpolation = std::min(static_cast<size_t>(settings.interpolation), static_cast<size_t>(Interpolation::MAX) - 1);
+    auto numVoices = static_cast<double>(limit(size_t(1), MaxVoices, settings.numVoices));
+    auto blockSize = static_cast<double>(std::max(spec.maximumBlockSize, std::uint32_t(1)));
+    double channelCost;
+
+    // once the mix settles at 0 the voices only write their delay lines, which costs about the same for any number of voices
+    if (settings.mix <= 0.0)
+    {
+        channelCost = model.dryCost[mode] + model.dryBlockCost / blockSize;
+    }
+    else
+    {
+        channelCost = model.modeCost[mode] + numVoices * model.voiceCost[interpolation] + model.blockCost / blockSize;
+
+        if (!settings.filterBypass)
+            channelCost += model.filterCost;
+    }
+
+    return channelCost * static_cast<double>(spec.numChannels);
 }
 
 //==============================================================================
 
-template class ChorusEngine<float>;
-template class ChorusEngine<double>;
+// fitted by chorus-bench cost at 48kHz with a 2500Hz lfo control rate, indexed by Mode and Interpolation
+// each value is the median of four runs, the voices are the same for every mode so their cost is shared,
+// a dimension mix adds the shelf filters
+template<typename SampleType, size_t MaxVoices>
+const CostModel ChorusEngine<SampleType, MaxVoices>::costModel = 
+    std::is_same<SampleType, double>::value
+    ? CostModel{ { 9.33, 10.17, 18.30, 9.20 }, 8.96, { 7.56, 17.79, 17.14, 10.03 }, 160.8, { 2.31, 2.35, 11.50, 2.50 }, 125.7 }
+    : CostModel{ { 11.26, 11.42, 20.70, 11.58 }, 7.32, { 8.41, 18.95, 18.23, 10.98 }, 222.6, { 1.64, 1.56, 10.00, 1.65 }, 121.7 };
+
+
+// indexed by Mode and MixState, a dimension mix keeps running the boost filter so it never leaves out the dry signal
+template<typename SampleType, size_t MaxVoices>
+const typename ChorusEngine<SampleType, MaxVoices>::Mixer ChorusEngine<SampleType, MaxVoices>::mixers[numModes][numMixStates] =
+{
+    { &ChorusEngine::mixChannels<Mode::STEREO, MixState::MIXED>, 
+      &ChorusEngine::mixChannels<Mode::STEREO, MixState::DRY>, 
+      &ChorusEngine::mixChannels<Mode::STEREO, MixState::WET> },
+    { &ChorusEngine::mixChannels<Mode::MONO, MixState::MIXED>, 
+      &ChorusEngine::mixChannels<Mode::MONO, MixState::DRY>, 
+      &ChorusEngine::mixChannels<Mode::MONO, MixState::WET> },
+    { &ChorusEngine::mixChannels<Mode::DIMENSION, MixState::MIXED>, 
+      &ChorusEngine::mixChannels<Mode::DIMENSION, MixState::DRY>, 
+      &ChorusEngine::mixChannels<Mode::DIMENSION, MixState::MIXED> },
+    { &ChorusEngine::mixChannels<Mode::VIBRATO, MixState::MIXED>, 
+      &ChorusEngine::mixChannels<Mode::VIBRATO, MixState::DRY>, 
+      &ChorusEngine::mixChannels<Mode::VIBRATO, MixState::WET> }
+};
+
+// the plugin exposes up to 64 voices per channel
+template class ChorusEngine<float, 64>;
+template class ChorusEngine<double, 64>;
 
 
 } // dingus
\ No newline at end of file
@@ -10,9 +10,15 @@
 
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
 #include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <type_traits>
 #include "ChorusVoices.h"
+#include "DelayBuffer.h"
+#include "BandLimiter.h"
 
 namespace dingus
 {
@@ -26,22 +32,76 @@ enum class Mode
     VIBRATO
 };
 
+// selects how the engine handles latency
+// ZERO leaves the dry signal untouched, so the plugin reports no latency and is safe for live tracking,
+// but the dry signal leads the wet signal by roughly the chorus delay time which causes some comb filtering
+// ALIGNED delays the dry signal by the reference delay so the wet/dry sum is phase coherent,
+// the reference delay is reported to the host as latency
+enum class LatencyMode
+{
+    ZERO,
+    ALIGNED
+};
+
+// the settings that the processing cost of the engine depends on, see ChorusEngine::estimateCost()
+struct CostSettings
+{
+    Mode mode{ Mode::STEREO };
+    size_t numVoices{ 1 };
+    bool filterBypass{ false };
+    Interpolation interpolation{ Interpolation::LINEAR };
+    double mix{ 0.5 };
+};
+
+// the cost of each part of the engine in ns per sample and channel, see ChorusEngine::estimateCost()
+// the mode cost covers the mix, the voice cost is per active voice for each interpolation
+// the block costs are per block and channel, a dry mix skips the voices so it has its own costs
+struct CostModel
+{
+    double modeCost[4];
+    double filterCost;
+    double voiceCost[static_cast<size_t>(Interpolation::MAX)];
+    double blockCost;
+    double dryCost[4];
+    double dryBlockCost;
+};
+
 //==============================================================================
 // this engine combines the chorus effect(s) with filters and other processing
+// the max number of voices is fixed at compile time, see ChorusVoices
 
-template<typename SampleType>
+template<typename SampleType, size_t MaxVoices = 64>
 class ChorusEngine
 {
 public:
     ChorusEngine();
 
+    // sets the number of input channels, this must be called before prepare()
+    // a mono input with multiple output channels only runs one delay line per voice
+    // by default the input matches the number of channels in the ProcessSpec
+    void setNumInputChannels(size_t numInputChannels);
+
+    // sets the groups of channels that are paired with each other, this must be called before prepare()
+    // in stereo, mono, and dimension modes each channel is mixed with the next channel in its group
+    // the channels in a group alternate between the left and right lfo phase and delay width
+    // a group with a single channel is processed on its own
+    // by default channels are paired in order, (0, 1), (2, 3), ...
+    void setChannelGroups(const std::vector<std::vector<size_t>>& groups);
+
+    // sets a task runner that can be used to process independent channel groups in parallel, eg. a thread pool
+    // the runner is only used when setUseTaskRunner() is enabled, this allocates so it's meant for offline rendering
+    void setTaskRunner(TaskRunner* taskRunner);
+
+    // enables processing the voices of each channel group with the task runner
+    void setUseTaskRunner(bool useTaskRunner);
+
     // prepares the chorus engine for playback
-    void prepare(const juce::dsp::ProcessSpec& spec);
+    void prepare(const ProcessSpec& spec);
 
-    // resets entire processorChain and filters
+    // resets the voices and filters
     void reset();
 
-    // processes a block of samples using a juce ProcessContext 
+    // processes a block of samples using a ProcessContext 
     template<typename ProcessContext>
     void process(const ProcessContext& context) noexcept
     {
@@ -51,124 +111,422 @@ public:
         auto numChannels = outputBlock.getNumChannels();
 
         auto chorusBlock = tempBlock.getSubBlock(0, numSamples);
-        chorusBlock.fill(SampleType(0)).add(context.getInputBlock());
+        auto alignedBlock = dryBlock.getSubBlock(0, numSamples);
+
+        // discrete parameters are switched while the wet signal is faded out
+        bool isSwitchFading = updateSwitchFade(numSamples);
+
+        // keep the latency mode from switching in the middle of the process block
+        LatencyMode currentLatencyMode = m_latencyMode;
+        bool isAligned = currentLatencyMode == LatencyMode::ALIGNED;
+
+        if (currentLatencyMode != m_lastLatencyMode)
+        {
+            // the dry delays are not fed in zero latency mode so clear out anything stale
+            for (auto& dryDelay : m_dryDelays)
+                dryDelay.clear();
+
+            m_lastLatencyMode = currentLatencyMode;
+        }
+
+        // delays the dry signal by the reference delay
+        if (isAligned)
+        {
+            size_t dryDelaySamples = m_dryDelaySamples;
+
+            // a mono input is the same on every channel so it only needs to be delayed once
+            size_t numDryChannels = m_numInputChannels == 1 ? 1 : numChannels;
+
+            for (size_t channel = 0; channel < numDryChannels; ++channel)
+            {
+                auto* input = inputBlock.getChannelPointer(channel);
+                auto* aligned = alignedBlock.getChannelPointer(channel);
+                auto& dryDelay = m_dryDelays[channel];
+
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    dryDelay.push(input[i]);
+                    aligned[i] = dryDelay.get(dryDelaySamples);
+                }
+            }
+
+            for (size_t channel = numDryChannels; channel < numChannels; ++channel)
+                std::copy(alignedBlock.getChannelPointer(0), alignedBlock.getChannelPointer(0) + numSamples, 
+                    alignedBlock.getChannelPointer(channel));
+        }
+
+        // the voices and the mix use the aligned dry signal when it is delayed
+        AudioBlock<const SampleType> mixDryBlock(inputBlock);
+
+        if (isAligned)
+            mixDryBlock = alignedBlock;
 
-        size_t filterUpdateCounter = m_filterUpdateRate;
+        // a new mode is crossfaded in, the mode can't switch in the middle of the process block
+        bool isModeFading = updateModeFade(numSamples);
 
-        // updates the filterCutoffs according to the updateRate
-        for (size_t pos = 0; pos < numSamples;)
+        // once the mix has settled at 0 or 1 part of the output isn't heard, so it doesn't need to be processed
+        MixState mixState = MixState::MIXED;
+
+        // the switch fade has already been moved through the block, so it may have finished part way through it
+        if (!m_mixLevel.isSmoothing() && !isSwitchFading)
         {
-            auto blockSize = juce::jmin((size_t)numSamples - pos, filterUpdateCounter);
-            auto subBlock = chorusBlock.getSubBlock(pos, blockSize);
-            juce::dsp::ProcessContextReplacing<SampleType> tempContext(subBlock);
-            processorChain.process(tempContext);
+            SampleType settledMix = m_mixLevel.getTargetValue() * m_switchFade.getTargetValue();
+
+            if (settledMix == SampleType(0))
+                mixState = MixState::DRY;
+            else if (settledMix == SampleType(1))
+                mixState = MixState::WET;
+        }
 
-            pos += blockSize;
-            filterUpdateCounter -= blockSize;
+        // this has to come after the mix state since it moves the mix level through the block
+        updateMixGains(numSamples, isSwitchFading);
 
-            if (filterUpdateCounter == 0)
+        if (mixState == MixState::DRY)
+        {
+            // the delay lines are still written so the voices come back without a jump
+            m_voices.skip(inputBlock, numChannels);
+            m_isWetMuted = true;
+        }
+        else
+        {
+            // the filters weren't run while the wet signal was muted so anything they hold is stale
+            if (m_isWetMuted)
             {
-                filterUpdateCounter = m_filterUpdateRate;
-                updateFilterCutoffs(static_cast<int>(m_filterUpdateRate));
+                m_bandLimiter.reset();
+
+                for (auto& cutFilter : m_cutFilters)
+                    cutFilter.reset();
+
+                m_isWetMuted = false;
             }
+
+            // the voices always read the undelayed input
+            // they are written on top of the dry signal straight into the chorus block, so it doesn't need to be filled first
+            ProcessContextNonReplacing<SampleType> voicesContext(inputBlock, chorusBlock);
+
+            if (m_useTaskRunner && m_taskRunner != nullptr && m_channelGroups.size() > 1 && m_numInputChannels != 1)
+                processGroupsInParallel(voicesContext, mixDryBlock);
+            else
+                m_voices.process(voicesContext, mixDryBlock);
+
+            // high and low pass the voices
+            ProcessContextReplacing<SampleType> filterContext(chorusBlock);
+            m_bandLimiter.process(filterContext);
+        }
+
+        auto mixer = mixers[static_cast<size_t>(m_mixMode)][static_cast<size_t>(mixState)];
+
+        if (!isModeFading)
+        {
+            (this->*mixer)(mixDryBlock, chorusBlock, outputBlock);
+            return;
         }
 
-        // keep the mode from swtiching in the middle of the process block
-        Mode currentMode = m_mode;
+        // the new mode is mixed first since the output may be the input
+        auto fadeBlock = modeFadeBlock.getSubBlock(0, numSamples);
+        (this->*mixer)(mixDryBlock, chorusBlock, fadeBlock);
+        (this->*mixers[static_cast<size_t>(m_fadeFromMode)][static_cast<size_t>(mixState)])(mixDryBlock, chorusBlock, outputBlock);
+
+        auto* fadeOutGains = m_fadeOutGains.data();
+        auto* fadeInGains = m_fadeInGains.data();
 
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
-            auto* dryIn = inputBlock.getChannelPointer(channel);
-            auto* processedInA = chorusBlock.getChannelPointer(channel);
-            auto* processedInB = chorusBlock.getChannelPointer((channel + 1) % numChannels);
+            auto* faded = fadeBlock.getChannelPointer(channel);
+            auto* output = outputBlock.getChannelPointer(channel);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                output[i] = output[i] * fadeOutGains[i] + faded[i] * fadeInGains[i];
+        }
+    }
+
+    //==============================================================================
+    // private members
+private:
+    // audio block for processing the delays
+    AudioBlockStorage<SampleType> tempStorage;
+    AudioBlock<SampleType> tempBlock;
+
+    // audio block for the dry signal when it is delayed to align with the wet signal
+    AudioBlockStorage<SampleType> dryStorage;
+    AudioBlock<SampleType> dryBlock;
+
+    // audio block for the new mode while it is crossfaded in
+    AudioBlockStorage<SampleType> modeFadeStorage;
+    AudioBlock<SampleType> modeFadeBlock;
+
+    SampleType m_sampleRate{};
+    size_t m_numInputChannels{ 0 };
+
+    // the mix level of wet/dry signal, 1 is 100% wet and 0 is 100% dry
+    // it is the same for every channel so it's rendered once per block into the mix gains along with the switch fade
+    SmoothedValue<SampleType> m_mixLevel;
+    std::vector<SampleType> m_mixGains;
+
+    // fills the mix gains for the block, the switch gains are only used while the switch is fading
+    void updateMixGains(size_t numSamples, bool isSwitchFading) noexcept;
+
+    // this enum determines the algorithm used by the chorus engine
+    Mode m_mode{ Mode::STEREO };
+
+    // the mode that is being mixed, and the mode it is crossfading from
+    // the modes crossfade with equal power gains over this time in sec
+    Mode m_mixMode{ Mode::STEREO };
+    Mode m_fadeFromMode{ Mode::STEREO };
+    const SampleType m_modeFadeTime{ SampleType(2e-2) };
+    SmoothedValue<SampleType> m_modeFade{ SampleType(1) };
+    std::vector<SampleType> m_fadeOutGains;
+    std::vector<SampleType> m_fadeInGains;
+
+    // picks up a new mode once the last crossfade has finished and fills the fade gains
+    // returns true if the modes are crossfading during the block
+    bool updateModeFade(size_t numSamples) noexcept;
+
+    // which part of the signal is heard, the mix is only DRY or WET once it has settled at 0 or 1
+    enum class MixState
+    {
+        MIXED,
+        DRY,
+        WET
+    };
+
+    // each mode and mix state has its own mixer so there are no branches inside the sample loops
+    // the mixer is picked from the table once per block
+    using Mixer = void (ChorusEngine::*)(const AudioBlock<const SampleType>&, 
+        const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&);
+
+    static constexpr size_t numModes{ 4 };
+    static constexpr size_t numMixStates{ 3 };
+    static const Mixer mixers[numModes][numMixStates];
+
+    // mixes the dry signal and the voices of each channel into the output
+    template<Mode ModeType, MixState State>
+    void mixChannels(const AudioBlock<const SampleType>& dryIn, const AudioBlock<const SampleType>& processedIn, 
+        const AudioBlock<SampleType>& outputBlock) noexcept
+    {
+        auto numSamples = outputBlock.getNumSamples();
+        auto* mixGains = m_mixGains.data();
+
+        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        {
+            auto* dry = dryIn.getChannelPointer(channel);
+            auto* processedInA = processedIn.getChannelPointer(channel);
+            auto* processedInB = processedIn.getChannelPointer(m_channelPartners[channel]);
             auto* output = outputBlock.getChannelPointer(channel);
 
-            auto& boost = m_boostFilters[channel];
-            auto& cut = m_cutFilters[channel];
+            // vibrato and a channel without a partner only use their own voices
+            bool isPaired = ModeType != Mode::VIBRATO && m_channelPartners[channel] != channel;
 
-            switch (currentMode)
+            switch (State)
             {
-            case Mode::STEREO:
-                for (size_t i = 0; i < numSamples; ++i)
+            case MixState::DRY:
+                if (ModeType == Mode::DIMENSION && isPaired)
                 {
-                    //////////////////////// Stereo Chorus /////////////////////////
-                    SampleType mixLevel = m_mixLevel[channel].getNextValue();
-                    output[i] = dryIn[i] * (1 - mixLevel) + (processedInA[i] - processedInB[i]) * mixLevel;
+                    auto& boost = m_boostFilters[channel];
+
+                    for (size_t i = 0; i < numSamples; ++i)
+                        output[i] = boost.processSample(dry[i]);
                 }
-                break;
-            case Mode::MONO:
-            {
-                SampleType gainAdjust = SampleType(1) / juce::MathConstants<SampleType>::sqrt2;
-                for (size_t i = 0; i < numSamples; ++i)
+                else if (output != dry)
                 {
-                    //////////////////////// Mono Chorus ///////////////////////////
-                    SampleType mixLevel = m_mixLevel[channel].getNextValue();
-                    output[i] = dryIn[i] * (1 - mixLevel) + (processedInA[i] + processedInB[i]) * mixLevel * gainAdjust;
+                    std::copy(dry, dry + numSamples, output);
                 }
-            }
-            break;
-            case Mode::DIMENSION:
-                for (size_t i = 0; i < numSamples; ++i)
+                break;
+            case MixState::WET:
+                if (!isPaired)
                 {
-                    //////////////////////// Dimension Chorus  /////////////////////
-                    SampleType mixLevel = m_mixLevel[channel].getNextValue();
-                    output[i] = (boost.processSample(dryIn[i])) * (1 - mixLevel) + (processedInA[i] - cut.processSample(processedInB[i])) * mixLevel;
+                    std::copy(processedInA, processedInA + numSamples, output);
+                    break;
                 }
+
+                mixPair<ModeType, true>(dry, processedInA, processedInB, output, mixGains, numSamples, channel);
                 break;
-            case Mode::VIBRATO:
-                for (size_t i = 0; i < numSamples; ++i)
+            case MixState::MIXED:
+            default:
+                if (!isPaired)
                 {
-                    //////////////////////// Stereo Chorus /////////////////////////
-                    SampleType mixLevel = m_mixLevel[channel].getNextValue();
-                    output[i] = dryIn[i] * (1 - mixLevel) + (processedInA[i]) * mixLevel;
+                    for (size_t i = 0; i < numSamples; ++i)
+                    {
+                        //////////////////////// Unpaired Channel / Vibrato ////////////
+                        SampleType mixLevel = mixGains[i];
+                        output[i] = dry[i] * (1 - mixLevel) + processedInA[i] * mixLevel;
+                    }
+                    break;
                 }
-            default:
+
+                mixPair<ModeType, false>(dry, processedInA, processedInB, output, mixGains, numSamples, channel);
                 break;
             }
         }
     }
 
-    //==============================================================================
-    // private members
-private:
-    // audio block for processing the delays
-    juce::HeapBlock<char> heapBlock;
-    juce::dsp::AudioBlock<SampleType> tempBlock;
+    // mixes a channel with its partner, a fully wet stereo or mono mix leaves out the dry signal
+    template<Mode ModeType, bool IsWet>
+    void mixPair(const SampleType* dry, const SampleType* processedInA, const SampleType* processedInB, 
+        SampleType* output, const SampleType* mixGains, size_t numSamples, size_t channel) noexcept
+    {
+        switch (ModeType)
+        {
+        case Mode::STEREO:
+            if (IsWet)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    output[i] = processedInA[i] - processedInB[i];
+                break;
+            }
 
-    SampleType m_sampleRate{};
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                //////////////////////// Stereo Chorus /////////////////////////
+                SampleType mixLevel = mixGains[i];
+                output[i] = dry[i] * (1 - mixLevel) + (processedInA[i] - processedInB[i]) * mixLevel;
+            }
+            break;
+        case Mode::MONO:
+        {
+            SampleType gainAdjust = SampleType(1) / MathConstants<SampleType>::sqrt2;
 
-    // the mix level of wet/dry signal, 1 is 100% wet and 0 is 100% dry
-    // need a smoothed value per channel so that getNextValue() returns the same value for each channel
-    std::vector<juce::SmoothedValue<SampleType>> m_mixLevel;
+            if (IsWet)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    output[i] = (processedInA[i] + processedInB[i]) * gainAdjust;
+                break;
+            }
 
-    // this enum determines the algorithm used by the chorus engine
-    Mode m_mode{ Mode::STEREO };
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                //////////////////////// Mono Chorus ///////////////////////////
+                SampleType mixLevel = mixGains[i];
+                output[i] = dry[i] * (1 - mixLevel) + (processedInA[i] + processedInB[i]) * mixLevel * gainAdjust;
+            }
+        }
+        break;
+        case Mode::DIMENSION:
+        {
+            // the shelf filters are recursive so they're run first, which leaves the mix loop free to vectorise
+            // the boost has to keep running even when fully wet so the dimension mix is never IsWet
+            auto* boosted = m_boostBuffer.data();
+            auto* cut = m_cutBuffer.data();
+            auto& boostFilter = m_boostFilters[channel];
+            auto& cutFilter = m_cutFilters[channel];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                boosted[i] = boostFilter.processSample(dry[i]);
+                cut[i] = cutFilter.processSample(processedInB[i]);
+            }
 
-    enum {
-        voicesIndex,
-        highPassIndex,
-        lowPassIndex
-    };
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                //////////////////////// Dimension Chorus  /////////////////////
+                SampleType mixLevel = mixGains[i];
+                output[i] = boosted[i] * (1 - mixLevel) + (processedInA[i] - cut[i]) * mixLevel;
+            }
+        }
+        break;
+        case Mode::VIBRATO:
+        default:
+            // vibrato is never paired
+            assert(false);
+            break;
+        }
+    }
+
+    // the boosted dry signal and the cut partner voices in dimension mode
+    std::vector<SampleType> m_boostBuffer;
+    std::vector<SampleType> m_cutBuffer;
+
+    // discrete parameters set with setDiscreteParameters() wait here until the wet signal is faded out
+    Mode m_pendingMode{ Mode::STEREO };
+    size_t m_pendingNumVoices{ 1 };
+    WaveType m_pendingLfoType{ WaveType::TRI };
+    bool m_hasPendingSwitch{ false };
+
+    // the number of active voices is capped at this, eg. to save cpu
+    size_t m_voiceLimit{ MaxVoices };
 
-    juce::dsp::ProcessorChain<
-        ChorusVoices<SampleType>,
-        juce::dsp::StateVariableTPTFilter<SampleType>,
-        juce::dsp::StateVariableTPTFilter<SampleType>
-    > processorChain;
+    // the wet signal fades to dry and back over this time in sec when the discrete parameters switch
+    const SampleType m_switchFadeTime{ SampleType(1e-2) };
+    SmoothedValue<SampleType> m_switchFade{ SampleType(1) };
+    std::vector<SampleType> m_switchGains;
+
+    // whether the wet signal was muted by the mix last block, the voices and filters are skipped while it is
+    bool m_isWetMuted{ false };
+
+    // applies a pending switch once the wet signal is faded out and fills the switch gains for the block
+    // returns true if the switch fade moved during the block
+    bool updateSwitchFade(size_t numSamples) noexcept;
+
+    // applies the pending discrete parameters
+    void applyPendingSwitch();
+
+    // the voices are processed separately from the filters so that they can read the undelayed input
+    ChorusVoices<SampleType, MaxVoices> m_voices;
 
     // high and low pass filters which can be used to filter the processed signal
-    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> m_hiPassCutoff{ SampleType(20) };
-    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> m_lowPassCutoff{ SampleType(20000) };
-    const size_t m_filterUpdateRate{ 100 };
+    BandLimiter<SampleType> m_bandLimiter;
 
     // cut and boost filters for each channel
     // these cannot be part of the processor chain because they're being applied to specific things
     // boost(dry signal) + wet_channelA - cut(wet_channelB)
-    std::vector<juce::dsp::IIR::Filter<SampleType>> m_boostFilters;
-    std::vector<juce::dsp::IIR::Filter<SampleType>> m_cutFilters;
+    std::vector<BiquadFilter<SampleType>> m_boostFilters;
+    std::vector<BiquadFilter<SampleType>> m_cutFilters;
     SampleType m_crossoverFreq{ SampleType(200) };
 
-    void updateFilterCutoffs(int skip = 0);
+    // the groups of channels that are paired together
+    // partners are the channel each channel is mixed with, sides alternate within a group
+    std::vector<std::vector<size_t>> m_channelGroups;
+    std::vector<size_t> m_channelPartners;
+    std::vector<size_t> m_channelSides;
+
+    // optional task runner for processing channel groups in parallel
+    TaskRunner* m_taskRunner{ nullptr };
+    bool m_useTaskRunner{ false };
+    size_t m_pendingGroups{ 0 };
+    std::mutex m_groupsMutex;
+    std::condition_variable m_groupsFinished;
+
+    // creates the default groups if none were set or if they don't match the number of channels
+    void updateChannelGroups(size_t numChannels);
+
+    // processes the voices for each channel group, the first group is processed on the calling thread
+    template<typename ProcessContext>
+    void processGroupsInParallel(const ProcessContext& context, const AudioBlock<const SampleType>& dryBlock) noexcept
+    {
+        m_pendingGroups = m_channelGroups.size() - 1;
+
+        for (size_t group = 1; group < m_channelGroups.size(); ++group)
+        {
+            m_taskRunner->run([this, &context, &dryBlock, group]()
+            {
+                m_voices.processChannels(context, dryBlock, m_channelGroups[group]);
+
+                // the engine may be gone as soon as the last group is counted, so it's notified under the lock
+                std::lock_guard<std::mutex> lock(m_groupsMutex);
+
+                if (--m_pendingGroups == 0)
+                    m_groupsFinished.notify_one();
+            });
+        }
+
+        m_voices.processChannels(context, dryBlock, m_channelGroups[0]);
+
+        std::unique_lock<std::mutex> lock(m_groupsMutex);
+        m_groupsFinished.wait(lock, [this]() { return m_pendingGroups == 0; });
+    }
+
+    // delay lines used to align the dry signal with the wet signal
+    std::vector<DelayBuffer<SampleType>> m_dryDelays;
+    LatencyMode m_latencyMode{ LatencyMode::ZERO };
+    LatencyMode m_lastLatencyMode{ LatencyMode::ZERO };
+    SampleType m_referenceDelay{ SampleType(5e-3) };
+    const SampleType m_maxReferenceDelay{ SampleType(1e-1) };
+    size_t m_dryDelaySamples{ 0 };
+
+    void updateDryDelay();
+
+    // the model measured with chorus-bench cost calibrate
+    static const CostModel costModel;
 
 public:
     //==============================================================================
@@ -192,6 +550,12 @@ public:
     // set the lfo depth using a value from 0-1
     void setDepth(SampleType depth);
 
+    // sets the minimum rate in Hz at which the voice lfos are evaluated, 0 evaluates every sample
+    void setLfoControlRate(SampleType controlRate);
+
+    // sets the interpolation used to read the voices, higher orders cost more but keep more of the highs
+    void setInterpolation(Interpolation interpolation);
+
     // sets the delay time
     void setDelayTime(SampleType delayTime);
 
@@ -205,17 +569,41 @@ public:
     // sets the processing mode for the chorus engine
     void setMode(Mode mode);
 
-    // bypasses inactive voices
+    // sets the number of active voices per channel, inactive voices are bypassed
     void setNumVoice(size_t numVoices);
 
-    // offsets the phase of the left lfo
-    void setPhaseOffset(SampleType phaseOffset, size_t channel = 0);
+    // caps the number of active voices, the voices are spread as if only this many were set
+    // the cap is switched behind the same fade as setDiscreteParameters(), so it can be called from the audio thread
+    // the voices are scaled by 1 / sqrt(voices) so the level stays about the same
+    void setVoiceLimit(size_t maxVoices);
+
+    // sets the mode, the number of voices and the lfo type without a jump in the output
+    // the wet signal fades to dry, the parameters switch, then it fades back in
+    // this doesn't allocate or prepare anything so it can be called from the audio thread, eg. while morphing
+    void setDiscreteParameters(Mode mode, size_t numVoices, WaveType lfoType);
+
+    // offsets the phase of the lfo for each channel on the given side, 0 is left and 1 is right
+    void setPhaseOffset(SampleType phaseOffset, size_t side = 0);
 
     // sets the wave type of the lfo oscillator
     void setLfoType(WaveType type);
 
-    // returns the delay time in samples which determines the latency
+    // sets whether the dry signal is delayed to align with the wet signal
+    void setLatencyMode(LatencyMode mode);
+
+    // sets the delay time in sec that the dry signal is delayed by in aligned mode
+    void setReferenceDelay(SampleType delayTime);
+
+    // returns the latency in samples, this is the reference delay in aligned mode and 0 otherwise
     int getLatency() const;
+
+    // estimates the time in ns it takes to process one sample on every channel of the spec, the engine doesn't need to be prepared
+    // the model was calibrated on one machine so it's a relative guide on others, eg. for comparing configurations
+    // the cost per sample doesn't depend on the sample rate, multiply it by the sample rate for the share of the real time budget
+    static double estimateCost(const ProcessSpec& spec, const CostSettings& settings);
+
+    // estimates the cost with another model, eg. one calibrated on the machine that will run the engine
+    static double estimateCost(const ProcessSpec& spec, const CostSettings& settings, const CostModel& model);
 };
 
 //==============================================================================
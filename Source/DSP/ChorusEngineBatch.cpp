@@ -0,0 +1,567 @@
+/*
+  ==============================================================================
+
+    ChorusEngineBatch.cpp
+    Created: 19 Oct 2026 10:58:31pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "ChorusEngineBatch.h"
+
+namespace dingus
+{
+
+//==============================================================================
+template<typename SampleType, size_t MaxVoices>
+ChorusEngineBatch<SampleType, MaxVoices>::ChorusEngineBatch()
+{
+    m_lfoValues.fill(std::numeric_limits<SampleType>::quiet_NaN());
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::prepare(const ProcessSpec& spec, size_t numStreams)
+{
+    // every stream is a left/right pair
+    assert(spec.numChannels == 2 && numStreams > 0);
+
+    m_numStreams = numStreams;
+    m_sampleRate = static_cast<SampleType>(spec.sampleRate);
+
+    size_t numChannels = 2 * numStreams;
+    ProcessSpec batchSpec{ spec.sampleRate, spec.maximumBlockSize, static_cast<std::uint32_t>(numChannels) };
+
+    m_inputs.resize(numChannels);
+    m_chorus.resize(numChannels);
+    tempBlock = tempStorage.allocate(numChannels, spec.maximumBlockSize);
+
+    // the delay lines only need to hold the longest delay, there is one row for each sample
+    m_bufferSize = static_cast<size_t>(std::ceil(m_maxDelayTime * m_sampleRate));
+
+    for (auto& delayLine : m_delayLines)
+        delayLine.assign(m_bufferSize * numStreams, SampleType(0));
+
+    for (auto& allpassStates : m_allpassStates)
+        allpassStates.assign(MaxVoices * numStreams, SampleType(0));
+
+    m_voiceSums.assign(numStreams, SampleType(0));
+    m_position = 0;
+
+    for (size_t side = 0; side < 2; ++side)
+    {
+        m_lfos[side].prepare(spec);
+        m_lfoDepth[side].reset(spec.sampleRate, 0.2);
+
+        for (auto& delayTime : m_delayTimes[side])
+            delayTime.reset(spec.sampleRate, 0.5);
+    }
+
+    m_lfoValues.fill(std::numeric_limits<SampleType>::quiet_NaN());
+    setLfoControlRate(m_lfoControlRate);
+
+    // nothing is playing so every voice can jump to its delay time
+    updateDelayTime(0, MaxVoices, true);
+
+    // shelving filters for cut and boost, the same as ChorusEngine
+    auto boostCoef = BiquadCoefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(13e-1));
+    auto cutCoef = BiquadCoefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(7e-1));
+
+    m_boostFilters.resize(numChannels);
+    m_cutFilters.resize(numChannels);
+
+    for (auto& boostFilter : m_boostFilters)
+    {
+        boostFilter.reset();
+        boostFilter.coefficients = boostCoef;
+    }
+
+    for (auto& cutFilter : m_cutFilters)
+    {
+        cutFilter.reset();
+        cutFilter.coefficients = cutCoef;
+    }
+
+    m_boostBuffer.assign(spec.maximumBlockSize, SampleType(0));
+    m_cutBuffer.assign(spec.maximumBlockSize, SampleType(0));
+
+    m_bandLimiter.prepare(batchSpec);
+
+    m_mixLevel.reset(spec.sampleRate, 0.2);
+    m_mixGains.assign(spec.maximumBlockSize, SampleType(0));
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::reset()
+{
+    for (auto& delayLine : m_delayLines)
+        std::fill(delayLine.begin(), delayLine.end(), SampleType(0));
+
+    for (auto& allpassStates : m_allpassStates)
+        std::fill(allpassStates.begin(), allpassStates.end(), SampleType(0));
+
+    m_position = 0;
+
+    for (auto& lfo : m_lfos)
+        lfo.reset();
+
+    m_lfoValues.fill(std::numeric_limits<SampleType>::quiet_NaN());
+
+    m_bandLimiter.reset();
+
+    for (auto& boostFilter : m_boostFilters)
+        boostFilter.reset();
+
+    for (auto& cutFilter : m_cutFilters)
+        cutFilter.reset();
+}
+
+//==============================================================================
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::processSide(size_t side, size_t numSamples) noexcept
+{
+    switch (m_interpolation)
+    {
+    case Interpolation::HERMITE:
+        processSide<Interpolation::HERMITE>(side, numSamples);
+        break;
+    case Interpolation::LAGRANGE:
+        processSide<Interpolation::LAGRANGE>(side, numSamples);
+        break;
+    case Interpolation::THIRAN:
+        processSide<Interpolation::THIRAN>(side, numSamples);
+        break;
+    case Interpolation::LINEAR:
+    default:
+        processSide<Interpolation::LINEAR>(side, numSamples);
+        break;
+    }
+}
+
+template<typename SampleType, size_t MaxVoices>
+template<Interpolation Type>
+void ChorusEngineBatch<SampleType, MaxVoices>::processSide(size_t side, size_t numSamples) noexcept
+{
+    size_t numVoices = m_activeVoices;
+    SampleType gain = SampleType(1) / std::sqrt(static_cast<SampleType>(numVoices));
+    size_t position = m_position;
+
+    if (m_controlInterval > 1)
+    {
+        // the lfo is evaluated at the end of each control period and interpolated in between
+        SampleType lfoValue = getLfoValue(side);
+
+        for (size_t i = 0; i < numSamples;)
+        {
+            size_t numSteps = std::min(m_controlInterval, numSamples - i);
+            SampleType nextLfoValue = advanceLfo(side, numSteps);
+            SampleType lfoIncrement = (nextLfoValue - lfoValue) / static_cast<SampleType>(numSteps);
+
+            for (size_t step = 0; step < numSteps; ++step, ++i)
+            {
+                processSample<Type>(side, i, position, lfoValue + lfoIncrement * static_cast<SampleType>(step), gain);
+                position = position == 0 ? m_bufferSize - 1 : position - 1;
+            }
+
+            lfoValue = nextLfoValue;
+        }
+
+        m_lfoValues[side] = lfoValue;
+    }
+    else
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            SampleType lfoValue = (m_lfos[side].processSample() + SampleType(2)) * SampleType(5e-1) * m_lfoDepth[side].getNextValue();
+            processSample<Type>(side, i, position, lfoValue, gain);
+            position = position == 0 ? m_bufferSize - 1 : position - 1;
+        }
+    }
+
+    // inactive voices still need to move towards their target so they don't glide when they become active
+    for (size_t voice = numVoices; voice < MaxVoices; ++voice)
+        m_delayTimes[side][voice].skip(static_cast<int>(numSamples));
+}
+
+template<typename SampleType, size_t MaxVoices>
+template<Interpolation Type>
+void ChorusEngineBatch<SampleType, MaxVoices>::processSample(size_t side, size_t sample, size_t position,
+    SampleType lfoValue, SampleType gain) noexcept
+{
+    size_t numStreams = m_numStreams;
+    auto* delayLine = m_delayLines[side].data();
+    auto* voiceSums = m_voiceSums.data();
+    auto* allpassStates = m_allpassStates[side].data();
+    auto& delayTimes = m_delayTimes[side];
+
+    std::fill(voiceSums, voiceSums + numStreams, SampleType(0));
+
+    // the delay time of a voice is the same for every stream
+    for (size_t voice = 0; voice < m_activeVoices; ++voice)
+        addVoice<Type>(delayLine, position, (delayTimes[voice].getNextValue() + lfoValue) * m_sampleRate,
+            allpassStates + voice * numStreams);
+
+    // the left channels are even and the right channels are odd
+    SampleType* row = delayLine + position * numStreams;
+
+    for (size_t stream = 0; stream < numStreams; ++stream)
+    {
+        size_t channel = 2 * stream + side;
+        SampleType input = m_inputs[channel][sample];
+
+        m_chorus[channel][sample] = input + voiceSums[stream] * gain;
+        row[stream] = input;
+    }
+}
+
+template<typename SampleType, size_t MaxVoices>
+template<Interpolation Type>
+void ChorusEngineBatch<SampleType, MaxVoices>::addVoice(const SampleType* delayLine, size_t position, SampleType delayTime,
+    SampleType* allpassStates) noexcept
+{
+    assert(delayTime >= SampleType(0) && delayTime < static_cast<SampleType>(m_bufferSize - 2));
+
+    size_t numStreams = m_numStreams;
+    size_t bufferSize = m_bufferSize;
+    auto* voiceSums = m_voiceSums.data();
+
+    // the read position is worked out once for every stream, the same way as DelayBuffer
+    size_t delayInSamples = static_cast<size_t>(delayTime);
+    SampleType frac = delayTime - static_cast<SampleType>(delayInSamples);
+    size_t index = position + delayInSamples + 1;
+
+    if (index >= bufferSize)
+        index -= bufferSize;
+
+    // there is no newer sample to read for delays under 1 sample so the 4 point reads fall back to linear
+    Interpolation type = Type;
+
+    if ((Type == Interpolation::HERMITE || Type == Interpolation::LAGRANGE) && delayTime < SampleType(1))
+        type = Interpolation::LINEAR;
+
+    // the rows around index, from the newest to the oldest
+    size_t index0 = index == 0 ? bufferSize - 1 : index - 1;
+    size_t index2 = index + 1 == bufferSize ? 0 : index + 1;
+    size_t index3 = index2 + 1 == bufferSize ? 0 : index2 + 1;
+
+    const SampleType* row0 = delayLine + index0 * numStreams;
+    const SampleType* row1 = delayLine + index * numStreams;
+    const SampleType* row2 = delayLine + index2 * numStreams;
+    const SampleType* row3 = delayLine + index3 * numStreams;
+
+    switch (type)
+    {
+    case Interpolation::HERMITE:
+        for (size_t stream = 0; stream < numStreams; ++stream)
+        {
+            // catmull-rom spline between row1 and row2
+            SampleType c1 = SampleType(5e-1) * (row2[stream] - row0[stream]);
+            SampleType c2 = row0[stream] - SampleType(25e-1) * row1[stream] + SampleType(2) * row2[stream] - SampleType(5e-1) * row3[stream];
+            SampleType c3 = SampleType(5e-1) * (row3[stream] - row0[stream]) + SampleType(15e-1) * (row1[stream] - row2[stream]);
+
+            voiceSums[stream] += ((c3 * frac + c2) * frac + c1) * frac + row1[stream];
+        }
+        break;
+    case Interpolation::LAGRANGE:
+    {
+        // the weights only depend on the delay so they're shared by every stream
+        SampleType fracPlusOne = frac + SampleType(1);
+        SampleType fracMinusOne = frac - SampleType(1);
+        SampleType fracMinusTwo = frac - SampleType(2);
+
+        SampleType h0 = -frac * fracMinusOne * fracMinusTwo / SampleType(6);
+        SampleType h1 = fracPlusOne * fracMinusOne * fracMinusTwo * SampleType(5e-1);
+        SampleType h2 = -fracPlusOne * frac * fracMinusTwo * SampleType(5e-1);
+        SampleType h3 = fracPlusOne * frac * fracMinusOne / SampleType(6);
+
+        for (size_t stream = 0; stream < numStreams; ++stream)
+            voiceSums[stream] += h0 * row0[stream] + h1 * row1[stream] + h2 * row2[stream] + h3 * row3[stream];
+    }
+    break;
+    case Interpolation::THIRAN:
+    {
+        // keep the allpass delay between 0.618 and 1.618 samples, see DelayBuffer::getAllpass()
+        if (frac < SampleType(0.618) && delayTime >= SampleType(1))
+        {
+            row2 = row1;
+            row1 = row0;
+            frac += SampleType(1);
+        }
+
+        SampleType coefficient = (SampleType(1) - frac) / (SampleType(1) + frac);
+
+        for (size_t stream = 0; stream < numStreams; ++stream)
+        {
+            allpassStates[stream] = coefficient * (row1[stream] - allpassStates[stream]) + row2[stream];
+            voiceSums[stream] += allpassStates[stream];
+        }
+    }
+    break;
+    case Interpolation::LINEAR:
+    default:
+        for (size_t stream = 0; stream < numStreams; ++stream)
+            voiceSums[stream] += row1[stream] + frac * (row2[stream] - row1[stream]);
+        break;
+    }
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::mixStreams(const AudioBlock<const SampleType>& dryBlock,
+    const AudioBlock<SampleType>& chorusBlock, const AudioBlock<SampleType>& outputBlock) noexcept
+{
+    auto numSamples = outputBlock.getNumSamples();
+    auto* mixGains = m_mixGains.data();
+    Mode mode = m_mode;
+
+    for (size_t channel = 0; channel < 2 * m_numStreams; ++channel)
+    {
+        // each channel is mixed with the other channel of its stream
+        auto* dry = dryBlock.getChannelPointer(channel);
+        auto* processedInA = chorusBlock.getChannelPointer(channel);
+        auto* processedInB = chorusBlock.getChannelPointer(channel ^ 1);
+        auto* output = outputBlock.getChannelPointer(channel);
+
+        switch (mode)
+        {
+        case Mode::STEREO:
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                SampleType mixLevel = mixGains[i];
+                output[i] = dry[i] * (1 - mixLevel) + (processedInA[i] - processedInB[i]) * mixLevel;
+            }
+            break;
+        case Mode::MONO:
+        {
+            SampleType gainAdjust = SampleType(1) / MathConstants<SampleType>::sqrt2;
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                SampleType mixLevel = mixGains[i];
+                output[i] = dry[i] * (1 - mixLevel) + (processedInA[i] + processedInB[i]) * mixLevel * gainAdjust;
+            }
+        }
+        break;
+        case Mode::DIMENSION:
+        {
+            auto* boosted = m_boostBuffer.data();
+            auto* cut = m_cutBuffer.data();
+            auto& boostFilter = m_boostFilters[channel];
+            auto& cutFilter = m_cutFilters[channel];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                boosted[i] = boostFilter.processSample(dry[i]);
+                cut[i] = cutFilter.processSample(processedInB[i]);
+            }
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                SampleType mixLevel = mixGains[i];
+                output[i] = boosted[i] * (1 - mixLevel) + (processedInA[i] - cut[i]) * mixLevel;
+            }
+        }
+        break;
+        case Mode::VIBRATO:
+        default:
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                SampleType mixLevel = mixGains[i];
+                output[i] = dry[i] * (1 - mixLevel) + processedInA[i] * mixLevel;
+            }
+            break;
+        }
+    }
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::updateMixGains(size_t numSamples) noexcept
+{
+    if (!m_mixLevel.isSmoothing())
+    {
+        std::fill(m_mixGains.begin(), m_mixGains.begin() + numSamples, m_mixLevel.getTargetValue());
+        return;
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+        m_mixGains[i] = m_mixLevel.getNextValue();
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::updateDelayTime(size_t firstVoice, size_t lastVoice, bool force)
+{
+    for (size_t voice = firstVoice; voice < lastVoice; ++voice)
+    {
+        for (size_t side = 0; side < 2; ++side)
+        {
+            SampleType delayTime = ChorusVoices<SampleType, MaxVoices>::getVoiceDelayTime(voice, m_activeVoices, side,
+                m_delayTime, m_delayWidth, m_spread);
+
+            assert(delayTime > SampleType(0) && delayTime < (m_maxDelayTime - m_maxDepth));
+
+            if (force)
+                m_delayTimes[side][voice].setCurrentAndTargetValue(delayTime);
+            else
+                m_delayTimes[side][voice].setTargetValue(delayTime);
+        }
+    }
+}
+
+template<typename SampleType, size_t MaxVoices>
+SampleType ChorusEngineBatch<SampleType, MaxVoices>::getLfoValue(size_t side)
+{
+    if (std::isnan(m_lfoValues[side]))
+        m_lfoValues[side] = (m_lfos[side].processSample() + SampleType(2)) * SampleType(5e-1) * m_lfoDepth[side].getNextValue();
+
+    return m_lfoValues[side];
+}
+
+template<typename SampleType, size_t MaxVoices>
+SampleType ChorusEngineBatch<SampleType, MaxVoices>::advanceLfo(size_t side, size_t numSteps)
+{
+    assert(numSteps > 0);
+
+    m_lfos[side].skip(numSteps - 1);
+    SampleType depth = m_lfoDepth[side].skip(static_cast<int>(numSteps));
+
+    return (m_lfos[side].processSample() + SampleType(2)) * SampleType(5e-1) * depth;
+}
+
+//==============================================================================
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setMix(SampleType mix)
+{
+    m_mixLevel.setTargetValue(mix);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setHighPass(SampleType cutoff)
+{
+    m_bandLimiter.setHighPass(cutoff);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setLowPass(SampleType cutoff)
+{
+    m_bandLimiter.setLowPass(cutoff);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setFilterBypass(bool bypass)
+{
+    m_bandLimiter.setBypass(bypass);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setRate(SampleType rate)
+{
+    assert(rate >= SampleType(0));
+
+    for (auto& lfo : m_lfos)
+        lfo.setFrequency(rate);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setDepth(SampleType depth)
+{
+    for (auto& lfoDepth : m_lfoDepth)
+        lfoDepth.setTargetValue(depth * m_maxDepth);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setLfoControlRate(SampleType controlRate)
+{
+    assert(controlRate >= SampleType(0));
+    m_lfoControlRate = controlRate;
+
+    size_t interval = getControlInterval(static_cast<double>(m_sampleRate), static_cast<double>(controlRate));
+
+    if (interval == m_controlInterval)
+        return;
+
+    // the lfo values are evaluated again when the control rate path runs
+    m_controlInterval = interval;
+    m_lfoValues.fill(std::numeric_limits<SampleType>::quiet_NaN());
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setInterpolation(Interpolation interpolation)
+{
+    assert(interpolation != Interpolation::MAX);
+
+    if (interpolation == m_interpolation)
+        return;
+
+    // the allpass states are only valid for the interpolation they were made with
+    m_interpolation = interpolation;
+
+    for (auto& allpassStates : m_allpassStates)
+        std::fill(allpassStates.begin(), allpassStates.end(), SampleType(0));
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setDelayTime(SampleType delayTime)
+{
+    m_delayTime = delayTime;
+    updateDelayTime(0, m_activeVoices, false);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setDelayWidth(SampleType width)
+{
+    m_delayWidth = width;
+    updateDelayTime(0, m_activeVoices, false);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setVoiceSpread(SampleType spread)
+{
+    m_spread = spread;
+    updateDelayTime(0, m_activeVoices, false);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setMode(Mode mode)
+{
+    m_mode = mode;
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setNumVoice(size_t numVoices)
+{
+    numVoices = limit(size_t(1), MaxVoices, numVoices);
+    size_t lastVoices = m_activeVoices;
+    m_activeVoices = numVoices;
+
+    // the voices that weren't active jump to their delay time, the same as ChorusVoices::setActiveVoices()
+    updateDelayTime(0, std::min(lastVoices, numVoices), false);
+    updateDelayTime(lastVoices, numVoices, true);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setPhaseOffset(SampleType phaseOffset, size_t side/* = 0*/)
+{
+    if (side < m_lfos.size())
+        m_lfos[side].setPhaseOffset(phaseOffset);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusEngineBatch<SampleType, MaxVoices>::setLfoType(WaveType type)
+{
+    for (auto& lfo : m_lfos)
+        lfo.setType(type);
+}
+
+template<typename SampleType, size_t MaxVoices>
+size_t ChorusEngineBatch<SampleType, MaxVoices>::getNumStreams() const
+{
+    return m_numStreams;
+}
+
+//==============================================================================
+
+template class ChorusEngineBatch<float, 64>;
+template class ChorusEngineBatch<double, 64>;
+
+} // dingus
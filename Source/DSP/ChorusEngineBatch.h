@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    ChorusEngineBatch.h
+    Created: 19 Oct 2026 10:58:31pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DspCore.h"
+#include <vector>
+#include <array>
+#include <cmath>
+#include <limits>
+#include "ChorusEngine.h"
+
+namespace dingus
+{
+
+//==============================================================================
+/**
+    This class runs the chorus on many independent stereo streams that all use the same settings,
+    eg. for rendering on a server.  Since the settings are the same, every stream has the same lfos
+    and voice delay times, so they are evaluated once for the whole batch, and the filter coefficients
+    are shared by every stream.  The delay lines of the streams are interleaved, each sample is a row
+    with one lane per stream, so a voice reads the same position of every stream from one contiguous
+    row and the read vectorizes across the streams.
+    Each stream matches a ChorusEngine with the same settings in zero latency mode.  Mode and voice
+    changes are applied at the next block without a fade, the batch is meant for rendering with fixed
+    discrete settings, and the delay time is limited to m_maxDelayTime.
+*/
+template<typename SampleType, size_t MaxVoices = 64>
+class ChorusEngineBatch
+{
+public:
+    static_assert(MaxVoices > 0, "ChorusEngineBatch needs at least one voice");
+
+    ChorusEngineBatch();
+
+    // prepares the batch for playback, the spec is for a single stereo stream
+    void prepare(const ProcessSpec& spec, size_t numStreams);
+
+    // resets the delay lines, lfos and filters of every stream
+    void reset();
+
+    // processes a block of every stream using a ProcessContext
+    // the block has two channels per stream, the left and right channels of stream n are channels 2n and 2n + 1
+    template<typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        auto numSamples = outputBlock.getNumSamples();
+
+        assert(outputBlock.getNumChannels() == 2 * m_numStreams);
+        assert(numSamples <= m_mixGains.size());
+
+        auto chorusBlock = tempBlock.getSubBlock(0, numSamples);
+
+        for (size_t channel = 0; channel < 2 * m_numStreams; ++channel)
+        {
+            m_inputs[channel] = inputBlock.getChannelPointer(channel);
+            m_chorus[channel] = chorusBlock.getChannelPointer(channel);
+        }
+
+        updateMixGains(numSamples);
+
+        // the voices are written on top of the dry signal straight into the chorus block
+        for (size_t side = 0; side < 2; ++side)
+            processSide(side, numSamples);
+
+        // both sides push the same number of samples
+        m_position = (m_position + m_bufferSize - numSamples % m_bufferSize) % m_bufferSize;
+
+        // high and low pass the voices, the coefficients are shared by every channel
+        ProcessContextReplacing<SampleType> filterContext(chorusBlock);
+        m_bandLimiter.process(filterContext);
+
+        mixStreams(inputBlock, chorusBlock, outputBlock);
+    }
+
+private:
+    size_t m_numStreams{ 0 };
+    SampleType m_sampleRate{ SampleType(44100) };
+
+    // audio block for the voices of every stream
+    AudioBlockStorage<SampleType> tempStorage;
+    AudioBlock<SampleType> tempBlock;
+
+    // the channel pointers of the block being processed
+    std::vector<const SampleType*> m_inputs;
+    std::vector<SampleType*> m_chorus;
+
+    // the delay lines of each side, the rows hold one sample of every stream
+    // both sides write the same position, it moves backwards through the buffer like DelayBuffer
+    std::array<std::vector<SampleType>, 2> m_delayLines;
+    size_t m_bufferSize{ 0 };
+    size_t m_position{ 0 };
+    const SampleType m_maxDelayTime{ SampleType(1e-1) };
+
+    // the sum of the voices of every stream for the current sample
+    std::vector<SampleType> m_voiceSums;
+
+    // the previous output of every voice of every stream, used by the thiran allpass
+    std::array<std::vector<SampleType>, 2> m_allpassStates;
+
+    // the lfo, depth and voice delay times of each side, shared by every stream
+    std::array<Oscillator<SampleType>, 2> m_lfos;
+    std::array<SmoothedValue<SampleType>, 2> m_lfoDepth;
+    std::array<std::array<SmoothedValue<SampleType>, MaxVoices>, 2> m_delayTimes;
+    const SampleType m_maxDepth{ SampleType(1e-3) };
+
+    // the lfos are evaluated every m_controlInterval samples and interpolated in between, see ModDelay
+    SampleType m_lfoControlRate{ 0 };
+    size_t m_controlInterval{ 1 };
+    std::array<SampleType, 2> m_lfoValues;
+
+    Interpolation m_interpolation{ Interpolation::LINEAR };
+
+    // the voice settings, see ChorusVoices
+    size_t m_activeVoices{ 1 };
+    SampleType m_delayTime{ SampleType(5e-3) };
+    SampleType m_delayWidth{ SampleType(0) };
+    SampleType m_spread{ 1 };
+
+    Mode m_mode{ Mode::STEREO };
+
+    // the mix level of wet/dry signal, 1 is 100% wet and 0 is 100% dry
+    SmoothedValue<SampleType> m_mixLevel;
+    std::vector<SampleType> m_mixGains;
+
+    // high and low pass filters for the voices of every stream
+    BandLimiter<SampleType> m_bandLimiter;
+
+    // cut and boost filters for each channel used by the dimension mode
+    std::vector<BiquadFilter<SampleType>> m_boostFilters;
+    std::vector<BiquadFilter<SampleType>> m_cutFilters;
+    std::vector<SampleType> m_boostBuffer;
+    std::vector<SampleType> m_cutBuffer;
+    const SampleType m_crossoverFreq{ SampleType(200) };
+
+    // fills the mix gains for the block
+    void updateMixGains(size_t numSamples) noexcept;
+
+    // updates the delay times of the voices from firstVoice up to lastVoice, force skips the smoothing
+    void updateDelayTime(size_t firstVoice, size_t lastVoice, bool force);
+
+    // returns the lfo offset in secs for the current sample of a side, used at control rate
+    SampleType getLfoValue(size_t side);
+
+    // advances the lfo of a side by numSteps samples and returns the lfo offset in secs at that point
+    SampleType advanceLfo(size_t side, size_t numSteps);
+
+    // writes dry + the voices of one side of every stream to the chorus block and pushes the input
+    void processSide(size_t side, size_t numSamples) noexcept;
+
+    // processSide() for a given interpolation
+    template<Interpolation Type>
+    void processSide(size_t side, size_t numSamples) noexcept;
+
+    // reads every voice of one side for a sample of every stream, writes dry + the voices and pushes the input
+    // position is the write position of the delay lines
+    template<Interpolation Type>
+    void processSample(size_t side, size_t sample, size_t position, SampleType lfoValue, SampleType gain) noexcept;
+
+    // adds a voice read at delayTime samples to the voice sums of every stream
+    template<Interpolation Type>
+    void addVoice(const SampleType* delayLine, size_t position, SampleType delayTime, SampleType* allpassStates) noexcept;
+
+    // mixes the dry signal and the voices of every stream into the output
+    void mixStreams(const AudioBlock<const SampleType>& dryBlock, const AudioBlock<SampleType>& chorusBlock,
+        const AudioBlock<SampleType>& outputBlock) noexcept;
+
+public:
+    //==============================================================================
+    // set functions, these match ChorusEngine
+
+    // sets the wet/dry mix level
+    void setMix(SampleType mix);
+
+    // sets the high pass cutoff
+    void setHighPass(SampleType cutoff);
+
+    // sets the low pass cutoff
+    void setLowPass(SampleType cutoff);
+
+    // bypasses both high pass and low pass filters
+    void setFilterBypass(bool bypass);
+
+    // set the rate of the lfo in Hz
+    void setRate(SampleType rate);
+
+    // set the lfo depth using a value from 0-1
+    void setDepth(SampleType depth);
+
+    // sets the minimum rate in Hz at which the lfos are evaluated, 0 evaluates every sample
+    void setLfoControlRate(SampleType controlRate);
+
+    // sets the interpolation used to read the voices
+    void setInterpolation(Interpolation interpolation);
+
+    // sets the delay time
+    void setDelayTime(SampleType delayTime);
+
+    // scales the delay time of the right channel down towards 1ms
+    void setDelayWidth(SampleType width);
+
+    // set the amount of spread among the delay times for each voice
+    void setVoiceSpread(SampleType spread);
+
+    // sets the processing mode
+    void setMode(Mode mode);
+
+    // sets the number of active voices per channel
+    void setNumVoice(size_t numVoices);
+
+    // offsets the phase of the lfo for the given side, 0 is left and 1 is right
+    void setPhaseOffset(SampleType phaseOffset, size_t side = 0);
+
+    // sets the wave type of the lfo oscillator
+    void setLfoType(WaveType type);
+
+    // returns the number of streams the batch was prepared for
+    size_t getNumStreams() const;
+};
+
+//==============================================================================
+} // dingus
@@ -14,146 +14,218 @@ namespace dingus
 {
 
 //==============================================================================
-template<typename SampleType>
-ChorusVoices<SampleType>::ChorusVoices()
-{
-    m_voices.resize(m_maxVoices);
-}
+template<typename SampleType, size_t MaxVoices>
+constexpr size_t ChorusVoices<SampleType, MaxVoices>::minSpreadVoices;
 
-template<typename SampleType>
-ChorusVoices<SampleType>::ChorusVoices(size_t maxVoices) : m_maxVoices(maxVoices)
+template<typename SampleType, size_t MaxVoices>
+ChorusVoices<SampleType, MaxVoices>::ChorusVoices()
 {
-    ChorusVoices();
 }
 
 //==============================================================================
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::prepare(const ProcessSpec& spec, size_t numInputChannels/* = 0*/)
+{
+    m_numInputChannels = numInputChannels == 0 ? spec.numChannels : numInputChannels;
+    m_outputPointers.resize(spec.numChannels);
+    m_dryPointers.resize(spec.numChannels);
+
+    m_voices.prepare(spec, m_numInputChannels);
+
+    // nothing is playing so every voice can jump to its delay time, the same as ChorusEngineBatch
+    updateDelayTime(0, MaxVoices, true);
+
+    m_sampleRate = spec.sampleRate;
+    setLfoControlRate(m_lfoControlRate);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::skip(const AudioBlock<const SampleType>& inputBlock, size_t numChannels) noexcept
 {
-    for (auto& voice : m_voices)
-        voice.prepare(spec);
+    auto numSamples = inputBlock.getNumSamples();
+
+    // a mono input only has a single delay line to feed
+    size_t numInputChannels = m_numInputChannels == 1 ? 1 : numChannels;
+
+    for (size_t channel = 0; channel < numInputChannels; ++channel)
+        m_voices.pushBlock(inputBlock.getChannelPointer(channel), numSamples, channel);
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        m_voices.skip(numSamples, channel);
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::reset()
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::reset()
 {
-    for (auto& voice : m_voices)
-        voice.reset();
+    m_voices.reset();
 }
 
 //==============================================================================
 // set functions
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setDelayTime(SampleType delayTime)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setDelayTime(SampleType delayTime)
 {
     m_delayTime = delayTime;
     updateDelayTime();
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setDelayWidth(SampleType width)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setDelayWidth(SampleType width)
 {
     m_delayWidth = width;
     updateDelayTime();
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setVoiceSpread(SampleType spread)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setVoiceSpread(SampleType spread)
 {
     m_spread = spread;
     updateDelayTime();
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setRate(SampleType rate)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setRate(SampleType rate)
+{
+    m_voices.setRate(rate);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setDepth(SampleType depth)
+{
+    m_voices.setDepth(depth);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setLfoControlRate(SampleType controlRate)
 {
-    for (auto& voice : m_voices)
-        voice.setRate(rate);
+    assert(controlRate >= SampleType(0));
+    m_lfoControlRate = controlRate;
+    m_voices.setControlInterval(getControlInterval(m_sampleRate, static_cast<double>(controlRate)));
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setDepth(SampleType depth)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setInterpolation(Interpolation interpolation)
 {
-    for (auto& voice : m_voices)
-        voice.setDepth(depth);
+    m_voices.setInterpolation(interpolation);
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setActiveVoices(size_t numVoices)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setActiveVoices(size_t numVoices)
 {
+    assert(numVoices > 0 && numVoices <= MaxVoices);
+    size_t lastVoices = m_activeVoices;
     m_activeVoices = numVoices;
+
+    // the spread depends on the number of active voices
+    // the voices that weren't active haven't been following the delay time, they jump to it since they aren't heard yet
+    updateDelayTime(0, std::min(lastVoices, numVoices), false);
+    updateDelayTime(lastVoices, numVoices, true);
+}
+
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setChannelSides(const std::vector<size_t>& sides)
+{
+    m_channelSides = sides;
+    updateDelayTime(0, MaxVoices, false);
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setPhaseOffset(SampleType phaseOffset, size_t channel/* = 0*/)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setPhaseOffset(SampleType phaseOffset, size_t side/* = 0*/)
 {
-    for (auto& voice : m_voices)
-        voice.setPhaseOffset(phaseOffset, channel);
+    size_t numChannels = m_voices.getNumChannels();
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        if (getChannelSide(channel) == side)
+            m_voices.setPhaseOffset(phaseOffset, channel);
+    }
 }
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::setLfoType(WaveType type)
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::setLfoType(WaveType type)
 {
-    for (auto& voice : m_voices)
-        voice.setLfoType(type);
+    m_voices.setLfoType(type);
 }
 
-template<typename SampleType>
-size_t ChorusVoices<SampleType>::getMaxVoices() const
+template<typename SampleType, size_t MaxVoices>
+size_t ChorusVoices<SampleType, MaxVoices>::getMaxVoices() const
 {
-    return m_maxVoices;
+    return MaxVoices;
 }
 
-template<typename SampleType>
-size_t ChorusVoices<SampleType>::getActiveVoices() const
+template<typename SampleType, size_t MaxVoices>
+size_t ChorusVoices<SampleType, MaxVoices>::getActiveVoices() const
 {
     return m_activeVoices;
 }
 
-template<typename SampleType>
-SampleType ChorusVoices<SampleType>::getDelayTime() const
+template<typename SampleType, size_t MaxVoices>
+SampleType ChorusVoices<SampleType, MaxVoices>::getDelayTime() const
 {
     return m_delayTime;
 }
 
 //==============================================================================
 
-template<typename SampleType>
-void ChorusVoices<SampleType>::updateDelayTime()
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::updateDelayTime()
 {
-    SampleType voiceCount = 0;
-
-    for (auto& voice : m_voices)
-    {
-        // spreads the additional voices between the delay time and a minimum time of 5ms
-        // m_delaytime could change while this is updating 
-        // need to calculate the entire offset delay time in one line 
-        // this prevents using two different values of m_delayTime which could result in a delayTime < 0;
-        SampleType voiceOffset = m_delayTime - m_spread * (m_delayTime - SampleType(5e-3)) 
-            * (voiceCount / static_cast<SampleType>(m_maxVoices));
+    updateDelayTime(0, m_activeVoices, false);
+}
 
-        // scales the width down towards 1ms
-        SampleType widthOffset = m_delayWidth * (voiceOffset - SampleType(1e-3));
+template<typename SampleType, size_t MaxVoices>
+void ChorusVoices<SampleType, MaxVoices>::updateDelayTime(size_t firstVoice, size_t lastVoice, bool force)
+{
+    size_t numChannels = m_voices.getNumChannels();
 
-        size_t numChannels = voice.getNumChannels();
+    // m_delaytime could change while this is updating, it's read once for each voice
+    // this prevents using two different values of m_delayTime which could result in a delayTime < 0
+    for (size_t voice = firstVoice; voice < lastVoice; ++voice)
+    {
+        SampleType delayTime = m_delayTime;
 
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
-            if (channel % 2 == 1)
-                voice.setDelayTime(voiceOffset - widthOffset, channel);
-            else
-                voice.setDelayTime(voiceOffset, channel);
+            size_t side = getChannelSide(channel);
+            m_voices.setTapDelayTime(voice, getVoiceDelayTime(voice, m_activeVoices, side, delayTime, m_delayWidth, m_spread), 
+                channel, force);
         }
-
-        ++voiceCount;
     }
 }
 
+template<typename SampleType, size_t MaxVoices>
+SampleType ChorusVoices<SampleType, MaxVoices>::getVoiceDelayTime(size_t voice, size_t numVoices, size_t side, 
+    SampleType delayTime, SampleType delayWidth, SampleType spread)
+{
+    SampleType spreadVoices = static_cast<SampleType>(std::max(numVoices, minSpreadVoices));
+
+    // spreads the additional voices between the delay time and a minimum time of 5ms
+    // voices beyond the spread range are clamped to 5ms
+    SampleType voiceOffset = delayTime - spread * (delayTime - SampleType(5e-3)) 
+        * std::min(SampleType(1), static_cast<SampleType>(voice) / spreadVoices);
+
+    // scales the width down towards 1ms
+    if (side == 1)
+        return voiceOffset - delayWidth * (voiceOffset - SampleType(1e-3));
+
+    return voiceOffset;
+}
+
+template<typename SampleType, size_t MaxVoices>
+size_t ChorusVoices<SampleType, MaxVoices>::getChannelSide(size_t channel) const
+{
+    if (channel < m_channelSides.size())
+        return m_channelSides[channel];
+
+    return channel % 2;
+}
+
 //==============================================================================
 
-template class ChorusVoices<float>;
-template class ChorusVoices<double>;
+// the plugin exposes up to 64 voices per channel
+template class ChorusVoices<float, 64>;
+template class ChorusVoices<double, 64>;
 
 } // dingus
\ No newline at end of file
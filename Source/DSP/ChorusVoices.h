@@ -10,7 +10,7 @@
 
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
 #include <vector>
 #include <cmath>
 #include "ModDelay.h"
@@ -20,26 +20,37 @@ namespace dingus
 
 /**
     This class is used to manage all of the voices used by the chorus engine.
-    Each voice is a modulated delay line (mono) or a pair of modulated delay lines (stereo).
+    Each voice is a tap of a modulated delay line (mono) or a pair of taps (stereo).
+    The max number of voices is a template parameter, default is 64.
+    Every voice reads from the same delay buffer and lfo for each channel, so the delay
+    memory is allocated once up front and each active voice only costs a delay read and a multiply-add.
 */
-template<typename SampleType>
+template<typename SampleType, size_t MaxVoices = 64>
 class ChorusVoices
 {
 public:
-    ChorusVoices();
+    static_assert(MaxVoices > 0, "ChorusVoices needs at least one voice");
 
-    // takes an option to specify the number of voices, default is 4
-    // each voice can be stereo, so 4 voices (stereo) = 8 delay lines
-    ChorusVoices(size_t maxVoices);
+    ChorusVoices();
 
     // prepares each voice for playback
-    void prepare(const juce::dsp::ProcessSpec& spec);
+    // a single input channel with multiple output channels runs one delay buffer
+    // and taps every output channel from it, by default the input matches the output
+    void prepare(const ProcessSpec& spec, size_t numInputChannels = 0);
 
-    // processes a block of samples using a juce ProcessContext
+    // processes a block of samples using a ProcessContext, the voices are added to the output
     template<typename ProcessContext>
     void process(const ProcessContext& context) noexcept
     {
-        jassert(m_activeVoices > 0 && m_activeVoices <= m_maxVoices);
+        process(context, context.getOutputBlock());
+    }
+
+    // processes a block of samples using a ProcessContext, the output is overwritten with dry + the voices
+    // the voices read the input of the context so the dry signal can be different, eg. delayed
+    template<typename ProcessContext>
+    void process(const ProcessContext& context, const AudioBlock<const SampleType>& dryBlock) noexcept
+    {
+        assert(m_activeVoices > 0 && m_activeVoices <= MaxVoices);
 
         size_t currentVoices = m_activeVoices;
         SampleType gainAdjust = SampleType(1) / std::sqrt(static_cast<SampleType>(currentVoices));
@@ -49,32 +60,61 @@ public:
         auto numSamples = outputBlock.getNumSamples();
         auto numChannels = outputBlock.getNumChannels();
 
-        for (size_t voice = 0; voice < m_maxVoices; ++voice)
+        // mono input, the delay line is run once and every output is a tap
+        if (m_numInputChannels == 1 && numChannels > 1)
         {
+            assert(numChannels == m_outputPointers.size());
+
             for (size_t channel = 0; channel < numChannels; ++channel)
             {
-                auto* input = inputBlock.getChannelPointer(channel);
-                auto* output = outputBlock.getChannelPointer(channel);
-
-                for (size_t i = 0; i < numSamples; ++i)
-                {
-                    // still need to process buffers for inactive voices
-                    SampleType outputSample = m_voices[voice].processSample(input[i], channel);
-
-                    if (voice < currentVoices)
-                        output[i] += outputSample * gainAdjust;
-                }
+                m_outputPointers[channel] = outputBlock.getChannelPointer(channel);
+                m_dryPointers[channel] = dryBlock.getChannelPointer(channel);
             }
+
+            m_voices.processSharedTaps(inputBlock.getChannelPointer(0), m_outputPointers.data(), numSamples, 
+                currentVoices, gainAdjust, m_dryPointers.data());
+            return;
         }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            processChannel(context, dryBlock, channel, currentVoices, gainAdjust);
+    }
+
+    // processes only the given channels of a ProcessContext, the voices are added to the output
+    // channels are independent so separate groups of channels can be processed on separate threads
+    // this does not support a mono input feeding multiple outputs
+    template<typename ProcessContext>
+    void processChannels(const ProcessContext& context, const std::vector<size_t>& channels) noexcept
+    {
+        processChannels(context, context.getOutputBlock(), channels);
     }
 
+    // processes only the given channels of a ProcessContext, the output is overwritten with dry + the voices
+    template<typename ProcessContext>
+    void processChannels(const ProcessContext& context, const AudioBlock<const SampleType>& dryBlock, 
+        const std::vector<size_t>& channels) noexcept
+    {
+        assert(m_activeVoices > 0 && m_activeVoices <= MaxVoices);
+        assert(m_numInputChannels != 1 || context.getOutputBlock().getNumChannels() == 1);
+
+        size_t currentVoices = m_activeVoices;
+        SampleType gainAdjust = SampleType(1) / std::sqrt(static_cast<SampleType>(currentVoices));
+
+        for (auto channel : channels)
+            processChannel(context, dryBlock, channel, currentVoices, gainAdjust);
+    }
+
+    // writes the input to the delay lines and advances the lfos without reading any voices
+    // this is used while the voices aren't heard so that they come back without a jump
+    void skip(const AudioBlock<const SampleType>& inputBlock, size_t numChannels) noexcept;
+
     // resets all voices
     void reset();
 
     //==============================================================================
     // set functions
 
-    // sets the delay time and updates delay times for all voices using updateDelayTime()
+    // sets the delay time and updates delay times for all active voices using updateDelayTime()
     void setDelayTime(SampleType delayTime);
 
     // scales the delay time of the right channel down towards 1ms
@@ -91,11 +131,24 @@ public:
     // set the lfo depth using a value from 0-1
     void setDepth(SampleType depth);
 
+    // sets the minimum rate in Hz at which the lfos are evaluated, the delay is interpolated in between
+    // see ModDelay::setControlInterval() for the error, a rate of 0 evaluates the lfos every sample
+    void setLfoControlRate(SampleType controlRate);
+
+    // sets the interpolation used to read the voices from the delay line
+    void setInterpolation(Interpolation interpolation);
+
     // sets the number of voices to output
+    // inactive voices are not processed
     void setActiveVoices(size_t numVoices);
 
-    // offsets the phase of the left lfo
-    void setPhaseOffset(SampleType phaseOffset, size_t channel = 0);
+    // sets which side of a channel pair each channel is on, 0 is left and 1 is right
+    // the right side uses the delay width and the right phase offset
+    // by default even channels are left and odd channels are right
+    void setChannelSides(const std::vector<size_t>& sides);
+
+    // offsets the phase of the lfo for every channel on the given side
+    void setPhaseOffset(SampleType phaseOffset, size_t side = 0);
 
     // sets the wave type of the lfo oscillator
     void setLfoType(WaveType type);
@@ -109,11 +162,28 @@ public:
     // returns the current delay time
     SampleType getDelayTime() const;
 
+    // returns the delay time of a voice on the given side of a channel pair, see setDelayTime(), setDelayWidth() and setVoiceSpread()
+    static SampleType getVoiceDelayTime(size_t voice, size_t numVoices, size_t side, 
+        SampleType delayTime, SampleType delayWidth, SampleType spread);
+
 private:
-    // the actual voices are held in a vector of modulated delay lines
-    std::vector<ModDelay<SampleType>> m_voices;
-    size_t m_maxVoices{ 4 };
+    // the actual voices are the taps of a single modulated delay line
+    ModDelay<SampleType, MaxVoices> m_voices;
     size_t m_activeVoices{ 1 };
+    size_t m_numInputChannels{ 0 };
+
+    double m_sampleRate{ 44100.0 };
+    SampleType m_lfoControlRate{ 0 };
+
+    // the output and dry channels used when a mono input is shared by every channel
+    std::vector<SampleType*> m_outputPointers;
+    std::vector<const SampleType*> m_dryPointers;
+
+    // voices are spread over at least this many voices so that smaller voice counts keep the same spacing
+    static constexpr size_t minSpreadVoices{ 4 };
+
+    // the side of a channel pair for each channel
+    std::vector<size_t> m_channelSides;
 
     // keep track of the minimum delay time
     // delay width scales the minimum time of the right channel
@@ -123,7 +193,27 @@ private:
     SampleType m_spread{ 1 };
 
     // delayTime, delayWidth, and spread all need to update setDelayTime() for each voice
+    // only the active voices are updated, the others are brought up to date when they become active
     void updateDelayTime();
+
+    // updates the delay times of the voices from firstVoice up to lastVoice, force skips the smoothing
+    void updateDelayTime(size_t firstVoice, size_t lastVoice, bool force);
+
+    // returns the side of a channel pair for a given channel
+    size_t getChannelSide(size_t channel) const;
+
+    // processes every active voice for a single channel
+    template<typename ProcessContext>
+    void processChannel(const ProcessContext& context, const AudioBlock<const SampleType>& dryBlock, 
+        size_t channel, size_t currentVoices, SampleType gainAdjust) noexcept
+    {
+        auto* input = context.getInputBlock().getChannelPointer(channel);
+        auto* output = context.getOutputBlock().getChannelPointer(channel);
+        auto* dry = dryBlock.getChannelPointer(channel);
+        auto numSamples = context.getOutputBlock().getNumSamples();
+
+        m_voices.processTaps(input, output, numSamples, channel, currentVoices, gainAdjust, dry);
+    }
 };
 
 //==============================================================================
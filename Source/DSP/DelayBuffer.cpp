@@ -45,7 +45,7 @@ void DelayBuffer<SampleType>::clear()
 template <typename SampleType>
 SampleType DelayBuffer<SampleType>::get(size_t delayInSamples)
 {
-    jassert(delayInSamples >= 0 && delayInSamples < size());
+    assert(delayInSamples < size());
 
     return m_data[(m_position + delayInSamples + 1) % size()];
 }
@@ -53,13 +53,10 @@ SampleType DelayBuffer<SampleType>::get(size_t delayInSamples)
 template <typename SampleType>
 SampleType DelayBuffer<SampleType>::getLinear(SampleType delayTime)
 {
-    SampleType position = static_cast<SampleType>(std::fmod((m_position + delayTime + SampleType(1)), size()));
-
-    size_t index0 = static_cast<size_t>(position);
+    size_t index0{};
+    SampleType frac = getReadPosition(delayTime, index0);
     size_t index1 = (index0 + 1) % size();
 
-    SampleType frac = position - static_cast<SampleType>(index0);
-
     SampleType value0 = m_data[index0];
     SampleType value1 = m_data[index1];
 
@@ -68,6 +65,104 @@ SampleType DelayBuffer<SampleType>::getLinear(SampleType delayTime)
     return output;
 }
 
+template <typename SampleType>
+SampleType DelayBuffer<SampleType>::getHermite(SampleType delayTime)
+{
+    // there is no newer sample to read for delays under 1 sample
+    if (delayTime < SampleType(1))
+        return getLinear(delayTime);
+
+    size_t index{};
+    SampleType frac = getReadPosition(delayTime, index);
+
+    SampleType points[4];
+    getFourPoints(index, points);
+
+    // catmull-rom spline between points[1] and points[2]
+    SampleType c1 = SampleType(5e-1) * (points[2] - points[0]);
+    SampleType c2 = points[0] - SampleType(25e-1) * points[1] + SampleType(2) * points[2] - SampleType(5e-1) * points[3];
+    SampleType c3 = SampleType(5e-1) * (points[3] - points[0]) + SampleType(15e-1) * (points[1] - points[2]);
+
+    return ((c3 * frac + c2) * frac + c1) * frac + points[1];
+}
+
+template <typename SampleType>
+SampleType DelayBuffer<SampleType>::getLagrange(SampleType delayTime)
+{
+    // there is no newer sample to read for delays under 1 sample
+    if (delayTime < SampleType(1))
+        return getLinear(delayTime);
+
+    size_t index{};
+    SampleType frac = getReadPosition(delayTime, index);
+
+    SampleType points[4];
+    getFourPoints(index, points);
+
+    // lagrange polynomial through the points at -1, 0, 1 and 2
+    SampleType fracPlusOne = frac + SampleType(1);
+    SampleType fracMinusOne = frac - SampleType(1);
+    SampleType fracMinusTwo = frac - SampleType(2);
+
+    SampleType h0 = -frac * fracMinusOne * fracMinusTwo / SampleType(6);
+    SampleType h1 = fracPlusOne * fracMinusOne * fracMinusTwo * SampleType(5e-1);
+    SampleType h2 = -fracPlusOne * frac * fracMinusTwo * SampleType(5e-1);
+    SampleType h3 = fracPlusOne * frac * fracMinusOne / SampleType(6);
+
+    return h0 * points[0] + h1 * points[1] + h2 * points[2] + h3 * points[3];
+}
+
+template <typename SampleType>
+SampleType DelayBuffer<SampleType>::getAllpass(SampleType delayTime, SampleType& state)
+{
+    size_t index0{};
+    SampleType frac = getReadPosition(delayTime, index0);
+
+    // keep the allpass delay between 0.618 and 1.618 samples where the coefficient stays small
+    // this needs one newer sample so it only applies to delays of at least 1 sample
+    if (frac < SampleType(0.618) && delayTime >= SampleType(1))
+    {
+        index0 = index0 == 0 ? size() - 1 : index0 - 1;
+        frac += SampleType(1);
+    }
+
+    size_t index1 = (index0 + 1) % size();
+
+    SampleType coefficient = (SampleType(1) - frac) / (SampleType(1) + frac);
+    state = coefficient * (m_data[index0] - state) + m_data[index1];
+
+    return state;
+}
+
+template <typename SampleType>
+SampleType DelayBuffer<SampleType>::getReadPosition(SampleType delayTime, size_t& index)
+{
+    assert(delayTime >= SampleType(0) && delayTime < static_cast<SampleType>(size() - 2));
+
+    // the fraction is taken from the delay alone so it doesn't lose precision as the buffer position grows
+    // and is the same as addDelayedBlock()'s, the delay is less than the buffer size so the index wraps at most once
+    size_t delayInSamples = static_cast<size_t>(delayTime);
+    size_t bufferSize = size();
+
+    index = m_position + delayInSamples + 1;
+
+    if (index >= bufferSize)
+        index -= bufferSize;
+
+    return delayTime - static_cast<SampleType>(delayInSamples);
+}
+
+template <typename SampleType>
+void DelayBuffer<SampleType>::getFourPoints(size_t index, SampleType* points)
+{
+    size_t bufferSize = size();
+
+    points[0] = m_data[index == 0 ? bufferSize - 1 : index - 1];
+    points[1] = m_data[index];
+    points[2] = m_data[(index + 1) % bufferSize];
+    points[3] = m_data[(index + 2) % bufferSize];
+}
+
 template <typename SampleType>
 void DelayBuffer<SampleType>::push(SampleType value)
 {
@@ -79,6 +174,61 @@ void DelayBuffer<SampleType>::push(SampleType value)
         --m_position;
 }
 
+template <typename SampleType>
+void DelayBuffer<SampleType>::pushBlock(const SampleType* values, size_t numSamples)
+{
+    for (size_t i = 0; i < numSamples; ++i)
+        push(values[i]);
+}
+
+template <typename SampleType>
+void DelayBuffer<SampleType>::addDelayedBlock(SampleType* output, size_t numSamples, SampleType delayTime, SampleType gain,
+    const SampleType* dry/* = nullptr*/)
+{
+    if (dry == nullptr)
+        dry = output;
+
+    size_t bufferSize = size();
+    size_t delayInSamples = static_cast<size_t>(delayTime);
+    SampleType frac = delayTime - static_cast<SampleType>(delayInSamples);
+
+    // the whole block has already been pushed so the oldest sample read is numSamples further back
+    assert(delayTime >= SampleType(0) && numSamples + delayInSamples + 1 < bufferSize);
+
+    // the read position moves backwards through the buffer since push() decrements the position
+    size_t index = (m_position + numSamples + delayInSamples + 1) % bufferSize;
+
+    for (size_t i = 0; i < numSamples;)
+    {
+        // the interpolation reads index + 1, which wraps at the end of the buffer
+        if (index == bufferSize - 1)
+        {
+            output[i] = dry[i] + (m_data[index] + frac * (m_data[0] - m_data[index])) * gain;
+            --index;
+            ++i;
+            continue;
+        }
+
+        // contiguous run of samples before the index wraps
+        size_t run = std::min(numSamples - i, index + 1);
+        const SampleType* data = m_data.data() + index;
+
+        if (frac == SampleType(0))
+        {
+            for (size_t j = 0; j < run; ++j)
+                output[i + j] = dry[i + j] + *(data - j) * gain;
+        }
+        else
+        {
+            for (size_t j = 0; j < run; ++j)
+                output[i + j] = dry[i + j] + (*(data - j) + frac * (*(data - j + 1) - *(data - j))) * gain;
+        }
+
+        i += run;
+        index = (index + bufferSize - run) % bufferSize;
+    }
+}
+
 //==============================================================================
 
 template class DelayBuffer<float>;
@@ -10,7 +10,7 @@
 
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
 #include <vector>
 #include <algorithm>
 #include <cmath>
@@ -18,6 +18,19 @@
 namespace dingus 
 {
 
+//==============================================================================
+// the interpolation used for fractional delay reads
+// linear is the cheapest but dulls the highs as the delay moves, hermite and lagrange use 4 points,
+// thiran is a first order allpass which keeps a flat magnitude response but needs a state per read
+enum class Interpolation
+{
+    LINEAR,
+    HERMITE,
+    LAGRANGE,
+    THIRAN,
+    MAX
+};
+
 //==============================================================================
 /**  
     Circular buffer for a delay line, can be used for integer or fractional delays.
@@ -44,12 +57,60 @@ public:
     // takes a fractional delay time (in samples) and returns value using linear interpolation
     SampleType getLinear(SampleType delayTime);
 
+    // takes a fractional delay time (in samples) and returns value using 4 point cubic hermite interpolation
+    // delays under 1 sample fall back to linear interpolation
+    SampleType getHermite(SampleType delayTime);
+
+    // takes a fractional delay time (in samples) and returns value using 4 point, 3rd order lagrange interpolation
+    // delays under 1 sample fall back to linear interpolation
+    SampleType getLagrange(SampleType delayTime);
+
+    // takes a fractional delay time (in samples) and returns value using a first order thiran allpass
+    // state holds the previous output of this read and has to be kept between calls, 0 to start
+    SampleType getAllpass(SampleType delayTime, SampleType& state);
+
+    // returns the value for a fractional delay time using the given interpolation
+    // the state is only used by the thiran allpass
+    template <Interpolation Type>
+    SampleType getInterpolated(SampleType delayTime, SampleType& state)
+    {
+        // the type is known at compile time so this switch is removed
+        switch (Type)
+        {
+        case Interpolation::HERMITE:
+            return getHermite(delayTime);
+        case Interpolation::LAGRANGE:
+            return getLagrange(delayTime);
+        case Interpolation::THIRAN:
+            return getAllpass(delayTime, state);
+        case Interpolation::LINEAR:
+        default:
+            return getLinear(delayTime);
+        }
+    }
+
     // push a new value to the buffer
     void push(SampleType value);
 
+    // pushes a block of values to the buffer
+    void pushBlock(const SampleType* values, size_t numSamples);
+
+    // adds a block read with a fixed fractional delay time (in samples) to the output, scaled by gain
+    // this must be called after pushBlock(), it returns the same values as calling getLinear() before each push
+    // an integer delay time skips the interpolation
+    // if dry is set the output is overwritten with dry + the delayed block instead of being added to
+    void addDelayedBlock(SampleType* output, size_t numSamples, SampleType delayTime, SampleType gain, 
+        const SampleType* dry = nullptr);
+
 private:
     size_t m_position{ 0 };
     std::vector<SampleType> m_data;
+
+    // finds the index of the sample at the integer part of a delay time and returns the fractional part
+    SampleType getReadPosition(SampleType delayTime, size_t& index);
+
+    // reads the four samples around index, from the newest to the oldest
+    void getFourPoints(size_t index, SampleType* points);
 };
 //==============================================================================
 
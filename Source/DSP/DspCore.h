@@ -0,0 +1,437 @@
+/*
+  ==============================================================================
+
+    DspCore.h
+    Created: 20 Oct 2026 1:41:07am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+// the few building blocks the dsp classes need, so that they only depend on the standard library
+// and can be built on their own, eg. for a game engine or a server
+// each one follows the juce class with the same name and does the same arithmetic, so the output
+// doesn't change, except SmoothedValue's linear ramp, see below
+// see JuceAdapters.h for using the dsp classes with juce
+
+namespace dingus
+{
+
+//==============================================================================
+template<typename FloatType>
+struct MathConstants
+{
+    static constexpr FloatType pi = static_cast<FloatType>(3.141592653589793238L);
+    static constexpr FloatType twoPi = static_cast<FloatType>(2 * 3.141592653589793238L);
+    static constexpr FloatType halfPi = static_cast<FloatType>(3.141592653589793238L / 2);
+    static constexpr FloatType sqrt2 = static_cast<FloatType>(1.4142135623730950488L);
+};
+
+template<typename FloatType> constexpr FloatType MathConstants<FloatType>::pi;
+template<typename FloatType> constexpr FloatType MathConstants<FloatType>::twoPi;
+template<typename FloatType> constexpr FloatType MathConstants<FloatType>::halfPi;
+template<typename FloatType> constexpr FloatType MathConstants<FloatType>::sqrt2;
+
+// returns the value limited to the range lower to upper
+template<typename Type>
+Type limit(Type lower, Type upper, Type value)
+{
+    assert(lower <= upper);
+    return value < lower ? lower : (upper < value ? upper : value);
+}
+
+// rounds to the nearest integer, halfway values round to even
+template<typename FloatType>
+int roundToInt(FloatType value)
+{
+    return static_cast<int>(std::lrint(value));
+}
+
+//==============================================================================
+// the sample rate, the largest block and the number of channels that a processor is prepared for
+struct ProcessSpec
+{
+    double sampleRate;
+    std::uint32_t maximumBlockSize;
+    std::uint32_t numChannels;
+};
+
+//==============================================================================
+/**
+    A view of a block of channels, it doesn't own the samples.
+    Use a float or double sample type, a const sample type for a read only block.
+*/
+template<typename SampleType>
+class AudioBlock
+{
+public:
+    AudioBlock() = default;
+
+    AudioBlock(SampleType* const* channels, size_t numChannels, size_t numSamples)
+        : m_channels(channels), m_numChannels(numChannels), m_numSamples(numSamples)
+    {
+    }
+
+    AudioBlock(SampleType* const* channels, size_t numChannels, size_t startSample, size_t numSamples)
+        : m_channels(channels), m_numChannels(numChannels), m_startSample(startSample), m_numSamples(numSamples)
+    {
+    }
+
+    // a read only view of a block
+    template<typename OtherType, typename = std::enable_if_t<std::is_same<const OtherType, SampleType>::value>>
+    AudioBlock(const AudioBlock<OtherType>& other)
+        : m_channels(other.m_channels), m_numChannels(other.m_numChannels),
+        m_startSample(other.m_startSample), m_numSamples(other.m_numSamples)
+    {
+    }
+
+    size_t getNumChannels() const noexcept { return m_numChannels; }
+    size_t getNumSamples() const noexcept { return m_numSamples; }
+
+    SampleType* getChannelPointer(size_t channel) const noexcept
+    {
+        assert(channel < m_numChannels);
+        return m_channels[channel] + m_startSample;
+    }
+
+    // returns a view of numSamples samples of every channel, starting at startSample
+    AudioBlock getSubBlock(size_t startSample, size_t numSamples) const noexcept
+    {
+        assert(startSample + numSamples <= m_numSamples);
+        return AudioBlock(m_channels, m_numChannels, m_startSample + startSample, numSamples);
+    }
+
+private:
+    SampleType* const* m_channels{ nullptr };
+    size_t m_numChannels{ 0 };
+    size_t m_startSample{ 0 };
+    size_t m_numSamples{ 0 };
+
+    template<typename> friend class AudioBlock;
+};
+
+//==============================================================================
+/**
+    Owns the samples of a block, eg. for the temporary buffers of a processor.
+*/
+template<typename SampleType>
+class AudioBlockStorage
+{
+public:
+    // allocates cleared channels and returns a block that covers them
+    // each channel starts on a 16 byte boundary, the block is valid until the next allocate()
+    AudioBlock<SampleType> allocate(size_t numChannels, size_t numSamples)
+    {
+        const size_t alignment = 16 / sizeof(SampleType);
+        size_t channelSize = (numSamples + alignment - 1) / alignment * alignment;
+
+        m_samples.assign(numChannels * channelSize + alignment, SampleType(0));
+        m_channels.resize(numChannels);
+
+        auto* start = m_samples.data();
+
+        while (reinterpret_cast<std::uintptr_t>(start) % 16 != 0)
+            ++start;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            m_channels[channel] = start + channel * channelSize;
+
+        return AudioBlock<SampleType>(m_channels.data(), numChannels, numSamples);
+    }
+
+private:
+    std::vector<SampleType> m_samples;
+    std::vector<SampleType*> m_channels;
+};
+
+//==============================================================================
+// a block that is processed in place
+template<typename SampleType>
+struct ProcessContextReplacing
+{
+public:
+    using AudioBlockType = AudioBlock<SampleType>;
+    using ConstAudioBlockType = AudioBlock<const SampleType>;
+
+    ProcessContextReplacing(AudioBlockType& block) noexcept : m_block(block), m_constBlock(block) {}
+
+    const ConstAudioBlockType& getInputBlock() const noexcept { return m_constBlock; }
+    AudioBlockType& getOutputBlock() const noexcept { return m_block; }
+
+    static constexpr bool usesSeparateInputAndOutputBlocks() { return false; }
+
+    // the processor leaves the block as it is, or copies it to the output
+    bool isBypassed{ false };
+
+private:
+    AudioBlockType& m_block;
+    ConstAudioBlockType m_constBlock;
+};
+
+// a block that is read from the input and written to the output
+template<typename SampleType>
+struct ProcessContextNonReplacing
+{
+public:
+    using AudioBlockType = AudioBlock<SampleType>;
+    using ConstAudioBlockType = AudioBlock<const SampleType>;
+
+    ProcessContextNonReplacing(const ConstAudioBlockType& input, AudioBlockType& output) noexcept
+        : m_input(input), m_output(output)
+    {
+        assert(input.getNumSamples() == output.getNumSamples());
+    }
+
+    const ConstAudioBlockType& getInputBlock() const noexcept { return m_input; }
+    AudioBlockType& getOutputBlock() const noexcept { return m_output; }
+
+    static constexpr bool usesSeparateInputAndOutputBlocks() { return true; }
+
+    // the processor leaves the block as it is, or copies it to the output
+    bool isBypassed{ false };
+
+private:
+    const ConstAudioBlockType& m_input;
+    AudioBlockType& m_output;
+};
+
+//==============================================================================
+namespace ValueSmoothingTypes
+{
+    // the value moves by the same amount each sample
+    struct Linear {};
+
+    // the value moves by the same ratio each sample, eg. for frequencies, the values can't be 0
+    struct Multiplicative {};
+}
+
+/**
+    A value that ramps to its target over a number of samples.
+    A linear ramp is worked out from the target and the samples left rather than summing the steps like juce,
+    so skip() lands on exactly the value that calling getNextValue() the same number of times would.
+*/
+template<typename FloatType, typename SmoothingType = ValueSmoothingTypes::Linear>
+class SmoothedValue
+{
+public:
+    SmoothedValue() : SmoothedValue(static_cast<FloatType>(isMultiplicative ? 1 : 0)) {}
+
+    SmoothedValue(FloatType initialValue) : m_currentValue(initialValue), m_target(initialValue)
+    {
+        assert(!(isMultiplicative && initialValue == FloatType(0)));
+    }
+
+    // sets the length of the ramp and stops any ramp in progress
+    void reset(double sampleRate, double rampLengthInSeconds) noexcept
+    {
+        assert(sampleRate > 0.0 && rampLengthInSeconds >= 0.0);
+        reset(static_cast<int>(std::floor(rampLengthInSeconds * sampleRate)));
+    }
+
+    void reset(int numSteps) noexcept
+    {
+        m_stepsToTarget = numSteps;
+        setCurrentAndTargetValue(m_target);
+    }
+
+    // jumps to a value without a ramp
+    void setCurrentAndTargetValue(FloatType newValue) noexcept
+    {
+        m_target = m_currentValue = newValue;
+        m_countdown = 0;
+    }
+
+    // starts a ramp from the current value to a new target
+    void setTargetValue(FloatType newValue) noexcept
+    {
+        if (newValue == m_target)
+            return;
+
+        if (m_stepsToTarget <= 0)
+        {
+            setCurrentAndTargetValue(newValue);
+            return;
+        }
+
+        assert(!(isMultiplicative && newValue == FloatType(0)));
+
+        m_target = newValue;
+        m_countdown = m_stepsToTarget;
+        setStepSize();
+    }
+
+    // moves one sample along the ramp and returns the new value
+    FloatType getNextValue() noexcept
+    {
+        if (!isSmoothing())
+            return m_target;
+
+        --m_countdown;
+
+        if (isSmoothing())
+            setNextValue();
+        else
+            m_currentValue = m_target;
+
+        return m_currentValue;
+    }
+
+    // moves numSamples samples along the ramp and returns the new value
+    FloatType skip(int numSamples) noexcept
+    {
+        if (numSamples >= m_countdown)
+        {
+            setCurrentAndTargetValue(m_target);
+            return m_target;
+        }
+
+        m_countdown -= numSamples;
+        skipCurrentValue(numSamples);
+        return m_currentValue;
+    }
+
+    bool isSmoothing() const noexcept { return m_countdown > 0; }
+    FloatType getCurrentValue() const noexcept { return m_currentValue; }
+    FloatType getTargetValue() const noexcept { return m_target; }
+
+private:
+    static constexpr bool isMultiplicative = std::is_same<SmoothingType, ValueSmoothingTypes::Multiplicative>::value;
+
+    FloatType m_currentValue{};
+    FloatType m_target{};
+    FloatType m_step{};
+    int m_countdown{ 0 };
+    int m_stepsToTarget{ 0 };
+
+    // the step is an amount for a linear ramp and a ratio for a multiplicative ramp
+    void setStepSize() noexcept
+    {
+        if (isMultiplicative)
+            m_step = std::exp((std::log(std::abs(m_target)) - std::log(std::abs(m_currentValue))) / static_cast<FloatType>(m_countdown));
+        else
+            m_step = (m_target - m_currentValue) / static_cast<FloatType>(m_countdown);
+    }
+
+    void setNextValue() noexcept
+    {
+        if (isMultiplicative)
+            m_currentValue *= m_step;
+        else
+            m_currentValue = m_target - m_step * static_cast<FloatType>(m_countdown);
+    }
+
+    void skipCurrentValue(int numSamples) noexcept
+    {
+        if (isMultiplicative)
+            m_currentValue *= static_cast<FloatType>(std::pow(m_step, numSamples));
+        else
+            m_currentValue = m_target - m_step * static_cast<FloatType>(m_countdown);
+    }
+};
+
+template<typename FloatType, typename SmoothingType>
+constexpr bool SmoothedValue<FloatType, SmoothingType>::isMultiplicative;
+
+//==============================================================================
+/**
+    The coefficients of a second order filter, normalised by a0.
+*/
+template<typename SampleType>
+struct BiquadCoefficients
+{
+    // b0, b1, b2, a1, a2, the default passes the input through
+    SampleType values[5]{ SampleType(1), SampleType(0), SampleType(0), SampleType(0), SampleType(0) };
+
+    BiquadCoefficients() = default;
+
+    BiquadCoefficients(SampleType b0, SampleType b1, SampleType b2, SampleType a0, SampleType a1, SampleType a2)
+    {
+        SampleType a0Inverse = a0 != SampleType(0) ? SampleType(1) / a0 : SampleType(0);
+
+        values[0] = b0 * a0Inverse;
+        values[1] = b1 * a0Inverse;
+        values[2] = b2 * a0Inverse;
+        values[3] = a1 * a0Inverse;
+        values[4] = a2 * a0Inverse;
+    }
+
+    // a low shelf with the given cutoff in Hz, q and gain factor
+    static BiquadCoefficients makeLowShelf(double sampleRate, SampleType cutoff, SampleType q, SampleType gainFactor)
+    {
+        assert(sampleRate > 0.0 && cutoff > SampleType(0) && cutoff <= static_cast<SampleType>(sampleRate * 0.5) && q > SampleType(0));
+
+        const auto A = std::sqrt(gainFactor < SampleType(0) ? SampleType(0) : gainFactor);
+        const auto aMinus1 = A - 1;
+        const auto aPlus1 = A + 1;
+        const auto omega = (2 * MathConstants<SampleType>::pi * (cutoff < SampleType(2) ? SampleType(2) : cutoff)) / static_cast<SampleType>(sampleRate);
+        const auto cosOmega = std::cos(omega);
+        const auto beta = std::sin(omega) * std::sqrt(A) / q;
+        const auto aMinus1TimesCos = aMinus1 * cosOmega;
+
+        return BiquadCoefficients(A * (aPlus1 - aMinus1TimesCos + beta),
+            A * 2 * (aMinus1 - aPlus1 * cosOmega),
+            A * (aPlus1 - aMinus1TimesCos - beta),
+            aPlus1 + aMinus1TimesCos + beta,
+            -2 * (aMinus1 + aPlus1 * cosOmega),
+            aPlus1 + aMinus1TimesCos - beta);
+    }
+};
+
+/**
+    A second order filter in transposed direct form II, for a single channel.
+*/
+template<typename SampleType>
+class BiquadFilter
+{
+public:
+    BiquadCoefficients<SampleType> coefficients;
+
+    // clears the filter state
+    void reset() noexcept
+    {
+        m_state1 = m_state2 = SampleType(0);
+    }
+
+    SampleType processSample(SampleType input) noexcept
+    {
+        auto* c = coefficients.values;
+
+        SampleType output = (c[0] * input) + m_state1;
+        m_state1 = (c[1] * input) - (c[3] * output) + m_state2;
+        m_state2 = (c[2] * input) - (c[4] * output);
+
+        return output;
+    }
+
+private:
+    SampleType m_state1{ 0 };
+    SampleType m_state2{ 0 };
+};
+
+//==============================================================================
+/**
+    Runs tasks on other threads, eg. on the thread pool of a host.
+    See ChorusEngine::setTaskRunner().
+*/
+class TaskRunner
+{
+public:
+    virtual ~TaskRunner() = default;
+
+    // starts a task on another thread, this may allocate
+    virtual void run(std::function<void()> task) = 0;
+};
+
+//==============================================================================
+} // dingus
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    EnvelopeFollower.cpp
+    Created: 19 Oct 2026 8:21:47pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "EnvelopeFollower.h"
+
+namespace dingus
+{
+
+//==============================================================================
+EnvelopeFollower::EnvelopeFollower()
+{
+}
+
+void EnvelopeFollower::prepare(double sampleRate, size_t controlInterval)
+{
+    jassert(controlInterval > 0);
+    m_sampleRate = sampleRate;
+    m_controlInterval = controlInterval;
+
+    setAttack(m_attack);
+    setRelease(m_release);
+    reset();
+}
+
+void EnvelopeFollower::reset()
+{
+    m_envelope = 0.0f;
+    m_peak = 0.0f;
+    m_sum = 0.0;
+    m_numSteps = 0;
+}
+
+float EnvelopeFollower::updateEnvelope(bool isPeak) noexcept
+{
+    float level = 0.0f;
+
+    if (isPeak)
+        level = m_peak;
+    else if (m_numSteps > 0)
+        level = static_cast<float>(std::sqrt(m_sum / static_cast<double>(m_numSteps)));
+
+    m_peak = 0.0f;
+    m_sum = 0.0;
+    m_numSteps = 0;
+
+    float coefficient = level > m_envelope ? m_attackCoefficient : m_releaseCoefficient;
+    m_envelope = level + coefficient * (m_envelope - level);
+    return juce::jmin(1.0f, m_envelope);
+}
+
+//==============================================================================
+
+float EnvelopeFollower::getCoefficient(float time) const
+{
+    // the time it takes to get within 1/e of the level
+    double controlRate = m_sampleRate / static_cast<double>(m_controlInterval);
+    double numPoints = static_cast<double>(time) * 1e-3 * controlRate;
+
+    if (numPoints <= 0.0)
+        return 0.0f;
+
+    return static_cast<float>(std::exp(-1.0 / numPoints));
+}
+
+void EnvelopeFollower::setAttack(float attack)
+{
+    jassert(attack >= 0.0f);
+    m_attack = attack;
+    m_attackCoefficient = getCoefficient(attack);
+}
+
+void EnvelopeFollower::setRelease(float release)
+{
+    jassert(release >= 0.0f);
+    m_release = release;
+    m_releaseCoefficient = getCoefficient(release);
+}
+
+void EnvelopeFollower::setType(EnvelopeType type)
+{
+    m_type = type;
+}
+
+//==============================================================================
+} // dingus
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    EnvelopeFollower.h
+    Created: 19 Oct 2026 8:21:47pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+
+namespace dingus
+{
+
+// selects how the level of the input is detected
+enum class EnvelopeType
+{
+    PEAK,
+    RMS
+};
+
+//==============================================================================
+/**
+    This is a decimated envelope follower to be used as a modulation source.
+    The level of the input is detected once per control interval over all channels, 
+    either the peak or the rms, and then smoothed with separate attack and release times.
+    The output is one value from 0-1 per control interval, so the smoothing only costs 
+    a few operations per interval and the detection is a single pass over the block.
+*/
+class EnvelopeFollower
+{
+public:
+    EnvelopeFollower();
+
+    // prepares the follower to output a value every controlInterval samples
+    void prepare(double sampleRate, size_t controlInterval);
+
+    // resets the envelope to 0
+    void reset();
+
+    // detects the level of the control interval that ends at each control point of the block
+    // and writes the envelope at that point to the output
+    // the points are every control interval from firstPoint, the intervals carry on across blocks
+    // so a block can end in the middle of one, or have no points at all
+    template<typename SampleType>
+    void process(const juce::dsp::AudioBlock<const SampleType>& block, float* output, size_t firstPoint, size_t numPoints) noexcept
+    {
+        auto numSamples = block.getNumSamples();
+        auto numChannels = block.getNumChannels();
+        bool isPeak = m_type == EnvelopeType::PEAK;
+        size_t startSample = 0;
+
+        // the samples after the last point are held for the next block
+        for (size_t point = 0; point <= numPoints; ++point)
+        {
+            size_t endSample = point < numPoints ? firstPoint + point * m_controlInterval : numSamples;
+            size_t numSteps = endSample - startSample;
+
+            if (numSteps > 0 && isPeak)
+            {
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(channel) + startSample, 
+                        static_cast<int>(numSteps));
+                    m_peak = juce::jmax(m_peak, static_cast<float>(juce::jmax(-range.getStart(), range.getEnd())));
+                }
+            }
+            else if (numSteps > 0)
+            {
+                SampleType sum{ 0 };
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    auto* input = block.getChannelPointer(channel) + startSample;
+
+                    for (size_t i = 0; i < numSteps; ++i)
+                        sum += input[i] * input[i];
+                }
+
+                m_sum += static_cast<double>(sum);
+            }
+
+            m_numSteps += numSteps * numChannels;
+            startSample = endSample;
+
+            if (point < numPoints)
+                output[point] = updateEnvelope(isPeak);
+        }
+    }
+
+    // sets the attack time in ms
+    void setAttack(float attack);
+
+    // sets the release time in ms
+    void setRelease(float release);
+
+    // sets how the level is detected
+    void setType(EnvelopeType type);
+
+private:
+    double m_sampleRate{ 44100.0 };
+    size_t m_controlInterval{ 1 };
+
+    float m_envelope{ 0.0f };
+
+    // the level detected so far in the current control interval
+    float m_peak{ 0.0f };
+    double m_sum{ 0.0 };
+    size_t m_numSteps{ 0 };
+
+    // moves the envelope towards the level of the control interval that just ended and starts the next one
+    float updateEnvelope(bool isPeak) noexcept;
+    float m_attack{ 10.0f };
+    float m_release{ 150.0f };
+    std::atomic<float> m_attackCoefficient{ 0.0f };
+    std::atomic<float> m_releaseCoefficient{ 0.0f };
+    std::atomic<EnvelopeType> m_type{ EnvelopeType::RMS };
+
+    // returns the one pole coefficient for a time in ms at the control rate
+    float getCoefficient(float time) const;
+};
+
+//==============================================================================
+} // dingus
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    JuceAdapters.h
+    Created: 20 Oct 2026 2:18:44am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "DspCore.h"
+#include "ChorusEngine.h"
+
+//==============================================================================
+// thin wrappers for using the dsp classes with juce, eg. in a juce::dsp::ProcessorChain
+// the dsp classes themselves don't depend on juce, see DspCore.h
+
+namespace dingus
+{
+
+// converts a juce ProcessSpec
+inline ProcessSpec toProcessSpec(const juce::dsp::ProcessSpec& spec)
+{
+    return { spec.sampleRate, spec.maximumBlockSize, spec.numChannels };
+}
+
+//==============================================================================
+/**
+    Runs the tasks of a dsp class on a juce ThreadPool.
+*/
+class JuceTaskRunner : public TaskRunner
+{
+public:
+    JuceTaskRunner(juce::ThreadPool& threadPool) : m_threadPool(threadPool) {}
+
+    void run(std::function<void()> task) override
+    {
+        m_threadPool.addJob(std::move(task));
+    }
+
+private:
+    juce::ThreadPool& m_threadPool;
+};
+
+//==============================================================================
+/**
+    Holds the channel pointers of a juce AudioBlock so it can be viewed as an AudioBlock without allocating.
+    Use a const sample type for the input of a context.
+*/
+template<typename SampleType>
+class JuceBlockView
+{
+public:
+    // sets the max number of channels, this allocates
+    void prepare(size_t maxChannels)
+    {
+        m_channels.resize(maxChannels);
+    }
+
+    // returns a view of the juce block, it's valid until the next call
+    AudioBlock<SampleType> view(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        auto numChannels = block.getNumChannels();
+        assert(numChannels <= m_channels.size());
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            m_channels[channel] = block.getChannelPointer(channel);
+
+        return AudioBlock<SampleType>(m_channels.data(), numChannels, block.getNumSamples());
+    }
+
+private:
+    std::vector<SampleType*> m_channels;
+};
+
+//==============================================================================
+/**
+    A ChorusEngine that is prepared and processed with juce types, so it can go in a juce ProcessorChain.
+    The output is the same as the ChorusEngine.
+*/
+template<typename SampleType>
+class JuceChorusEngine : public ChorusEngine<SampleType>
+{
+public:
+    // prepares the chorus engine for playback
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        m_inputView.prepare(spec.numChannels);
+        m_outputView.prepare(spec.numChannels);
+        ChorusEngine<SampleType>::prepare(toProcessSpec(spec));
+    }
+
+    // processes a block of samples using a juce ProcessContext
+    template<typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto outputBlock = m_outputView.view(context.getOutputBlock());
+
+        if (context.usesSeparateInputAndOutputBlocks())
+        {
+            auto inputBlock = m_inputView.view(context.getInputBlock());
+            ProcessContextNonReplacing<SampleType> engineContext(inputBlock, outputBlock);
+            engineContext.isBypassed = context.isBypassed;
+            ChorusEngine<SampleType>::process(engineContext);
+        }
+        else
+        {
+            ProcessContextReplacing<SampleType> engineContext(outputBlock);
+            engineContext.isBypassed = context.isBypassed;
+            ChorusEngine<SampleType>::process(engineContext);
+        }
+    }
+
+    // sets a thread pool that can be used to process independent channel groups in parallel
+    // see ChorusEngine::setTaskRunner()
+    void setThreadPool(juce::ThreadPool* threadPool)
+    {
+        m_taskRunner.reset(threadPool != nullptr ? new JuceTaskRunner(*threadPool) : nullptr);
+        ChorusEngine<SampleType>::setTaskRunner(m_taskRunner.get());
+    }
+
+private:
+    JuceBlockView<const SampleType> m_inputView;
+    JuceBlockView<SampleType> m_outputView;
+    std::unique_ptr<JuceTaskRunner> m_taskRunner;
+};
+
+//==============================================================================
+} // dingus
@@ -15,21 +15,30 @@ namespace dingus
 
 //==============================================================================
 
-template <typename SampleType>
-ModDelay<SampleType>::ModDelay()
+template <typename SampleType, size_t NumTaps>
+ModDelay<SampleType, NumTaps>::ModDelay()
 {
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::prepare(const ProcessSpec& spec, size_t numInputChannels/* = 0*/)
 {
-    jassert(spec.numChannels > 0);
+    assert(spec.numChannels > 0);
+
+    // only a single shared buffer or one buffer per channel is supported
+    assert(numInputChannels == 0 || numInputChannels == 1 || numInputChannels == spec.numChannels);
+    m_sharedBuffer = numInputChannels == 1 && spec.numChannels > 1;
 
     // need to resize to number of channels
-    m_delayBuffers.resize(spec.numChannels);
+    m_delayBuffers.resize(m_sharedBuffer ? 1 : spec.numChannels);
     m_delayTimes.resize(spec.numChannels);
     m_lfos.resize(spec.numChannels);
     m_lfoDepth.resize(spec.numChannels);
+    m_lfoValues.assign(spec.numChannels, std::numeric_limits<SampleType>::quiet_NaN());
+    m_nextLfoValues.resize(spec.numChannels);
+    m_tapSums.assign(spec.maximumBlockSize, SampleType(0));
+    m_allpassStates.resize(spec.numChannels);
+    clearAllpassStates();
 
     m_sampleRate = static_cast<SampleType>(spec.sampleRate);
     updateDelayBufferSize();
@@ -44,118 +53,535 @@ void ModDelay<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
     for (auto& lfoDepth : m_lfoDepth)
         lfoDepth.reset(spec.sampleRate, 0.2);
 
-    for (auto& delayTime : m_delayTimes)
-        delayTime.reset(spec.sampleRate, 0.5);
+    for (auto& channelDelayTimes : m_delayTimes)
+        for (auto& delayTime : channelDelayTimes)
+            delayTime.reset(spec.sampleRate, 0.5);
+}
+
+template <typename SampleType, size_t NumTaps>
+SampleType ModDelay<SampleType, NumTaps>::processSample(SampleType input, size_t channel)
+{
+    // a shared buffer has to be pushed once per sample using processTap() and pushSample()
+    assert(!m_sharedBuffer);
+
+    SampleType delayedSample = processTap(channel);
+    pushSample(input, channel);
+
+    SampleType outputSample = input * (1 - m_wetLevel) + delayedSample * m_wetLevel;
+    return outputSample;
 }
 
-template <typename SampleType>
-SampleType ModDelay<SampleType>::processSample(SampleType input, size_t channel)
+template <typename SampleType, size_t NumTaps>
+SampleType ModDelay<SampleType, NumTaps>::processTap(size_t channel)
 {
     // calculates lfo multiplied by depth for the delay offset in secs
     // transforms lfo value from range(-1, 1) to range(0, 1)
     SampleType lfoValue = (m_lfos[channel].processSample() + SampleType(2)) * SampleType(5e-1) * m_lfoDepth[channel].getNextValue();
 
-    SampleType delayTime = (m_delayTimes[channel].getNextValue() + lfoValue) * m_sampleRate;
-    SampleType delayedSample = m_delayBuffers[channel].getLinear(delayTime);
+    SampleType delayTime = (m_delayTimes[channel][0].getNextValue() + lfoValue) * m_sampleRate;
+    return m_delayBuffers[m_sharedBuffer ? 0 : channel].getLinear(delayTime);
+}
 
-    m_delayBuffers[channel].push(input);
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::processTaps(const SampleType* input, SampleType* output, size_t numSamples,
+    size_t channel, size_t numTaps, SampleType gain, const SampleType* dry/* = nullptr*/) noexcept
+{
+    assert(!m_sharedBuffer && numTaps <= NumTaps);
 
-    SampleType outputSample = input * (1 - m_wetLevel) + delayedSample * m_wetLevel;
-    return outputSample;
+    // without a dry signal the taps are added to the output
+    if (dry == nullptr)
+        dry = output;
+
+    auto& delayBuffer = m_delayBuffers[channel];
+
+    // the delay won't move so each tap is a constant delay
+    SampleType staticLfoValue{};
+
+    if (m_interpolation == Interpolation::LINEAR && isStaticDelay(channel, numTaps, numSamples, staticLfoValue))
+    {
+        delayBuffer.pushBlock(input, numSamples);
+        processStaticTaps(output, dry, numSamples, channel, channel, numTaps, gain, staticLfoValue);
+        return;
+    }
+
+    switch (m_interpolation)
+    {
+    case Interpolation::HERMITE:
+        processModulatedTaps<Interpolation::HERMITE>(input, output, numSamples, channel, numTaps, gain, dry);
+        break;
+    case Interpolation::LAGRANGE:
+        processModulatedTaps<Interpolation::LAGRANGE>(input, output, numSamples, channel, numTaps, gain, dry);
+        break;
+    case Interpolation::THIRAN:
+        processModulatedTaps<Interpolation::THIRAN>(input, output, numSamples, channel, numTaps, gain, dry);
+        break;
+    case Interpolation::LINEAR:
+    default:
+        processModulatedTaps<Interpolation::LINEAR>(input, output, numSamples, channel, numTaps, gain, dry);
+        break;
+    }
+}
+
+template <typename SampleType, size_t NumTaps>
+template <Interpolation Type>
+void ModDelay<SampleType, NumTaps>::processModulatedTaps(const SampleType* input, SampleType* output, size_t numSamples,
+    size_t channel, size_t numTaps, SampleType gain, const SampleType* dry) noexcept
+{
+    auto& delayBuffer = m_delayBuffers[channel];
+    auto& delayTimes = m_delayTimes[channel];
+    auto& allpassStates = m_allpassStates[channel];
+    auto& lfo = m_lfos[channel];
+    auto& lfoDepth = m_lfoDepth[channel];
+
+    if (m_controlInterval > 1)
+    {
+        // the lfo is evaluated at the end of each control period and interpolated in between
+        SampleType lfoValue = getLfoValue(channel);
+
+        for (size_t i = 0; i < numSamples;)
+        {
+            size_t numSteps = std::min(m_controlInterval, numSamples - i);
+            SampleType nextLfoValue = advanceLfo(channel, numSteps);
+            SampleType lfoIncrement = (nextLfoValue - lfoValue) / static_cast<SampleType>(numSteps);
+
+            for (size_t step = 0; step < numSteps; ++step, ++i)
+            {
+                SampleType interpolatedLfoValue = lfoValue + lfoIncrement * static_cast<SampleType>(step);
+                SampleType tapSum = 0;
+
+                for (size_t tap = 0; tap < numTaps; ++tap)
+                    tapSum += delayBuffer.template getInterpolated<Type>(
+                        (delayTimes[tap].getNextValue() + interpolatedLfoValue) * m_sampleRate, allpassStates[tap]);
+
+                output[i] = dry[i] + tapSum * gain;
+                delayBuffer.push(input[i]);
+            }
+
+            lfoValue = nextLfoValue;
+        }
+
+        m_lfoValues[channel] = lfoValue;
+    }
+    else
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            SampleType lfoValue = (lfo.processSample() + SampleType(2)) * SampleType(5e-1) * lfoDepth.getNextValue();
+            SampleType tapSum = 0;
+
+            for (size_t tap = 0; tap < numTaps; ++tap)
+                tapSum += delayBuffer.template getInterpolated<Type>(
+                    (delayTimes[tap].getNextValue() + lfoValue) * m_sampleRate, allpassStates[tap]);
+
+            output[i] = dry[i] + tapSum * gain;
+            delayBuffer.push(input[i]);
+        }
+    }
+
+    // inactive taps still need to move towards their target so they don't glide when they become active
+    for (size_t tap = numTaps; tap < NumTaps; ++tap)
+        delayTimes[tap].skip(static_cast<int>(numSamples));
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::processSharedTaps(const SampleType* input, SampleType* const* outputs, size_t numSamples,
+    size_t numTaps, SampleType gain, const SampleType* const* drys/* = nullptr*/) noexcept
+{
+    assert(numTaps <= NumTaps);
+
+    // without a dry signal the taps are added to the outputs
+    if (drys == nullptr)
+        drys = outputs;
+
+    auto& delayBuffer = m_delayBuffers[0];
+    size_t numChannels = getNumChannels();
+
+    // the constant delay kernel can only be used if every channel has a static delay
+    bool isStatic = m_interpolation == Interpolation::LINEAR;
+
+    for (size_t channel = 0; channel < numChannels && isStatic; ++channel)
+    {
+        SampleType staticLfoValue{};
+        isStatic = isStaticDelay(channel, numTaps, numSamples, staticLfoValue);
+    }
+
+    if (isStatic)
+    {
+        delayBuffer.pushBlock(input, numSamples);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            SampleType staticLfoValue{};
+            isStaticDelay(channel, numTaps, numSamples, staticLfoValue);
+            processStaticTaps(outputs[channel], drys[channel], numSamples, channel, 0, numTaps, gain, staticLfoValue);
+        }
+
+        return;
+    }
+
+    switch (m_interpolation)
+    {
+    case Interpolation::HERMITE:
+        processModulatedSharedTaps<Interpolation::HERMITE>(input, outputs, numSamples, numTaps, gain, drys);
+        break;
+    case Interpolation::LAGRANGE:
+        processModulatedSharedTaps<Interpolation::LAGRANGE>(input, outputs, numSamples, numTaps, gain, drys);
+        break;
+    case Interpolation::THIRAN:
+        processModulatedSharedTaps<Interpolation::THIRAN>(input, outputs, numSamples, numTaps, gain, drys);
+        break;
+    case Interpolation::LINEAR:
+    default:
+        processModulatedSharedTaps<Interpolation::LINEAR>(input, outputs, numSamples, numTaps, gain, drys);
+        break;
+    }
+}
+
+template <typename SampleType, size_t NumTaps>
+template <Interpolation Type>
+void ModDelay<SampleType, NumTaps>::processModulatedSharedTaps(const SampleType* input, SampleType* const* outputs, size_t numSamples,
+    size_t numTaps, SampleType gain, const SampleType* const* drys) noexcept
+{
+    auto& delayBuffer = m_delayBuffers[0];
+    size_t numChannels = getNumChannels();
+
+    if (m_controlInterval > 1)
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            getLfoValue(channel);
+
+        for (size_t i = 0; i < numSamples;)
+        {
+            size_t numSteps = std::min(m_controlInterval, numSamples - i);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                m_nextLfoValues[channel] = advanceLfo(channel, numSteps);
+
+            for (size_t step = 0; step < numSteps; ++step, ++i)
+            {
+                SampleType position = static_cast<SampleType>(step) / static_cast<SampleType>(numSteps);
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    auto& delayTimes = m_delayTimes[channel];
+                    auto& allpassStates = m_allpassStates[channel];
+                    SampleType lfoValue = m_lfoValues[channel] + (m_nextLfoValues[channel] - m_lfoValues[channel]) * position;
+                    SampleType tapSum = 0;
+
+                    for (size_t tap = 0; tap < numTaps; ++tap)
+                        tapSum += delayBuffer.template getInterpolated<Type>(
+                            (delayTimes[tap].getNextValue() + lfoValue) * m_sampleRate, allpassStates[tap]);
+
+                    outputs[channel][i] = drys[channel][i] + tapSum * gain;
+                }
+
+                delayBuffer.push(input[i]);
+            }
+
+            std::copy(m_nextLfoValues.begin(), m_nextLfoValues.end(), m_lfoValues.begin());
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto& delayTimes = m_delayTimes[channel];
+                auto& allpassStates = m_allpassStates[channel];
+                SampleType lfoValue = (m_lfos[channel].processSample() + SampleType(2)) * SampleType(5e-1) * m_lfoDepth[channel].getNextValue();
+                SampleType tapSum = 0;
+
+                for (size_t tap = 0; tap < numTaps; ++tap)
+                    tapSum += delayBuffer.template getInterpolated<Type>(
+                        (delayTimes[tap].getNextValue() + lfoValue) * m_sampleRate, allpassStates[tap]);
+
+                outputs[channel][i] = drys[channel][i] + tapSum * gain;
+            }
+
+            delayBuffer.push(input[i]);
+        }
+    }
+
+    for (auto& delayTimes : m_delayTimes)
+        for (size_t tap = numTaps; tap < NumTaps; ++tap)
+            delayTimes[tap].skip(static_cast<int>(numSamples));
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::pushSample(SampleType input, size_t inputChannel/* = 0*/)
+{
+    m_delayBuffers[inputChannel].push(input);
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::reset()
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::pushBlock(const SampleType* input, size_t numSamples, size_t inputChannel/* = 0*/) noexcept
+{
+    m_delayBuffers[inputChannel].pushBlock(input, numSamples);
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::skip(size_t numSamples, size_t channel) noexcept
+{
+    if (numSamples == 0)
+        return;
+
+    // at control rate the lfo offset is kept for the current sample, see processModulatedTaps()
+    if (m_controlInterval > 1)
+    {
+        getLfoValue(channel);
+        m_lfoValues[channel] = advanceLfo(channel, numSamples);
+    }
+    else
+    {
+        m_lfos[channel].skip(numSamples);
+        m_lfoDepth[channel].skip(static_cast<int>(numSamples));
+    }
+
+    for (auto& delayTime : m_delayTimes[channel])
+        delayTime.skip(static_cast<int>(numSamples));
+
+    m_allpassStates[channel].fill(SampleType(0));
+}
+
+template <typename SampleType, size_t NumTaps>
+bool ModDelay<SampleType, NumTaps>::isStaticDelay(size_t channel, size_t numTaps, size_t numSamples, SampleType& lfoValue)
+{
+    auto& lfo = m_lfos[channel];
+    auto& lfoDepth = m_lfoDepth[channel];
+
+    if (lfoDepth.isSmoothing())
+        return false;
+
+    SampleType depth = lfoDepth.getTargetValue();
+
+    if (depth != SampleType(0) && !lfo.isStatic())
+        return false;
+
+    auto& delayTimes = m_delayTimes[channel];
+    SampleType maxDelayTime{};
+
+    for (size_t tap = 0; tap < numTaps; ++tap)
+    {
+        if (delayTimes[tap].isSmoothing())
+            return false;
+
+        maxDelayTime = std::max(maxDelayTime, delayTimes[tap].getTargetValue());
+    }
+
+    // a static lfo holds the same value, processSample() won't move it
+    lfoValue = depth == SampleType(0) ? SampleType(0) 
+        : (lfo.processSample() + SampleType(2)) * SampleType(5e-1) * depth;
+
+    // the whole block has to fit in the buffer along with the delay
+    size_t bufferSize = m_delayBuffers[m_sharedBuffer ? 0 : channel].size();
+    return static_cast<size_t>((maxDelayTime + lfoValue) * m_sampleRate) + numSamples + 2 < bufferSize;
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::processStaticTaps(SampleType* output, const SampleType* dry, size_t numSamples, size_t channel, 
+    size_t inputChannel, size_t numTaps, SampleType gain, SampleType lfoValue) noexcept
+{
+    assert(numTaps > 0);
+
+    auto& delayBuffer = m_delayBuffers[inputChannel];
+    auto& delayTimes = m_delayTimes[channel];
+
+    if (numTaps == 1)
+    {
+        delayBuffer.addDelayedBlock(output, numSamples, (delayTimes[0].getTargetValue() + lfoValue) * m_sampleRate, gain, dry);
+    }
+    else
+    {
+        // the taps are summed before the gain like the modulated paths, so the output is the same whichever path runs
+        assert(numSamples <= m_tapSums.size());
+        auto* tapSums = m_tapSums.data();
+        std::fill(tapSums, tapSums + numSamples, SampleType(0));
+
+        for (size_t tap = 0; tap < numTaps; ++tap)
+            delayBuffer.addDelayedBlock(tapSums, numSamples, (delayTimes[tap].getTargetValue() + lfoValue) * m_sampleRate,
+                SampleType(1));
+
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = dry[i] + tapSums[i] * gain;
+    }
+
+    // keep the lfo running so the phase is the same when the delay starts moving again
+    m_lfos[channel].skip(numSamples);
+    m_lfoValues[channel] = lfoValue;
+
+    for (size_t tap = numTaps; tap < NumTaps; ++tap)
+        delayTimes[tap].skip(static_cast<int>(numSamples));
+}
+
+template <typename SampleType, size_t NumTaps>
+SampleType ModDelay<SampleType, NumTaps>::getLfoValue(size_t channel)
+{
+    if (std::isnan(m_lfoValues[channel]))
+        m_lfoValues[channel] = (m_lfos[channel].processSample() + SampleType(2)) * SampleType(5e-1) * m_lfoDepth[channel].getNextValue();
+
+    return m_lfoValues[channel];
+}
+
+template <typename SampleType, size_t NumTaps>
+SampleType ModDelay<SampleType, NumTaps>::advanceLfo(size_t channel, size_t numSteps)
+{
+    assert(numSteps > 0);
+
+    m_lfos[channel].skip(numSteps - 1);
+    SampleType depth = m_lfoDepth[channel].skip(static_cast<int>(numSteps));
+
+    return (m_lfos[channel].processSample() + SampleType(2)) * SampleType(5e-1) * depth;
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::reset()
 {
     for (auto& buffer : m_delayBuffers)
         buffer.clear();
 
     for (auto& lfo : m_lfos)
         lfo.reset();
+
+    std::fill(m_lfoValues.begin(), m_lfoValues.end(), std::numeric_limits<SampleType>::quiet_NaN());
+    clearAllpassStates();
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::clearAllpassStates()
+{
+    for (auto& allpassStates : m_allpassStates)
+        allpassStates.fill(SampleType(0));
 }
 
 //==============================================================================
 
-template <typename SampleType>
-void ModDelay<SampleType>::setWetLevel(SampleType wetLevel)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setWetLevel(SampleType wetLevel)
 {
     m_wetLevel = wetLevel;
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::setMaxDelayTime(SampleType maxDelay)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setMaxDelayTime(SampleType maxDelay)
 {
     // this is more flexible then it needs to be
     // make sure the max delay time is a reasonable number
     // this will impact the buffer size allocated
-    jassert(maxDelay >= SampleType(0) && maxDelay < SampleType(10));
+    assert(maxDelay >= SampleType(0) && maxDelay < SampleType(10));
     m_maxDelayTime = maxDelay;
 
     updateDelayBufferSize();
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::setDelayTime(SampleType delayTime, size_t channel/* = 0*/, bool force/* = false*/)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setDelayTime(SampleType delayTime, size_t channel/* = 0*/, bool force/* = false*/)
 {
-    jassert(delayTime > SampleType(0) && delayTime < (m_maxDelayTime - m_maxDepth));
+    setTapDelayTime(0, delayTime, channel, force);
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setTapDelayTime(size_t tap, SampleType delayTime, size_t channel/* = 0*/, bool force/* = false*/)
+{
+    assert(tap < NumTaps);
+    assert(delayTime > SampleType(0) && delayTime < (m_maxDelayTime - m_maxDepth));
+
+    // a mono layout has no second channel to set
+    if (channel >= m_delayTimes.size())
+        return;
 
     if (force)
-        m_delayTimes[channel].setCurrentAndTargetValue(delayTime);
+        m_delayTimes[channel][tap].setCurrentAndTargetValue(delayTime);
     else
-        m_delayTimes[channel].setTargetValue(delayTime);
+        m_delayTimes[channel][tap].setTargetValue(delayTime);
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::setPhaseOffset(SampleType phaseOffset, size_t channel/* = 0*/)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setPhaseOffset(SampleType phaseOffset, size_t channel/* = 0*/)
 {
-    m_lfos[channel].setPhaseOffset(phaseOffset);
+    // a mono layout has no second channel to offset
+    if (channel < m_lfos.size())
+        m_lfos[channel].setPhaseOffset(phaseOffset);
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::setLfoType(WaveType type)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setLfoType(WaveType type)
 {
     for (auto& lfo : m_lfos)
         lfo.setType(type);
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::setRate(SampleType rate)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setRate(SampleType rate)
 {
-    jassert(rate >= SampleType(0));
+    assert(rate >= SampleType(0));
     m_lfoRate = rate;
     for (auto& lfo : m_lfos)
         lfo.setFrequency(m_lfoRate);
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::setDepth(SampleType depth)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setDepth(SampleType depth)
 {
     for (auto& lfoDepth : m_lfoDepth)
         lfoDepth.setTargetValue(depth * m_maxDepth);
 }
 
-template <typename SampleType>
-void ModDelay<SampleType>::setMaxDepth(SampleType maxDepth)
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setControlInterval(size_t interval)
+{
+    assert(interval > 0);
+    interval = std::max(size_t(1), interval);
+
+    if (interval == m_controlInterval)
+        return;
+
+    // the lfo values are evaluated again when the control rate path runs
+    m_controlInterval = interval;
+    std::fill(m_lfoValues.begin(), m_lfoValues.end(), std::numeric_limits<SampleType>::quiet_NaN());
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setInterpolation(Interpolation interpolation)
+{
+    assert(interpolation != Interpolation::MAX);
+
+    if (interpolation == m_interpolation)
+        return;
+
+    // the allpass states are only valid for the interpolation they were made with
+    m_interpolation = interpolation;
+    clearAllpassStates();
+}
+
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::setMaxDepth(SampleType maxDepth)
 {
     m_maxDepth = maxDepth;
 }
 
-template <typename SampleType>
-int ModDelay<SampleType>::getLatency()
+template <typename SampleType, size_t NumTaps>
+int ModDelay<SampleType, NumTaps>::getLatency()
 {
-    return juce::roundToInt(m_delayTimes[0].getCurrentValue() * m_sampleRate);
+    return roundToInt(m_delayTimes[0][0].getCurrentValue() * m_sampleRate);
 }
 
-template <typename SampleType>
-size_t ModDelay<SampleType>::getNumChannels()
+template <typename SampleType, size_t NumTaps>
+size_t ModDelay<SampleType, NumTaps>::getNumChannels()
+{
+    return m_delayTimes.size();
+}
+
+template <typename SampleType, size_t NumTaps>
+size_t ModDelay<SampleType, NumTaps>::getNumInputChannels()
 {
     return m_delayBuffers.size();
 }
 
 //==============================================================================
 
-template <typename SampleType>
-void ModDelay<SampleType>::updateDelayBufferSize()
+template <typename SampleType, size_t NumTaps>
+void ModDelay<SampleType, NumTaps>::updateDelayBufferSize()
 {
     size_t bufferSize = static_cast<size_t>(std::ceil(m_maxDelayTime * m_sampleRate));
 
@@ -166,5 +592,9 @@ void ModDelay<SampleType>::updateDelayBufferSize()
 template class ModDelay<float>;
 template class ModDelay<double>;
 
+// used by ChorusVoices, one tap per voice
+template class ModDelay<float, 64>;
+template class ModDelay<double, 64>;
+
 //==============================================================================
 } // dingus
\ No newline at end of file
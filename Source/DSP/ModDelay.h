@@ -10,8 +10,11 @@
 
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
 #include <vector>
+#include <array>
+#include <cmath>
+#include <limits>
 #include "Oscillator.h"
 #include "DelayBuffer.h"
 
@@ -23,20 +26,54 @@ namespace dingus
     This class is used for a single modulating delay line.
     This was designed with a chorus effect in mind. 
     Use a float or double audio sample type.  
+    The delay line can have multiple taps which all share the same buffer and lfo,
+    each tap has its own delay time.  The number of taps is fixed at compile time.
 */
-template <typename SampleType>
+template <typename SampleType, size_t NumTaps = 1>
 class ModDelay
 {
 public:
+    static_assert(NumTaps > 0, "ModDelay needs at least one tap");
+
     ModDelay();
 
     // prepares the delay for playback given a ProcessSpec
-    void prepare(const juce::dsp::ProcessSpec& spec);
+    // numInputChannels can be set to 1 so that every channel taps a single shared delay buffer,
+    // by default there is one delay buffer per channel
+    void prepare(const ProcessSpec& spec, size_t numInputChannels = 0);
 
     // processes a single sample
     SampleType processSample(SampleType input, size_t channel);
 
-    // processes a block of samples using a juce ProcessContext
+    // reads the modulated delay for a channel without pushing a new sample, the tap is 100% wet
+    // this always uses linear interpolation
+    // use with pushSample() when several channels share a single delay buffer
+    SampleType processTap(size_t channel);
+
+    // processes a block for a single channel, adds the sum of the first numTaps taps scaled by gain to the output
+    // the lfo is evaluated once per sample, so each tap only costs a delay read and a multiply-add
+    // the taps are 100% wet and inactive taps are not read, the reads use the interpolation set by setInterpolation()
+    // if dry is set the output is overwritten with dry + the taps, so the output doesn't need to be filled first
+    void processTaps(const SampleType* input, SampleType* output, size_t numSamples, 
+        size_t channel, size_t numTaps, SampleType gain, const SampleType* dry = nullptr) noexcept;
+
+    // same as processTaps() but every channel reads from a single shared delay buffer
+    // there must be one output pointer for each channel, and one dry pointer for each channel if they are set
+    void processSharedTaps(const SampleType* input, SampleType* const* outputs, size_t numSamples, 
+        size_t numTaps, SampleType gain, const SampleType* const* drys = nullptr) noexcept;
+
+    // pushes a new sample to the delay buffer for a given input channel
+    void pushSample(SampleType input, size_t inputChannel = 0);
+
+    // pushes a block of samples to the delay buffer for a given input channel without reading any taps
+    void pushBlock(const SampleType* input, size_t numSamples, size_t inputChannel = 0) noexcept;
+
+    // advances the lfo, the depth and the tap delay times of a channel by numSamples without reading any taps
+    // use with pushBlock() to keep the delay running while its output isn't needed
+    // the allpass states of the channel aren't run, so they are cleared
+    void skip(size_t numSamples, size_t channel) noexcept;
+
+    // processes a block of samples using a ProcessContext
     template <typename ProcessContext>
     void process(const ProcessContext& context) noexcept
     {
@@ -75,6 +112,9 @@ public:
     // around which the delay is modulated
     void setDelayTime(SampleType delayTime, size_t channel = 0, bool force = false);
 
+    // sets the target delay for a given tap
+    void setTapDelayTime(size_t tap, SampleType delayTime, size_t channel = 0, bool force = false);
+
     // offsets the phase of the lfo for a given channel
     void setPhaseOffset(SampleType phaseOffset, size_t channel = 0);
 
@@ -87,6 +127,23 @@ public:
     // value from 0-1 multiplied by the maxDepth to produce the mod depth in sec
     void setDepth(SampleType depth);
 
+    // sets how often the lfo is evaluated by processTaps() and processSharedTaps(), in samples
+    // the lfo offset is linearly interpolated in between, an interval of 1 evaluates every sample
+    // for a sine lfo the error is at most maxDepth * 0.5 * (2pi * f * interval / sampleRate)^2 / 8 secs,
+    // where f is the lfo cycle rate (twice the rate set).  For the max rate of 20 Hz and 1 ms of depth 
+    // at a control rate of 2.5 kHz this is 0.63 us, about 0.03 samples at 48 kHz
+    // a triangle lfo is exact except at its corners, where the error is at most maxDepth * f * interval / sampleRate
+    // both only hold while the depth and phase offset are constant, a new rate is fine since each block starts an interval
+    // while the depth or a phase offset is smoothed the offset can bend anywhere in an interval, the error is then at most
+    // half its largest slope times interval / sampleRate secs
+    // the offset is (lfo + 2) / 2 * depth and a triangle moves by 4 in each cycle, so with the depth smoothed over 0.2 secs
+    // and a phase offset moving up to a cycle over 0.5 secs the slope is at most maxDepth * (2 * (f + 2) * depth + 7.5)
+    // for the max rate and 1 ms of depth that's 0.73 samples at 2.5 kHz and 48 kHz
+    void setControlInterval(size_t interval);
+
+    // sets the interpolation used by processTaps() and processSharedTaps()
+    void setInterpolation(Interpolation interpolation);
+
     // sets the maximum depth in sec by which the delay time is modulated
     void setMaxDepth(SampleType maxDepth);
 
@@ -94,30 +151,78 @@ public:
     // useful for mod effects that require delay compensation
     int getLatency();
 
-    // returns the number of buffers allocated (one per channel)
+    // returns the number of channels being processed (one lfo and delay time per channel)
     size_t getNumChannels();
 
+    // returns the number of delay buffers allocated (one per input channel)
+    size_t getNumInputChannels();
+
     //==============================================================================
 
 private:
     SampleType m_sampleRate{};
     SampleType m_wetLevel{ SampleType(1) };
 
-    // delay buffers for each channel
+    // delay buffers for each input channel
+    // when there is a single shared buffer, all channels read from buffer 0
     std::vector<DelayBuffer<SampleType>> m_delayBuffers;
-    std::vector<juce::SmoothedValue<SampleType>> m_delayTimes;
+    bool m_sharedBuffer{ false };
+    // delay times for every tap of each channel
+    std::vector<std::array<SmoothedValue<SampleType>, NumTaps>> m_delayTimes;
     SampleType m_maxDelayTime{ SampleType(1) };
 
     // lfos
     std::vector<Oscillator<SampleType>> m_lfos;
     SampleType m_lfoRate{ SampleType(2) };
     // need a smoothed value per channel so that getNextValue() returns the same value for each channel
-    std::vector<juce::SmoothedValue<SampleType>> m_lfoDepth;
+    std::vector<SmoothedValue<SampleType>> m_lfoDepth;
     // max depth is the maximum delay value to modulate
     SampleType m_maxDepth{ SampleType(1e-3) };
 
+    // the lfo is only evaluated every m_controlInterval samples
+    size_t m_controlInterval{ 1 };
+    // the lfo offset for the current sample of each channel, NaN until it has been evaluated
+    std::vector<SampleType> m_lfoValues;
+    // the lfo offset at the end of the current control period of each channel
+    std::vector<SampleType> m_nextLfoValues;
+
+    // the taps of a block with a constant delay are summed here before the gain, see processStaticTaps()
+    std::vector<SampleType> m_tapSums;
+
+    Interpolation m_interpolation{ Interpolation::LINEAR };
+    // the previous output of every tap of each channel, used by the thiran allpass
+    std::vector<std::array<SampleType, NumTaps>> m_allpassStates;
+
     void updateDelayBufferSize();
 
+    // returns the lfo offset in secs for the current sample, used at control rate
+    SampleType getLfoValue(size_t channel);
+
+    // advances the lfo by numSteps samples and returns the lfo offset in secs at that point
+    // the lfo has to be evaluated for the current sample with getLfoValue() first
+    SampleType advanceLfo(size_t channel, size_t numSteps);
+
+    // checks if the delay times of the first numTaps taps of a channel won't move during the next block
+    // this is the case when the depth is 0 or the lfo is static, and no delay time is smoothing
+    // if so, lfoValue is set to the constant lfo offset in secs
+    bool isStaticDelay(size_t channel, size_t numTaps, size_t numSamples, SampleType& lfoValue);
+
+    // processTaps() and processSharedTaps() for a given interpolation, once the delay is known to move
+    template <Interpolation Type>
+    void processModulatedTaps(const SampleType* input, SampleType* output, size_t numSamples,
+        size_t channel, size_t numTaps, SampleType gain, const SampleType* dry) noexcept;
+
+    template <Interpolation Type>
+    void processModulatedSharedTaps(const SampleType* input, SampleType* const* outputs, size_t numSamples,
+        size_t numTaps, SampleType gain, const SampleType* const* drys) noexcept;
+
+    void clearAllpassStates();
+
+    // writes dry + the first numTaps taps of a channel to the output using a constant delay
+    // this has to be called after the input block is pushed
+    void processStaticTaps(SampleType* output, const SampleType* dry, size_t numSamples, size_t channel, 
+        size_t inputChannel, size_t numTaps, SampleType gain, SampleType lfoValue) noexcept;
+
 };
 //==============================================================================
 
@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+    ModMatrix.cpp
+    Created: 19 Oct 2026 6:05:22pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "ModMatrix.h"
+#include "JuceAdapters.h"
+
+namespace dingus
+{
+//==============================================================================
+constexpr size_t ModMatrix::maxRoutes;
+constexpr size_t ModMatrix::numLfos;
+
+ModMatrix::ModMatrix()
+{
+}
+
+void ModMatrix::setNumTargets(size_t numTargets)
+{
+    m_numTargets = numTargets;
+}
+
+void ModMatrix::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    m_sampleRate = spec.sampleRate;
+    m_controlInterval = dingus::getControlInterval(m_sampleRate, static_cast<double>(m_controlRate));
+    m_maxPoints = (spec.maximumBlockSize + m_controlInterval - 1) / m_controlInterval;
+
+    for (auto& lfo : m_lfos)
+        lfo.prepare(toProcessSpec(spec));
+
+    m_envelope.prepare(m_sampleRate, m_controlInterval);
+
+    for (auto& buffer : m_sourceBuffers)
+        buffer.assign(m_maxPoints, 0.0f);
+
+    m_targetBuffers.assign(m_numTargets * m_maxPoints, 0.0f);
+    m_depthRamp.assign(m_maxPoints, 0.0f);
+
+    m_isTargetActive.assign(m_numTargets, false);
+    m_activeTargets.assign(m_numTargets, 0);
+    m_numActiveTargets = 0;
+    m_samplesToNextPoint = 0;
+
+    // the depths are smoothed over the control points
+    for (auto& route : m_routes)
+    {
+        route.smoothedDepth.reset(m_sampleRate / static_cast<double>(m_controlInterval), 0.5);
+        route.smoothedDepth.setCurrentAndTargetValue(route.depth);
+    }
+}
+
+void ModMatrix::reset()
+{
+    for (auto& lfo : m_lfos)
+        lfo.reset();
+
+    m_randomPhase = 0.0f;
+    m_randomValue = 0.0f;
+    m_samplesToNextPoint = 0;
+    m_envelope.reset();
+}
+
+//==============================================================================
+
+size_t ModMatrix::updateRoutes(size_t numSamples) noexcept
+{
+    // the points carry on from the last block so small blocks don't evaluate the sources more often
+    m_firstPoint = juce::jmin(m_samplesToNextPoint, numSamples);
+    size_t numPoints = (numSamples - m_firstPoint + m_controlInterval - 1) / m_controlInterval;
+    m_samplesToNextPoint = m_samplesToNextPoint + numPoints * m_controlInterval - numSamples;
+    jassert(numPoints <= m_maxPoints);
+
+    for (size_t i = 0; i < m_numActiveTargets; ++i)
+        m_isTargetActive[m_activeTargets[i]] = false;
+
+    m_numActiveTargets = 0;
+    m_numActiveRoutes = 0;
+
+    // find the routes that do anything and the sources they use
+    m_isSourceUsed.fill(false);
+
+    for (size_t index = 0; index < maxRoutes; ++index)
+    {
+        auto& route = m_routes[index];
+        int target = route.target;
+        int source = route.source;
+        float depth = route.depth;
+
+        if (target < 0 || static_cast<size_t>(target) >= m_numTargets 
+            || source < 0 || source >= static_cast<int>(ModSource::MAX))
+        {
+            route.smoothedDepth.setCurrentAndTargetValue(depth);
+            continue;
+        }
+
+        route.smoothedDepth.setTargetValue(depth);
+
+        if (depth == 0.0f && !route.smoothedDepth.isSmoothing())
+            continue;
+
+        m_isSourceUsed[static_cast<size_t>(source)] = true;
+        m_activeRoutes[m_numActiveRoutes++] = { index, static_cast<size_t>(source), static_cast<size_t>(target) };
+    }
+
+    return numPoints;
+}
+
+void ModMatrix::addRoutes(size_t numPoints) noexcept
+{
+    for (size_t i = 0; i < m_numActiveRoutes; ++i)
+    {
+        auto& activeRoute = m_activeRoutes[i];
+        auto& route = m_routes[activeRoute.route];
+        auto target = activeRoute.target;
+        auto* offsets = m_targetBuffers.data() + target * m_maxPoints;
+        auto* sourceValues = m_sourceBuffers[activeRoute.source].data();
+
+        if (!m_isTargetActive[target])
+        {
+            juce::FloatVectorOperations::clear(offsets, static_cast<int>(numPoints));
+            m_isTargetActive[target] = true;
+            m_activeTargets[m_numActiveTargets++] = target;
+        }
+
+        if (!route.smoothedDepth.isSmoothing())
+        {
+            juce::FloatVectorOperations::addWithMultiply(offsets, sourceValues, 
+                route.smoothedDepth.getTargetValue(), static_cast<int>(numPoints));
+            continue;
+        }
+
+        for (size_t point = 0; point < numPoints; ++point)
+            m_depthRamp[point] = route.smoothedDepth.getNextValue();
+
+        juce::FloatVectorOperations::addWithMultiply(offsets, sourceValues, m_depthRamp.data(), static_cast<int>(numPoints));
+    }
+}
+
+void ModMatrix::renderSources(size_t numSamples, size_t numPoints) noexcept
+{
+    // the lfos are evaluated at each control point and skipped in between
+    // lfos that aren't used are only advanced so they keep their phase
+    for (size_t lfo = 0; lfo < numLfos; ++lfo)
+    {
+        auto& oscillator = m_lfos[lfo];
+
+        if (!m_isSourceUsed[static_cast<size_t>(ModSource::LFO1) + lfo])
+        {
+            oscillator.skip(numSamples);
+            continue;
+        }
+
+        auto* values = m_sourceBuffers[static_cast<size_t>(ModSource::LFO1) + lfo].data();
+        oscillator.skip(m_firstPoint);
+
+        for (size_t point = 0; point < numPoints; ++point)
+        {
+            values[point] = oscillator.processSample();
+            oscillator.skip(getPointLength(point, numSamples) - 1);
+        }
+    }
+
+    // the random source holds a new value each time its phase wraps
+    float randomDelta = m_randomRate / static_cast<float>(m_sampleRate);
+
+    if (m_isSourceUsed[static_cast<size_t>(ModSource::RANDOM)])
+    {
+        auto* values = m_sourceBuffers[static_cast<size_t>(ModSource::RANDOM)].data();
+        advanceRandom(randomDelta, m_firstPoint);
+
+        for (size_t point = 0; point < numPoints; ++point)
+        {
+            values[point] = m_randomValue;
+            advanceRandom(randomDelta, getPointLength(point, numSamples));
+        }
+    }
+    else
+    {
+        m_randomPhase += randomDelta * static_cast<float>(numSamples);
+        m_randomPhase -= std::floor(m_randomPhase);
+    }
+
+    if (m_isSourceUsed[static_cast<size_t>(ModSource::MACRO)])
+        juce::FloatVectorOperations::fill(m_sourceBuffers[static_cast<size_t>(ModSource::MACRO)].data(), 
+            m_macro.load(), static_cast<int>(numPoints));
+}
+
+void ModMatrix::advanceRandom(float randomDelta, size_t numSteps) noexcept
+{
+    m_randomPhase += randomDelta * static_cast<float>(numSteps);
+
+    if (m_randomPhase >= 1.0f)
+    {
+        m_randomPhase -= std::floor(m_randomPhase);
+        m_randomValue = m_random.nextFloat() * 2.0f - 1.0f;
+    }
+}
+
+size_t ModMatrix::getPointLength(size_t point, size_t numSamples) const noexcept
+{
+    return juce::jmin(m_controlInterval, numSamples - (m_firstPoint + point * m_controlInterval));
+}
+
+size_t ModMatrix::getFirstPoint() const
+{
+    return m_firstPoint;
+}
+
+size_t ModMatrix::getNumActiveTargets() const
+{
+    return m_numActiveTargets;
+}
+
+size_t ModMatrix::getActiveTarget(size_t index) const
+{
+    jassert(index < m_numActiveTargets);
+    return m_activeTargets[index];
+}
+
+const float* ModMatrix::getOffsets(size_t target) const
+{
+    jassert(target < m_numTargets);
+    return m_targetBuffers.data() + target * m_maxPoints;
+}
+
+//==============================================================================
+
+void ModMatrix::setRoute(size_t route, ModSource source, int target, float depth)
+{
+    setRouteSource(route, source);
+    setRouteTarget(route, target);
+    setRouteDepth(route, depth);
+}
+
+void ModMatrix::setRouteSource(size_t route, ModSource source)
+{
+    jassert(route < maxRoutes);
+    m_routes[route].source = static_cast<int>(source);
+}
+
+void ModMatrix::setRouteTarget(size_t route, int target)
+{
+    jassert(route < maxRoutes);
+    m_routes[route].target = target;
+}
+
+void ModMatrix::setRouteDepth(size_t route, float depth)
+{
+    jassert(route < maxRoutes);
+    m_routes[route].depth = depth;
+}
+
+//==============================================================================
+
+void ModMatrix::setLfoRate(size_t lfo, float rate)
+{
+    jassert(lfo < numLfos);
+    m_lfos[lfo].setFrequency(rate);
+}
+
+void ModMatrix::setLfoType(size_t lfo, WaveType type)
+{
+    jassert(lfo < numLfos);
+    m_lfos[lfo].setType(type);
+}
+
+void ModMatrix::setRandomRate(float rate)
+{
+    jassert(rate >= 0.0f);
+    m_randomRate = rate;
+}
+
+void ModMatrix::setMacro(float value)
+{
+    m_macro = value;
+}
+
+void ModMatrix::setEnvelopeAttack(float attack)
+{
+    m_envelope.setAttack(attack);
+}
+
+void ModMatrix::setEnvelopeRelease(float release)
+{
+    m_envelope.setRelease(release);
+}
+
+void ModMatrix::setEnvelopeType(EnvelopeType type)
+{
+    m_envelope.setType(type);
+}
+
+void ModMatrix::setControlRate(float controlRate)
+{
+    jassert(controlRate >= 0.0f);
+    m_controlRate = controlRate;
+}
+
+size_t ModMatrix::getControlInterval() const
+{
+    return m_controlInterval;
+}
+
+//==============================================================================
+
+} // dingus
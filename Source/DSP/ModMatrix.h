@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    ModMatrix.h
+    Created: 19 Oct 2026 6:05:22pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include <atomic>
+#include "Oscillator.h"
+#include "EnvelopeFollower.h"
+
+namespace dingus
+{
+
+// the sources that can be routed by the mod matrix
+// the lfos and random source are bipolar, the macro and envelope are unipolar
+enum class ModSource
+{
+    LFO1,
+    LFO2,
+    RANDOM,
+    MACRO,
+    ENVELOPE,
+    MAX
+};
+
+//==============================================================================
+/**
+    This mod matrix routes a set of modulation sources to any number of targets.
+    Once per block, every source that is used by a route is rendered at the control rate 
+    into its own buffer, then each active route adds its source to its target with a 
+    multiply-add over the buffer.  Routes without a target or depth are skipped and
+    sources that aren't routed are only advanced.
+    The matrix only sums the offsets for each target, the caller applies them to the
+    parameters at each control point, see getOffsets().
+*/
+class ModMatrix
+{
+public:
+    static constexpr size_t maxRoutes{ 16 };
+    static constexpr size_t numLfos{ 2 };
+
+    ModMatrix();
+
+    // sets the number of targets that can be modulated, this must be called before prepare()
+    void setNumTargets(size_t numTargets);
+
+    // prepares the matrix for playback
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    // resets the sources
+    void reset();
+
+    // renders the sources and routes for the next block of samples
+    // the envelope follower reads the input block, it's only run when a route uses it
+    // returns the number of control points in the block, one at the start of each control interval
+    // the control intervals carry on across blocks so a block smaller than the interval can have no points
+    template<typename SampleType>
+    size_t process(const juce::dsp::AudioBlock<const SampleType>& inputBlock) noexcept
+    {
+        auto numSamples = inputBlock.getNumSamples();
+        size_t numPoints = updateRoutes(numSamples);
+
+        renderSources(numSamples, numPoints);
+
+        if (m_isSourceUsed[static_cast<size_t>(ModSource::ENVELOPE)])
+            m_envelope.process(inputBlock, m_sourceBuffers[static_cast<size_t>(ModSource::ENVELOPE)].data(), m_firstPoint, numPoints);
+
+        addRoutes(numPoints);
+        return numPoints;
+    }
+
+    // returns the sample of the first control point in the last block, the rest follow every control interval
+    // this is the length of the last block if it had no points
+    size_t getFirstPoint() const;
+
+    // returns the number of targets modulated in the last block
+    size_t getNumActiveTargets() const;
+
+    // returns one of the targets modulated in the last block
+    size_t getActiveTarget(size_t index) const;
+
+    // returns the summed offset of a target at each control point of the last block
+    // each route adds its source scaled by its depth
+    const float* getOffsets(size_t target) const;
+
+    //==============================================================================
+    // routes can be changed from any thread, a change is picked up at the next block
+
+    // routes a source to a target with a depth, a negative target disables the route
+    void setRoute(size_t route, ModSource source, int target, float depth);
+
+    // sets the source of a route
+    void setRouteSource(size_t route, ModSource source);
+
+    // sets the target of a route, a negative target disables the route
+    void setRouteTarget(size_t route, int target);
+
+    // sets the depth of a route, the depth is smoothed
+    void setRouteDepth(size_t route, float depth);
+
+    //==============================================================================
+    // sources
+
+    // sets the rate of one of the lfos in Hz
+    void setLfoRate(size_t lfo, float rate);
+
+    // sets the wave type of one of the lfos
+    void setLfoType(size_t lfo, WaveType type);
+
+    // sets the rate in Hz at which the random source picks a new value
+    void setRandomRate(float rate);
+
+    // sets the value of the macro source from 0-1
+    void setMacro(float value);
+
+    // sets the attack time of the envelope follower in ms
+    void setEnvelopeAttack(float attack);
+
+    // sets the release time of the envelope follower in ms
+    void setEnvelopeRelease(float release);
+
+    // sets how the envelope follower detects the level of the input
+    void setEnvelopeType(EnvelopeType type);
+
+    // sets the minimum rate in Hz at which the sources are evaluated, a rate of 0 evaluates every sample
+    // this must be called before prepare()
+    void setControlRate(float controlRate);
+
+    // returns the number of samples between control points
+    size_t getControlInterval() const;
+
+    //==============================================================================
+
+private:
+    struct Route
+    {
+        std::atomic<int> source{ 0 };
+        std::atomic<int> target{ -1 };
+        std::atomic<float> depth{ 0.0f };
+        juce::SmoothedValue<float> smoothedDepth{ 0.0f };
+    };
+
+    std::array<Route, maxRoutes> m_routes;
+
+    // the routes that are active in the current block
+    // the source and target are read once per block so a route changing on another thread can't tear
+    struct ActiveRoute
+    {
+        size_t route;
+        size_t source;
+        size_t target;
+    };
+
+    std::array<ActiveRoute, maxRoutes> m_activeRoutes{};
+    size_t m_numActiveRoutes{ 0 };
+
+    // sources
+    std::array<Oscillator<float>, numLfos> m_lfos;
+    juce::Random m_random;
+    std::atomic<float> m_randomRate{ 1.0f };
+    float m_randomPhase{ 0.0f };
+    float m_randomValue{ 0.0f };
+    std::atomic<float> m_macro{ 0.0f };
+    EnvelopeFollower m_envelope;
+
+    // one buffer for each source and target, with a value at each control point
+    std::array<std::vector<float>, static_cast<size_t>(ModSource::MAX)> m_sourceBuffers;
+    std::vector<float> m_targetBuffers;
+    std::vector<float> m_depthRamp;
+    size_t m_maxPoints{ 0 };
+
+    // the targets modulated in the current block
+    size_t m_numTargets{ 0 };
+    std::vector<bool> m_isTargetActive;
+    std::vector<size_t> m_activeTargets;
+    size_t m_numActiveTargets{ 0 };
+
+    double m_sampleRate{ 44100.0 };
+    float m_controlRate{ 0.0f };
+    size_t m_controlInterval{ 1 };
+
+    // the sample of the first control point in the current block, and the samples left until the next point after it
+    size_t m_firstPoint{ 0 };
+    size_t m_samplesToNextPoint{ 0 };
+
+    // returns the number of samples from a control point to the next one or to the end of the block
+    size_t getPointLength(size_t point, size_t numSamples) const noexcept;
+
+    // the sources used by the active routes in the current block
+    std::array<bool, static_cast<size_t>(ModSource::MAX)> m_isSourceUsed{};
+
+    // finds the active routes and the sources they use, returns the number of control points
+    size_t updateRoutes(size_t numSamples) noexcept;
+
+    // renders the lfos, random and macro sources that are used and advances the rest
+    void renderSources(size_t numSamples, size_t numPoints) noexcept;
+
+    // advances the phase of the random source by numSteps samples and picks a new value if it wraps
+    void advanceRandom(float randomDelta, size_t numSteps) noexcept;
+
+    // adds each active route to its target
+    void addRoutes(size_t numPoints) noexcept;
+};
+
+//==============================================================================
+
+} // dingus
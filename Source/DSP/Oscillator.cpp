@@ -31,7 +31,16 @@ Oscillator<SampleType>::Oscillator(size_t tableSize) : m_tableSize(tableSize)
 template<typename SampleType>
 void Oscillator<SampleType>::updateDelta()
 {
-    m_tableDelta = (m_frequency + m_frequency) * m_sizeOverSR;
+    // the sample rate isn't known until prepare()
+    if (m_sampleRate <= SampleType(0))
+    {
+        m_phaseDelta = 0;
+        return;
+    }
+
+    // the cycles per sample as a fraction of 2^32, the table is read at twice the frequency
+    double cycles = 2.0 * static_cast<double>(m_frequency) / static_cast<double>(m_sampleRate);
+    m_phaseDelta = static_cast<std::uint32_t>((cycles - std::floor(cycles)) * 4294967296.0);
 }
 
 template<typename SampleType>
@@ -47,12 +56,12 @@ void Oscillator<SampleType>::initTables()
     }
 
     // angle ranges from -pi to pi
-    SampleType currentAngle = juce::MathConstants<SampleType>::pi * SampleType(-1);
-    SampleType angleDelta = juce::MathConstants<SampleType>::twoPi / m_tableSize;
+    SampleType currentAngle = MathConstants<SampleType>::pi * SampleType(-1);
+    SampleType angleDelta = MathConstants<SampleType>::twoPi / m_tableSize;
 
     for (size_t i = 0; i < m_tableSize; ++i)
     {
-        m_lookupTables[triIndex][i] = (2 / juce::MathConstants<SampleType>::pi) * std::asin(std::sin(currentAngle));
+        m_lookupTables[triIndex][i] = (2 / MathConstants<SampleType>::pi) * std::asin(std::sin(currentAngle));
         m_lookupTables[sineIndex][i] = std::sin(currentAngle);
         currentAngle += angleDelta;
     }
@@ -88,20 +97,33 @@ SampleType Oscillator<SampleType>::getFrequency()
     return m_frequency;
 }
 
+template<typename SampleType>
+bool Oscillator<SampleType>::isStatic() const
+{
+    return m_frequency == SampleType(0) && !m_phaseOffset.isSmoothing();
+}
+
+template<typename SampleType>
+void Oscillator<SampleType>::skip(size_t numSamples)
+{
+    m_phaseOffset.skip(static_cast<int>(numSamples));
+    m_phase += m_phaseDelta * static_cast<std::uint32_t>(numSamples);
+}
+
 //==============================================================================
 
 template<typename SampleType>
 void Oscillator<SampleType>::reset()
 {
-    m_tablePos = 0;
+    m_phase = 0;
 }
 
 template<typename SampleType>
-void Oscillator<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+void Oscillator<SampleType>::prepare(const ProcessSpec& spec)
 {
-    m_tablePos = 0;
+    m_phase = 0;
     m_sampleRate = static_cast<SampleType>(spec.sampleRate);
-    m_sizeOverSR = static_cast<SampleType>(m_tableSize / m_sampleRate);
+    m_phaseToTable = static_cast<SampleType>(static_cast<double>(m_tableSize) / 4294967296.0);
     updateDelta();
     m_phaseOffset.reset(spec.sampleRate, 0.5);
 }
@@ -114,7 +136,7 @@ SampleType Oscillator<SampleType>::processSample()
     // this offset position is calculated for each sample so that phase can be modulated
     // performance could be increased by making this static or by using a phase multiplier instead
     SampleType offsetPos = std::fmod(
-        m_tablePos + m_phaseOffset.getNextValue() * static_cast<SampleType>(m_tableSize),
+        static_cast<SampleType>(m_phase) * m_phaseToTable + m_phaseOffset.getNextValue() * static_cast<SampleType>(m_tableSize),
         static_cast<SampleType>(m_tableSize));
 
     size_t index0 = static_cast<size_t>(offsetPos);
@@ -128,8 +150,7 @@ SampleType Oscillator<SampleType>::processSample()
 
     SampleType sample = value0 + frac * (value1 - value0);
 
-    if ((m_tablePos += m_tableDelta) > m_tableSize)
-        m_tablePos -= m_tableSize;
+    m_phase += m_phaseDelta;
 
     return sample;
 }
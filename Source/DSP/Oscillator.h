@@ -10,11 +10,12 @@
 
 #pragma once
 
-#include <JuceHeader.h>
+#include "DspCore.h"
 #include <array>
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 namespace dingus
 {
@@ -28,12 +29,31 @@ enum class WaveType
     MAX
 };
 
+//==============================================================================
+// returns the number of samples between evaluations of a modulation source running at controlRate
+// the interval is the largest power of two that keeps the evaluation rate at or above controlRate
+// a control rate of 0 evaluates every sample
+inline size_t getControlInterval(double sampleRate, double controlRate)
+{
+    size_t interval = 1;
+
+    if (controlRate <= 0.0)
+        return interval;
+
+    while (static_cast<double>(interval * 2) * controlRate <= sampleRate)
+        interval *= 2;
+
+    return interval;
+}
+
 //==============================================================================
 /**
     This is a simple wavetable oscillator to be used in DSP as a modulation source.
     Use a float or double audio sample type.  Table size should be relatively small 
     since this is a modulation osciallor, but can be set in the constructor. 
     The default table size is 128 samples.
+    The phase is a 32 bit fraction of a cycle that wraps on its own, so skip() lands on
+    exactly the phase that processSample() would reach.
 */
 template<typename SampleType>
 class Oscillator 
@@ -59,8 +79,14 @@ public:
     // returns the current frequency
     SampleType getFrequency();
 
+    // returns true if the output won't change, the frequency is 0 and the phase offset isn't moving
+    bool isStatic() const;
+
+    // advances the oscillator by a number of samples without calculating any output
+    void skip(size_t numSamples);
+
     // prepares the oscillator for playback given a ProcessSpec
-    void prepare(const juce::dsp::ProcessSpec& spec);
+    void prepare(const ProcessSpec& spec);
 
     // calucluate and return the next sample using linear interpolation
     SampleType processSample();
@@ -81,16 +107,16 @@ public:
     }
 
 private:
-    SampleType m_sampleRate;
+    SampleType m_sampleRate{};
 
     WaveType m_type{ WaveType::TRI };
     std::array<std::vector<SampleType>, static_cast<size_t>(WaveType::MAX)> m_lookupTables;
 
     size_t m_tableSize{ 128 };
-    SampleType m_sizeOverSR{};
-    SampleType m_tablePos{};
-    SampleType m_tableDelta{};
-    juce::SmoothedValue<SampleType> m_phaseOffset{};
+    std::uint32_t m_phase{ 0 };
+    std::uint32_t m_phaseDelta{ 0 };
+    SampleType m_phaseToTable{};
+    SmoothedValue<SampleType> m_phaseOffset{};
 
     SampleType m_frequency{ SampleType(2) };
 
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 19 Oct 2026 9:42:13pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+
+namespace dingus
+{
+
+//==============================================================================
+constexpr size_t QualityGovernor::numTiers;
+
+QualityGovernor::QualityGovernor()
+{
+}
+
+void QualityGovernor::prepare(double sampleRate)
+{
+    jassert(sampleRate > 0.0);
+    m_sampleRate = sampleRate;
+    reset();
+}
+
+void QualityGovernor::reset()
+{
+    m_load = 0.0;
+    m_pressureTime = 0.0;
+    m_reliefTime = 0.0;
+    m_tier = 0;
+    m_averageLoad = 0.0f;
+}
+
+//==============================================================================
+
+void QualityGovernor::addBlock(double processingTime, size_t numSamples) noexcept
+{
+    if (numSamples == 0)
+        return;
+
+    // the budget is the time the block takes to play
+    double budget = static_cast<double>(numSamples) / m_sampleRate;
+    double blockLoad = processingTime / budget;
+
+    double coefficient = std::exp(-budget / m_averagingTime);
+    m_load = blockLoad + coefficient * (m_load - blockLoad);
+    m_averageLoad = static_cast<float>(m_load);
+
+    // only sustained pressure or relief counts, a load in between starts both over
+    if (m_load > m_highLoad)
+    {
+        m_pressureTime += budget;
+        m_reliefTime = 0.0;
+    }
+    else if (m_load < m_lowLoad)
+    {
+        m_reliefTime += budget;
+        m_pressureTime = 0.0;
+    }
+    else
+    {
+        m_pressureTime = 0.0;
+        m_reliefTime = 0.0;
+    }
+
+    size_t tier = m_tier;
+
+    if (m_pressureTime >= m_stepDownTime && tier + 1 < numTiers)
+    {
+        m_tier = tier + 1;
+        m_pressureTime = 0.0;
+    }
+    else if (m_reliefTime >= m_stepUpTime && tier > 0)
+    {
+        m_tier = tier - 1;
+        m_reliefTime = 0.0;
+    }
+}
+
+size_t QualityGovernor::getTier() const
+{
+    return m_tier;
+}
+
+float QualityGovernor::getLoad() const
+{
+    return m_averageLoad;
+}
+
+//==============================================================================
+} // dingus
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.h
+    Created: 19 Oct 2026 9:42:13pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+namespace dingus
+{
+
+//==============================================================================
+/**
+    This class watches how long each block takes to process compared to the real time
+    budget of the block, the length of the block in secs.  The load is averaged over a short 
+    time, when it stays high the governor steps down to the next quality tier and when it 
+    stays low for longer it steps back up.  Tier 0 is full quality, what each tier gives up 
+    is decided by the caller.  Stepping up takes longer than stepping down so the tier 
+    doesn't bounce between two tiers that are both close to the limit.
+*/
+class QualityGovernor
+{
+public:
+    static constexpr size_t numTiers{ 4 };
+
+    QualityGovernor();
+
+    // prepares the governor for the sample rate of the blocks
+    void prepare(double sampleRate);
+
+    // goes back to full quality and clears the measured load
+    void reset();
+
+    // adds the time in secs it took to process a block of numSamples, this can step the tier up or down
+    void addBlock(double processingTime, size_t numSamples) noexcept;
+
+    // returns the current quality tier, 0 is full quality, this can be called from any thread
+    size_t getTier() const;
+
+    // returns the averaged load, the fraction of the real time budget used to process each block
+    float getLoad() const;
+
+private:
+    double m_sampleRate{ 44100.0 };
+
+    // the load is averaged over this time in secs
+    const double m_averagingTime{ 0.1 };
+    double m_load{ 0.0 };
+
+    // the tier steps down once the load has been above the high load for the step down time in secs
+    // and steps back up once it has been below the low load for the step up time
+    const double m_highLoad{ 0.5 };
+    const double m_lowLoad{ 0.2 };
+    const double m_stepDownTime{ 0.25 };
+    const double m_stepUpTime{ 3.0 };
+    double m_pressureTime{ 0.0 };
+    double m_reliefTime{ 0.0 };
+
+    std::atomic<size_t> m_tier{ 0 };
+    std::atomic<float> m_averageLoad{ 0.0f };
+};
+
+//==============================================================================
+} // dingus
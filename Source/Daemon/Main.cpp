@@ -0,0 +1,358 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 11:52:36pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <signal.h>
+#include "RenderClient.h"
+#include "RenderDaemon.h"
+
+//==============================================================================
+// chorus-daemon serve [socket]
+//     runs the daemon until it's interrupted
+// chorus-daemon test [socket]
+//     renders noise with changing parameters through the daemon and checks that it matches a local engine
+// chorus-daemon bench [socket] [block size] [voices choice]
+//     measures the round trip time of each block and the throughput with every slot in flight
+
+namespace
+{
+    const char* defaultSocketPath{ "/tmp/chorus-daemon.sock" };
+
+    using Clock = std::chrono::steady_clock;
+
+    // the plugin defaults, with the mix at half
+    dingus::ParameterSnapshot getDefaultParameters()
+    {
+        auto parameters = dingus::getDefaultSnapshot();
+        parameters.values[2] = 0.5f;
+
+        return parameters;
+    }
+
+    // returns a copy of the parameters with one of the applied values out of range, the daemon has to ignore it
+    dingus::ParameterSnapshot getInvalidParameters(const dingus::ParameterSnapshot& parameters, size_t block)
+    {
+        auto invalid = parameters;
+        auto& values = invalid.values;
+
+        switch (block % 4)
+        {
+        case (0): values[5] = 4.0f; break;                                          // mode
+        case (1): values[6] = -1.0f; break;                                         // voices
+        case (2): values[3] = std::numeric_limits<float>::quiet_NaN(); break;       // delay
+        default: values[21] = std::numeric_limits<float>::infinity(); break;        // latency reference
+        }
+
+        return invalid;
+    }
+
+    double getMicroseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    double getPercentile(std::vector<double>& values, double percentile)
+    {
+        std::sort(values.begin(), values.end());
+        auto index = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1) + 0.5);
+        return values[index];
+    }
+
+    //==============================================================================
+    int serve(const std::string& socketPath)
+    {
+        // the signals are blocked before the daemon starts its threads so only sigwait() sees them
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        dingus::RenderDaemon daemon;
+
+        if (!daemon.start(socketPath))
+        {
+            std::fprintf(stderr, "can't listen on %s: %s\n", socketPath.c_str(), std::strerror(errno));
+            return 1;
+        }
+
+        std::printf("listening on %s\n", socketPath.c_str());
+        std::fflush(stdout);
+
+        int signal = 0;
+        sigwait(&signals, &signal);
+
+        daemon.stop();
+        return 0;
+    }
+
+    //==============================================================================
+    int test(const std::string& socketPath)
+    {
+        const double sampleRate = 48000.0;
+        const size_t numChannels = 2;
+        const size_t maxBlockSize = 256;
+        const size_t numBlocks = 4000;
+
+        dingus::RenderRequest request;
+        request.sampleRate = sampleRate;
+        request.numChannels = numChannels;
+        request.maxBlockSize = maxBlockSize;
+
+        dingus::RenderClient client;
+
+        if (!client.connect(socketPath, request))
+        {
+            std::fprintf(stderr, "can't connect to %s: %s\n", socketPath.c_str(), std::strerror(errno));
+            return 1;
+        }
+
+        // the same engine in this process gives the expected output
+        dingus::ChorusEngine<float> engine;
+        dingus::RenderDaemon::prepareEngine(engine, { sampleRate, static_cast<std::uint32_t>(maxBlockSize), static_cast<std::uint32_t>(numChannels) });
+
+        std::vector<std::vector<float>> expected(numChannels, std::vector<float>(maxBlockSize));
+        std::vector<float*> expectedChannels;
+
+        for (auto& channel : expected)
+            expectedChannels.push_back(channel.data());
+
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        auto parameters = getDefaultParameters();
+
+        for (size_t block = 0; block < numBlocks; ++block)
+        {
+            // every so often the parameters change, including the mode, voices and latency
+            if (block % 50 == 0)
+            {
+                auto& values = parameters.values;
+                values[0] = 0.1f + 5.0f * std::abs(noise(random));
+                values[1] = std::abs(noise(random));
+                values[2] = std::abs(noise(random));
+                values[3] = 0.005f + 0.07f * std::abs(noise(random));
+                values[4] = std::abs(noise(random));
+                values[5] = static_cast<float>(random() % 4);
+                values[6] = static_cast<float>(random() % 8);
+                values[8] = static_cast<float>(random() % 2);
+                values[13] = static_cast<float>(random() % 2);
+                values[20] = static_cast<float>(random() % 2);
+
+                client.setParameters(parameters);
+                dingus::RenderDaemon::applyParameters(parameters, engine);
+            }
+            // in between the client sends values out of range, both engines keep the last values
+            else if (block % 50 == 25)
+            {
+                auto invalid = getInvalidParameters(parameters, block / 50);
+
+                if (dingus::RenderDaemon::applyParameters(invalid, engine))
+                {
+                    std::fprintf(stderr, "block %zu applied parameters that are out of range\n", block);
+                    return 1;
+                }
+
+                client.setParameters(invalid);
+            }
+
+            size_t numSamples = 1 + random() % maxBlockSize;
+            int slot = client.acquireSlot();
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* input = client.getChannel(slot, channel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    input[i] = noise(random);
+
+                std::copy(input, input + numSamples, expected[channel].begin());
+            }
+
+            if (!client.submit(slot, numSamples) || client.receive(1000) != slot)
+            {
+                std::fprintf(stderr, "block %zu didn't come back from the daemon\n", block);
+                return 1;
+            }
+
+            dingus::AudioBlock<float> expectedBlock(expectedChannels.data(), numChannels, numSamples);
+            dingus::ProcessContextReplacing<float> context(expectedBlock);
+            engine.process(context);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                if (std::memcmp(client.getChannel(slot, channel), expectedBlock.getChannelPointer(channel), numSamples * sizeof(float)) != 0)
+                {
+                    std::fprintf(stderr, "block %zu channel %zu doesn't match the local engine\n", block, channel);
+                    return 1;
+                }
+            }
+
+            if (client.getLatency() != engine.getLatency())
+            {
+                std::fprintf(stderr, "block %zu reports a latency of %d instead of %d\n", block, client.getLatency(), engine.getLatency());
+                return 1;
+            }
+
+            client.releaseSlot(slot);
+        }
+
+        std::printf("passed, %zu blocks match the local engine exactly\n", numBlocks);
+        return 0;
+    }
+
+    //==============================================================================
+    int bench(const std::string& socketPath, size_t blockSize, size_t voiceChoice)
+    {
+        const double sampleRate = 48000.0;
+        const size_t numChannels = 2;
+        const size_t numBlocks = 20000;
+
+        dingus::RenderRequest request;
+        request.sampleRate = sampleRate;
+        request.numChannels = numChannels;
+        request.maxBlockSize = static_cast<std::uint32_t>(blockSize);
+
+        dingus::RenderClient client;
+
+        if (!client.connect(socketPath, request))
+        {
+            std::fprintf(stderr, "can't connect to %s: %s\n", socketPath.c_str(), std::strerror(errno));
+            return 1;
+        }
+
+        auto parameters = getDefaultParameters();
+        parameters.values[6] = static_cast<float>(voiceChoice);
+        client.setParameters(parameters);
+
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+        for (size_t slot = 0; slot < client.getNumSlots(); ++slot)
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                for (size_t i = 0; i < blockSize; ++i)
+                    client.getChannel(static_cast<int>(slot), channel)[i] = noise(random);
+
+        // the same blocks processed in this process, to separate the transport from the processing
+        dingus::ChorusEngine<float> engine;
+        dingus::RenderDaemon::prepareEngine(engine, { sampleRate, static_cast<std::uint32_t>(blockSize), static_cast<std::uint32_t>(numChannels) });
+        dingus::RenderDaemon::applyParameters(parameters, engine);
+
+        std::vector<std::vector<float>> buffer(numChannels, std::vector<float>(blockSize));
+        std::vector<float*> bufferChannels;
+
+        for (auto& channel : buffer)
+        {
+            for (auto& sample : channel)
+                sample = noise(random);
+
+            bufferChannels.push_back(channel.data());
+        }
+
+        std::vector<double> localTimes;
+        std::vector<double> roundTripTimes;
+
+        for (size_t block = 0; block < numBlocks; ++block)
+        {
+            auto start = Clock::now();
+            dingus::AudioBlock<float> audioBlock(bufferChannels.data(), numChannels, blockSize);
+            dingus::ProcessContextReplacing<float> context(audioBlock);
+            engine.process(context);
+            localTimes.push_back(getMicroseconds(Clock::now() - start));
+        }
+
+        // one block in flight at a time, like an audio callback waiting for each block
+        for (size_t block = 0; block < numBlocks; ++block)
+        {
+            int slot = client.acquireSlot();
+            auto start = Clock::now();
+
+            if (!client.submit(slot, blockSize) || client.receive(1000) != slot)
+            {
+                std::fprintf(stderr, "block %zu didn't come back from the daemon\n", block);
+                return 1;
+            }
+
+            roundTripTimes.push_back(getMicroseconds(Clock::now() - start));
+            client.releaseSlot(slot);
+        }
+
+        // every slot in flight, the daemon always has the next block waiting
+        auto start = Clock::now();
+        size_t numSent = 0;
+        size_t numReceived = 0;
+
+        while (numReceived < numBlocks)
+        {
+            int slot;
+
+            while (numSent < numBlocks && (slot = client.acquireSlot()) >= 0)
+            {
+                client.submit(slot, blockSize);
+                ++numSent;
+            }
+
+            slot = client.receive(1000);
+
+            if (slot < 0)
+            {
+                std::fprintf(stderr, "block %zu didn't come back from the daemon\n", numReceived);
+                return 1;
+            }
+
+            client.releaseSlot(slot);
+            ++numReceived;
+        }
+
+        double pipelinedTime = std::chrono::duration<double>(Clock::now() - start).count();
+        double blockTime = 1.0e6 * static_cast<double>(blockSize) / sampleRate;
+        double localTime = getPercentile(localTimes, 0.5);
+        double roundTripTime = getPercentile(roundTripTimes, 0.5);
+
+        std::printf("block size %zu, voices choice %zu, block length %.1f us\n", blockSize, voiceChoice, blockTime);
+        std::printf("in process: median %.1f us\n", localTime);
+        std::printf("round trip: median %.1f us, p90 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n", roundTripTime,
+            getPercentile(roundTripTimes, 0.9), getPercentile(roundTripTimes, 0.99), getPercentile(roundTripTimes, 0.999),
+            getPercentile(roundTripTimes, 1.0));
+        std::printf("transport overhead: median %.1f us per block\n", roundTripTime - localTime);
+        std::printf("pipelined: %.0f blocks/s, %.1fx real time\n", static_cast<double>(numBlocks) / pipelinedTime,
+            static_cast<double>(numBlocks) * blockTime * 1.0e-6 / pipelinedTime);
+
+        return 0;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    std::string command = argc > 1 ? argv[1] : "";
+    std::string socketPath = argc > 2 ? argv[2] : defaultSocketPath;
+
+    if (command == "serve")
+        return serve(socketPath);
+
+    if (command == "test")
+        return test(socketPath);
+
+    if (command == "bench")
+    {
+        size_t blockSize = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 256;
+        size_t voiceChoice = argc > 4 ? static_cast<size_t>(std::atoi(argv[4])) : 3;
+        return bench(socketPath, dingus::limit(size_t(1), size_t(8192), blockSize), std::min(voiceChoice, size_t(7)));
+    }
+
+    std::printf("usage: %s serve|test|bench [socket] [block size] [voices choice 0-7]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+    RenderClient.cpp
+    Created: 19 Oct 2026 11:40:12pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "RenderClient.h"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace dingus
+{
+
+RenderClient::~RenderClient()
+{
+    disconnect();
+}
+
+bool RenderClient::connect(const std::string& socketPath, const RenderRequest& request)
+{
+    disconnect();
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+    {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    m_socket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+    if (m_socket < 0)
+        return false;
+
+    RenderReply reply;
+    int fds[3];
+
+    bool isOpen = ::connect(m_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0
+        && sendMessage(m_socket, &request, sizeof(request), nullptr, 0)
+        && receiveMessage(m_socket, &reply, sizeof(reply), fds, 3);
+
+    if (isOpen && (reply.magic != renderMagic || reply.status != 0))
+    {
+        for (int fd : fds)
+            if (fd >= 0)
+                ::close(fd);
+
+        errno = reply.status != 0 ? reply.status : EPROTO;
+        isOpen = false;
+    }
+
+    if (isOpen)
+    {
+        // the memory takes its descriptor even if it can't be mapped
+        m_requestSignal.attach(fds[1]);
+        m_responseSignal.attach(fds[2]);
+        isOpen = m_memory.attach(fds[0], static_cast<size_t>(reply.memorySize), request);
+
+        if (isOpen && (fds[1] < 0 || fds[2] < 0))
+        {
+            errno = EPROTO;
+            isOpen = false;
+        }
+    }
+
+    if (!isOpen)
+    {
+        int error = errno;
+        disconnect();
+        errno = error;
+        return false;
+    }
+
+    m_freeSlots.clear();
+
+    for (size_t slot = request.numSlots; slot > 0; --slot)
+        m_freeSlots.push_back(static_cast<int>(slot - 1));
+
+    m_latency = reply.latency;
+    return true;
+}
+
+void RenderClient::disconnect()
+{
+    // closing the socket ends the session in the daemon
+    if (m_socket >= 0)
+        ::close(m_socket);
+
+    m_socket = -1;
+    m_memory.release();
+    m_requestSignal.release();
+    m_responseSignal.release();
+    m_freeSlots.clear();
+}
+
+bool RenderClient::isConnected() const
+{
+    return m_socket >= 0;
+}
+
+void RenderClient::setParameters(const ParameterSnapshot& parameters)
+{
+    m_parameters = parameters;
+
+    // 0 is kept for the default values of the engine
+    if (++m_parameterSerial == 0)
+        m_parameterSerial = 1;
+}
+
+int RenderClient::acquireSlot()
+{
+    if (m_freeSlots.empty())
+        return -1;
+
+    int slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    return slot;
+}
+
+float* RenderClient::getChannel(int slot, size_t channel) const
+{
+    return m_memory.getChannel(static_cast<size_t>(slot), channel);
+}
+
+bool RenderClient::submit(int slot, size_t numSamples)
+{
+    assert(slot >= 0 && static_cast<size_t>(slot) < m_memory.getNumSlots());
+    assert(numSamples <= m_memory.getMaxBlockSize());
+
+    auto& renderSlot = m_memory.getSlot(static_cast<size_t>(slot));
+    renderSlot.numSamples = static_cast<std::uint32_t>(numSamples);
+
+    // the snapshot is only copied into a slot when it has changed since the slot was last sent
+    if (renderSlot.parameterSerial != m_parameterSerial)
+    {
+        renderSlot.parameters = m_parameters;
+        renderSlot.parameterSerial = m_parameterSerial;
+    }
+
+    if (!m_memory.getRequestQueue().push(static_cast<std::uint32_t>(slot)))
+        return false;
+
+    m_requestSignal.notify();
+    return true;
+}
+
+int RenderClient::receive(int timeout)
+{
+    if (m_socket < 0)
+        return -1;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+    pollfd events[2] = { { m_responseSignal.getFileDescriptor(), POLLIN, 0 }, { m_socket, POLLIN, 0 } };
+
+    while (true)
+    {
+        std::uint32_t index = 0;
+
+        if (m_memory.getResponseQueue().pop(index))
+        {
+            m_latency = m_memory.getSlot(index).latency;
+            return static_cast<int>(index);
+        }
+
+        int remaining = -1;
+
+        if (timeout >= 0)
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            remaining = static_cast<int>(std::max(static_cast<decltype(left.count())>(0), left.count()));
+        }
+
+        int result = poll(events, 2, remaining);
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        // the daemon doesn't send anything after the reply so the socket is only readable once it's closed
+        if (result <= 0 || events[1].revents != 0)
+            return -1;
+
+        m_responseSignal.consume();
+    }
+}
+
+void RenderClient::releaseSlot(int slot)
+{
+    assert(slot >= 0 && static_cast<size_t>(slot) < m_memory.getNumSlots());
+    m_freeSlots.push_back(slot);
+}
+
+bool RenderClient::processBlock(float* const* channels, size_t numSamples, int timeout)
+{
+    // this can't be mixed with blocks that are still in flight
+    assert(m_freeSlots.size() == m_memory.getNumSlots());
+
+    int slot = acquireSlot();
+
+    if (slot < 0)
+        return false;
+
+    for (size_t channel = 0; channel < m_memory.getNumChannels(); ++channel)
+        std::memcpy(getChannel(slot, channel), channels[channel], numSamples * sizeof(float));
+
+    if (!submit(slot, numSamples))
+    {
+        releaseSlot(slot);
+        return false;
+    }
+
+    // a block that doesn't come back in time leaves its slot with the daemon
+    if (receive(timeout) != slot)
+        return false;
+
+    for (size_t channel = 0; channel < m_memory.getNumChannels(); ++channel)
+        std::memcpy(channels[channel], getChannel(slot, channel), numSamples * sizeof(float));
+
+    releaseSlot(slot);
+    return true;
+}
+
+int RenderClient::getLatency() const
+{
+    return m_latency;
+}
+
+size_t RenderClient::getNumChannels() const
+{
+    return m_memory.getNumChannels();
+}
+
+size_t RenderClient::getMaxBlockSize() const
+{
+    return m_memory.getMaxBlockSize();
+}
+
+size_t RenderClient::getNumSlots() const
+{
+    return m_memory.getNumSlots();
+}
+
+//==============================================================================
+} // dingus
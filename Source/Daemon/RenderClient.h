@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    RenderClient.h
+    Created: 19 Oct 2026 11:40:12pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "RenderTransport.h"
+
+namespace dingus
+{
+
+//==============================================================================
+/**
+    The client side of a render daemon session.  The blocks can be written straight into
+    the shared memory with acquireSlot(), getChannel() and submit(), the output replaces the
+    input in the same slot once it has been received.  Up to the number of slots can be in
+    flight, processBlock() is a simpler blocking call that copies a block in and out.
+*/
+class RenderClient
+{
+public:
+    RenderClient() = default;
+    ~RenderClient();
+
+    // connects to a daemon and opens a session with the settings of the request
+    bool connect(const std::string& socketPath, const RenderRequest& request);
+
+    // closes the session
+    void disconnect();
+
+    bool isConnected() const;
+
+    // sets the parameters that are sent with the next blocks, in the order of the plugin parameters
+    void setParameters(const ParameterSnapshot& parameters);
+
+    // takes a free slot to write a block into, returns -1 if every slot is waiting for the daemon
+    int acquireSlot();
+
+    // returns the samples of a channel of a slot
+    float* getChannel(int slot, size_t channel) const;
+
+    // sends a slot holding numSamples of every channel to the daemon
+    bool submit(int slot, size_t numSamples);
+
+    // waits up to timeout ms for a processed slot and returns it, -1 waits forever
+    // returns -1 if the timeout passed or the daemon has gone away
+    int receive(int timeout);
+
+    // gives back a received slot so it can be acquired again
+    void releaseSlot(int slot);
+
+    // sends a block, waits for it and copies the output back in place, returns false if it didn't come back in time
+    bool processBlock(float* const* channels, size_t numSamples, int timeout);
+
+    // returns the latency of the engine in samples as of the last received block
+    int getLatency() const;
+
+    size_t getNumChannels() const;
+    size_t getMaxBlockSize() const;
+    size_t getNumSlots() const;
+
+private:
+    int m_socket{ -1 };
+    RenderMemory m_memory;
+    EventSignal m_requestSignal;
+    EventSignal m_responseSignal;
+
+    std::vector<int> m_freeSlots;
+
+    ParameterSnapshot m_parameters;
+    std::uint32_t m_parameterSerial{ 0 };
+
+    int m_latency{ 0 };
+
+    RenderClient(const RenderClient&) = delete;
+    RenderClient& operator=(const RenderClient&) = delete;
+};
+
+//==============================================================================
+} // dingus
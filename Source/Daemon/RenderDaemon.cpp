@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+    RenderDaemon.cpp
+    Created: 19 Oct 2026 11:31:48pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "RenderDaemon.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace dingus
+{
+
+//==============================================================================
+/**
+    One connected client.  The thread reads the request of the client, creates the shared
+    memory and prepares the engine, then processes the slots the client sends until the
+    client closes the socket or the daemon stops.
+*/
+class RenderDaemon::Session
+{
+public:
+    explicit Session(int socket) : m_socket(socket)
+    {
+        m_thread = std::thread([this] { run(); });
+    }
+
+    ~Session()
+    {
+        // wakes the thread if it's waiting for the client
+        shutdown(m_socket, SHUT_RDWR);
+        m_thread.join();
+        ::close(m_socket);
+    }
+
+    bool isFinished() const
+    {
+        return m_isFinished;
+    }
+
+private:
+    int m_socket;
+    std::thread m_thread;
+    std::atomic<bool> m_isFinished{ false };
+
+    RenderMemory m_memory;
+    EventSignal m_requestSignal;
+    EventSignal m_responseSignal;
+
+    ChorusEngine<float> m_engine;
+
+    // the channel pointers of each slot
+    std::vector<std::vector<float*>> m_channels;
+
+    // the parameter serial of the last block, 0 means the engine still has its default values
+    std::uint32_t m_parameterSerial{ 0 };
+
+    void run()
+    {
+        if (open())
+        {
+            pollfd events[2] = { { m_requestSignal.getFileDescriptor(), POLLIN, 0 }, { m_socket, POLLIN, 0 } };
+
+            while (true)
+            {
+                int result = poll(events, 2, -1);
+
+                if (result < 0 && errno == EINTR)
+                    continue;
+
+                // the client doesn't send anything after the request so the socket is only readable once it's closed
+                if (result < 0 || events[1].revents != 0)
+                    break;
+
+                if (events[0].revents & POLLIN)
+                {
+                    m_requestSignal.consume();
+                    processRequests();
+                }
+            }
+        }
+
+        m_isFinished = true;
+    }
+
+    // reads the request of the client and sends the shared memory and eventfds back
+    bool open()
+    {
+        RenderRequest request;
+
+        if (!receiveMessage(m_socket, &request, sizeof(request), nullptr, 0))
+            return false;
+
+        RenderReply reply;
+
+        if (request.magic != renderMagic || request.version != renderVersion)
+            reply.status = EPROTO;
+        else if (!m_memory.create(request) || !m_requestSignal.create() || !m_responseSignal.create())
+            reply.status = errno;
+
+        if (reply.status != 0)
+        {
+            sendMessage(m_socket, &reply, sizeof(reply), nullptr, 0);
+            return false;
+        }
+
+        prepareEngine(m_engine, { request.sampleRate, request.maxBlockSize, request.numChannels });
+
+        m_channels.resize(request.numSlots);
+
+        for (size_t slot = 0; slot < m_channels.size(); ++slot)
+            for (size_t channel = 0; channel < request.numChannels; ++channel)
+                m_channels[slot].push_back(m_memory.getChannel(slot, channel));
+
+        reply.latency = m_engine.getLatency();
+        reply.memorySize = m_memory.getSize();
+
+        int fds[3] = { m_memory.getFileDescriptor(), m_requestSignal.getFileDescriptor(), m_responseSignal.getFileDescriptor() };
+        return sendMessage(m_socket, &reply, sizeof(reply), fds, 3);
+    }
+
+    // processes every slot in the request queue, the client is woken after each slot
+    void processRequests() noexcept
+    {
+        std::uint32_t index = 0;
+
+        while (m_memory.getRequestQueue().pop(index))
+        {
+            if (index < m_channels.size())
+                processSlot(index);
+
+            // the client has at most one slot in flight for each place in the queue so this can't be full
+            m_memory.getResponseQueue().push(index);
+            m_responseSignal.notify();
+        }
+    }
+
+    // processes a slot in place
+    void processSlot(std::uint32_t index) noexcept
+    {
+        auto& slot = m_memory.getSlot(index);
+
+        if (slot.parameterSerial != m_parameterSerial)
+        {
+            // the client can still write to the slot, the values are copied before they're checked
+            // a snapshot with values out of range is ignored and the engine keeps the last values
+            ParameterSnapshot parameters = slot.parameters;
+            applyParameters(parameters, m_engine);
+            m_parameterSerial = slot.parameterSerial;
+        }
+
+        size_t numSamples = std::min(static_cast<size_t>(slot.numSamples), m_memory.getMaxBlockSize());
+
+        if (numSamples > 0)
+        {
+            AudioBlock<float> block(m_channels[index].data(), m_channels[index].size(), numSamples);
+            ProcessContextReplacing<float> context(block);
+            m_engine.process(context);
+        }
+
+        slot.latency = m_engine.getLatency();
+    }
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+};
+
+//==============================================================================
+constexpr float RenderDaemon::lfoControlRate;
+const std::array<size_t, 8> RenderDaemon::voiceCounts{ { 1, 2, 3, 4, 8, 16, 32, 64 } };
+
+RenderDaemon::RenderDaemon()
+{
+}
+
+RenderDaemon::~RenderDaemon()
+{
+    stop();
+}
+
+bool RenderDaemon::start(const std::string& socketPath)
+{
+    stop();
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+    {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    m_listenSocket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+    if (m_listenSocket < 0)
+        return false;
+
+    ::unlink(socketPath.c_str());
+
+    if (bind(m_listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || listen(m_listenSocket, 16) != 0 || !m_stopSignal.create())
+    {
+        int error = errno;
+        ::close(m_listenSocket);
+        m_listenSocket = -1;
+        errno = error;
+        return false;
+    }
+
+    m_socketPath = socketPath;
+    m_acceptThread = std::thread([this] { acceptClients(); });
+
+    return true;
+}
+
+void RenderDaemon::stop()
+{
+    if (m_listenSocket < 0)
+        return;
+
+    m_stopSignal.notify();
+    m_acceptThread.join();
+    m_stopSignal.release();
+
+    ::close(m_listenSocket);
+    ::unlink(m_socketPath.c_str());
+    m_listenSocket = -1;
+
+    std::lock_guard<std::mutex> lock(m_sessionLock);
+    m_sessions.clear();
+}
+
+size_t RenderDaemon::getNumSessions()
+{
+    std::lock_guard<std::mutex> lock(m_sessionLock);
+
+    size_t numSessions = 0;
+
+    for (auto& session : m_sessions)
+        if (!session->isFinished())
+            ++numSessions;
+
+    return numSessions;
+}
+
+void RenderDaemon::acceptClients()
+{
+    pollfd events[2] = { { m_listenSocket, POLLIN, 0 }, { m_stopSignal.getFileDescriptor(), POLLIN, 0 } };
+
+    while (true)
+    {
+        int result = poll(events, 2, -1);
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        if (result < 0 || events[1].revents != 0)
+            break;
+
+        if ((events[0].revents & POLLIN) == 0)
+            continue;
+
+        int client = accept4(m_listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+
+        if (client < 0)
+            continue;
+
+        std::lock_guard<std::mutex> lock(m_sessionLock);
+
+        m_sessions.erase(std::remove_if(m_sessions.begin(), m_sessions.end(),
+            [](const std::unique_ptr<Session>& session) { return session->isFinished(); }), m_sessions.end());
+
+        m_sessions.push_back(std::make_unique<Session>(client));
+    }
+}
+
+void RenderDaemon::prepareEngine(ChorusEngine<float>& engine, const ProcessSpec& spec)
+{
+    // the sessions render in real time with the interpolation the plugin uses for playback
+    engine.setLfoControlRate(lfoControlRate);
+    engine.setInterpolation(Interpolation::LINEAR);
+    engine.prepare(spec);
+}
+
+const std::array<size_t, 16> RenderDaemon::appliedParameters{ { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 20, 21 } };
+
+bool RenderDaemon::applyParameters(const ParameterSnapshot& snapshot, ChorusEngine<float>& engine)
+{
+    auto& values = snapshot.values;
+
+    // the values come from another process, nothing is applied unless every one of them is in range
+    for (auto parameter : appliedParameters)
+        if (!isInRange(parameter, values[parameter]))
+            return false;
+
+    engine.setRate(values[0]);
+    engine.setDepth(values[1]);
+    engine.setMix(values[2]);
+    engine.setDelayTime(values[3]);
+    engine.setDelayWidth(values[4]);
+    engine.setVoiceSpread(values[7]);
+    engine.setPhaseOffset(values[9], 0);
+    engine.setPhaseOffset(values[10], 1);
+    engine.setHighPass(values[11]);
+    engine.setLowPass(values[12]);
+    engine.setFilterBypass(values[13] >= 0.5f);
+    engine.setLatencyMode(static_cast<LatencyMode>(static_cast<int>(values[20])));
+    engine.setReferenceDelay(values[21]);
+
+    // mode, voices and lfo type are switched behind a short fade of the wet signal
+    engine.setDiscreteParameters(static_cast<Mode>(static_cast<int>(values[5])), voiceCounts[static_cast<size_t>(values[6])],
+        static_cast<WaveType>(static_cast<int>(values[8])));
+
+    return true;
+}
+
+//==============================================================================
+} // dingus
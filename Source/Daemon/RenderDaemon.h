@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    RenderDaemon.h
+    Created: 19 Oct 2026 11:31:48pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RenderTransport.h"
+#include "../DSP/ChorusEngine.h"
+
+namespace dingus
+{
+
+//==============================================================================
+/**
+    A local service that runs the chorus for other processes, eg. a game that wants to keep
+    the chorus out of its own audio thread.  Clients connect to a unix socket and each one
+    gets a session with its own ChorusEngine and thread.  The audio never goes through the
+    socket, the client writes a block into a slot of the shared memory and pushes the slot to
+    the request queue, the session processes the slot in place and pushes it to the response
+    queue.  Each side wakes the other with an eventfd, see RenderTransport.h.
+*/
+class RenderDaemon
+{
+public:
+    RenderDaemon();
+    ~RenderDaemon();
+
+    // starts listening on a unix socket at the given path, returns false if the socket can't be opened
+    // a socket file left at the path by a daemon that didn't stop cleanly is replaced
+    bool start(const std::string& socketPath);
+
+    // closes every session and stops listening
+    void stop();
+
+    // returns the number of connected clients
+    size_t getNumSessions();
+
+    // prepares an engine the same way the sessions do, eg. to check the output of the daemon
+    static void prepareEngine(ChorusEngine<float>& engine, const ProcessSpec& spec);
+
+    // applies the chorus and latency values of a snapshot to an engine, in the order of the plugin parameters
+    // the modulation, morph and gain parameters are left to the client
+    // returns false and leaves the engine alone if any of the applied values is out of range or not finite
+    static bool applyParameters(const ParameterSnapshot& snapshot, ChorusEngine<float>& engine);
+
+private:
+    class Session;
+
+    int m_listenSocket{ -1 };
+    std::string m_socketPath;
+
+    // wakes the accept thread when the daemon stops
+    EventSignal m_stopSignal;
+    std::thread m_acceptThread;
+
+    std::mutex m_sessionLock;
+    std::vector<std::unique_ptr<Session>> m_sessions;
+
+    // accepts clients until the daemon stops, finished sessions are removed when the next client connects
+    void acceptClients();
+
+    // the lfos are evaluated at this rate in Hz, the same as the plugin
+    static constexpr float lfoControlRate{ 2500.0f };
+
+    // the number of voices per channel for each choice of the voices parameter, the same as the plugin
+    static const std::array<size_t, 8> voiceCounts;
+
+    // the indices of the parameters applied to the engine, the chorus, lfo, filter and latency parameters
+    static const std::array<size_t, 16> appliedParameters;
+
+    RenderDaemon(const RenderDaemon&) = delete;
+    RenderDaemon& operator=(const RenderDaemon&) = delete;
+};
+
+//==============================================================================
+} // dingus
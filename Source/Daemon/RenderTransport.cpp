@@ -0,0 +1,400 @@
+/*
+  ==============================================================================
+
+    RenderTransport.cpp
+    Created: 19 Oct 2026 11:24:05pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "RenderTransport.h"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace dingus
+{
+
+namespace
+{
+    constexpr size_t cacheLine{ 64 };
+
+    size_t alignToCacheLine(size_t size)
+    {
+        return (size + cacheLine - 1) / cacheLine * cacheLine;
+    }
+
+    // the most slots and channels a session can ask for, this keeps a bad request from mapping too much memory
+    constexpr std::uint32_t maxSlots{ 64 };
+    constexpr std::uint32_t maxChannels{ 64 };
+    constexpr std::uint32_t maxBlockSize{ 65536 };
+}
+
+//==============================================================================
+size_t SlotQueue::getRequiredSize(size_t capacity)
+{
+    return alignToCacheLine(sizeof(Counters) + capacity * sizeof(std::uint32_t));
+}
+
+void SlotQueue::attach(void* memory, size_t capacity)
+{
+    m_counters = static_cast<Counters*>(memory);
+    m_indices = reinterpret_cast<std::uint32_t*>(static_cast<char*>(memory) + sizeof(Counters));
+    m_capacity = static_cast<std::uint32_t>(capacity);
+}
+
+void SlotQueue::clear() noexcept
+{
+    new (m_counters) Counters();
+    m_counters->writeCount.store(0, std::memory_order_relaxed);
+    m_counters->readCount.store(0, std::memory_order_relaxed);
+}
+
+bool SlotQueue::push(std::uint32_t index) noexcept
+{
+    auto writeCount = m_counters->writeCount.load(std::memory_order_relaxed);
+
+    if (writeCount - m_counters->readCount.load(std::memory_order_acquire) >= m_capacity)
+        return false;
+
+    m_indices[writeCount % m_capacity] = index;
+
+    // the release makes the index and the slot it points to visible before the new count
+    m_counters->writeCount.store(writeCount + 1, std::memory_order_release);
+    return true;
+}
+
+bool SlotQueue::pop(std::uint32_t& index) noexcept
+{
+    auto readCount = m_counters->readCount.load(std::memory_order_relaxed);
+
+    if (readCount == m_counters->writeCount.load(std::memory_order_acquire))
+        return false;
+
+    index = m_indices[readCount % m_capacity];
+    m_counters->readCount.store(readCount + 1, std::memory_order_release);
+    return true;
+}
+
+//==============================================================================
+RenderMemory::~RenderMemory()
+{
+    release();
+}
+
+RenderMemory::Layout RenderMemory::getLayout(const RenderRequest& request)
+{
+    Layout layout{};
+
+    layout.requestQueue = alignToCacheLine(sizeof(Header));
+    layout.responseQueue = layout.requestQueue + SlotQueue::getRequiredSize(request.numSlots);
+    layout.slots = layout.responseQueue + SlotQueue::getRequiredSize(request.numSlots);
+    layout.channelStride = alignToCacheLine(request.maxBlockSize * sizeof(float));
+    layout.slotStride = alignToCacheLine(sizeof(RenderSlot)) + request.numChannels * layout.channelStride;
+    layout.size = layout.slots + request.numSlots * layout.slotStride;
+
+    return layout;
+}
+
+bool RenderMemory::create(const RenderRequest& request)
+{
+    release();
+
+    if (request.numSlots == 0 || request.numSlots > maxSlots || request.numChannels == 0 || request.numChannels > maxChannels
+        || request.maxBlockSize == 0 || request.maxBlockSize > maxBlockSize || request.sampleRate <= 0.0)
+    {
+        errno = EINVAL;
+        return false;
+    }
+
+    auto layout = getLayout(request);
+    int fd = memfd_create("chorus-render", MFD_CLOEXEC);
+
+    if (fd < 0)
+        return false;
+
+    if (ftruncate(fd, static_cast<off_t>(layout.size)) != 0 || !map(fd, layout.size, request))
+    {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        return false;
+    }
+
+    auto* header = reinterpret_cast<Header*>(m_data);
+    header->magic = renderMagic;
+    header->version = renderVersion;
+    header->numChannels = request.numChannels;
+    header->maxBlockSize = request.maxBlockSize;
+    header->numSlots = request.numSlots;
+    header->reserved = 0;
+    header->sampleRate = request.sampleRate;
+
+    m_requestQueue.clear();
+    m_responseQueue.clear();
+
+    for (size_t slot = 0; slot < request.numSlots; ++slot)
+        new (&getSlot(slot)) RenderSlot();
+
+    return true;
+}
+
+bool RenderMemory::attach(int fd, size_t size, const RenderRequest& request)
+{
+    release();
+
+    if (size != getLayout(request).size || !map(fd, size, request))
+    {
+        ::close(fd);
+        errno = EINVAL;
+        return false;
+    }
+
+    auto* header = reinterpret_cast<const Header*>(m_data);
+
+    if (header->magic != renderMagic || header->version != renderVersion || header->numChannels != request.numChannels
+        || header->maxBlockSize != request.maxBlockSize || header->numSlots != request.numSlots)
+    {
+        release();
+        errno = EINVAL;
+        return false;
+    }
+
+    return true;
+}
+
+bool RenderMemory::map(int fd, size_t size, const RenderRequest& request)
+{
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    m_fd = fd;
+    m_data = static_cast<char*>(data);
+    m_layout = getLayout(request);
+    m_request = request;
+
+    m_requestQueue.attach(m_data + m_layout.requestQueue, request.numSlots);
+    m_responseQueue.attach(m_data + m_layout.responseQueue, request.numSlots);
+
+    return true;
+}
+
+void RenderMemory::release()
+{
+    if (m_data != nullptr)
+        munmap(m_data, m_layout.size);
+
+    if (m_fd >= 0)
+        ::close(m_fd);
+
+    m_data = nullptr;
+    m_fd = -1;
+}
+
+int RenderMemory::getFileDescriptor() const
+{
+    return m_fd;
+}
+
+size_t RenderMemory::getSize() const
+{
+    return m_layout.size;
+}
+
+RenderSlot& RenderMemory::getSlot(size_t slot) const
+{
+    return *reinterpret_cast<RenderSlot*>(m_data + m_layout.slots + slot * m_layout.slotStride);
+}
+
+float* RenderMemory::getChannel(size_t slot, size_t channel) const
+{
+    return reinterpret_cast<float*>(m_data + m_layout.slots + slot * m_layout.slotStride
+        + alignToCacheLine(sizeof(RenderSlot)) + channel * m_layout.channelStride);
+}
+
+SlotQueue& RenderMemory::getRequestQueue()
+{
+    return m_requestQueue;
+}
+
+SlotQueue& RenderMemory::getResponseQueue()
+{
+    return m_responseQueue;
+}
+
+size_t RenderMemory::getNumChannels() const
+{
+    return m_request.numChannels;
+}
+
+size_t RenderMemory::getMaxBlockSize() const
+{
+    return m_request.maxBlockSize;
+}
+
+size_t RenderMemory::getNumSlots() const
+{
+    return m_request.numSlots;
+}
+
+double RenderMemory::getSampleRate() const
+{
+    return m_request.sampleRate;
+}
+
+//==============================================================================
+EventSignal::~EventSignal()
+{
+    release();
+}
+
+bool EventSignal::create()
+{
+    release();
+    m_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    return m_fd >= 0;
+}
+
+void EventSignal::attach(int fd)
+{
+    release();
+    m_fd = fd;
+}
+
+void EventSignal::release()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+
+    m_fd = -1;
+}
+
+int EventSignal::getFileDescriptor() const
+{
+    return m_fd;
+}
+
+void EventSignal::notify() noexcept
+{
+    std::uint64_t value = 1;
+    ssize_t result = ::write(m_fd, &value, sizeof(value));
+    (void)result;
+}
+
+void EventSignal::consume() noexcept
+{
+    // the eventfd is non blocking so this only clears the counter
+    std::uint64_t value = 0;
+    ssize_t result = ::read(m_fd, &value, sizeof(value));
+    (void)result;
+}
+
+//==============================================================================
+bool sendMessage(int socket, const void* data, size_t size, const int* fds, size_t numFds)
+{
+    iovec vector{ const_cast<void*>(data), size };
+
+    msghdr message{};
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+
+    // the control buffer has to be aligned for cmsghdr
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 4)];
+
+    if (numFds > 0)
+    {
+        if (numFds > 4)
+        {
+            errno = EINVAL;
+            return false;
+        }
+
+        std::memset(control, 0, sizeof(control));
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * numFds);
+
+        auto* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int) * numFds);
+        std::memcpy(CMSG_DATA(header), fds, sizeof(int) * numFds);
+    }
+
+    ssize_t result;
+
+    do
+    {
+        result = sendmsg(socket, &message, MSG_NOSIGNAL);
+    } while (result < 0 && errno == EINTR);
+
+    return result == static_cast<ssize_t>(size);
+}
+
+bool receiveMessage(int socket, void* data, size_t size, int* fds, size_t numFds)
+{
+    for (size_t i = 0; i < numFds; ++i)
+        fds[i] = -1;
+
+    iovec vector{ data, size };
+
+    msghdr message{};
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 4)];
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t result;
+
+    do
+    {
+        result = recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+    } while (result < 0 && errno == EINTR);
+
+    // take the descriptors even if the message is wrong so they can be closed
+    size_t numReceived = 0;
+
+    for (auto* header = result > 0 ? CMSG_FIRSTHDR(&message) : nullptr; header != nullptr; header = CMSG_NXTHDR(&message, header))
+    {
+        if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS)
+            continue;
+
+        size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        auto* received = reinterpret_cast<const int*>(CMSG_DATA(header));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            int fd;
+            std::memcpy(&fd, received + i, sizeof(int));
+
+            if (numReceived < numFds)
+                fds[numReceived++] = fd;
+            else
+                ::close(fd);
+        }
+    }
+
+    if (result != static_cast<ssize_t>(size))
+    {
+        for (size_t i = 0; i < numReceived; ++i)
+        {
+            ::close(fds[i]);
+            fds[i] = -1;
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+} // dingus
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    RenderTransport.h
+    Created: 19 Oct 2026 11:24:05pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../ParameterSnapshot.h"
+
+namespace dingus
+{
+
+//==============================================================================
+// the render daemon exchanges audio with its clients through shared memory, see RenderDaemon
+// a client connects to the daemon's unix socket and sends a RenderRequest, the daemon replies with
+// a RenderReply and passes the shared memory and two eventfds with the reply
+// after that the control socket is only used to notice when either side goes away
+
+constexpr std::uint32_t renderMagic{ 0x44524843 }; // "CHRD"
+// the version changes whenever the layout of the shared memory does, eg. when parameters are added
+constexpr std::uint32_t renderVersion{ 2 };
+
+// the settings of a session, sent by the client when it connects
+struct RenderRequest
+{
+    std::uint32_t magic{ renderMagic };
+    std::uint32_t version{ renderVersion };
+    std::uint32_t numChannels{ 2 };
+    std::uint32_t maxBlockSize{ 512 };
+    std::uint32_t numSlots{ 4 };
+    std::uint32_t reserved{ 0 };
+    double sampleRate{ 48000.0 };
+};
+
+// the answer of the daemon, the status is 0 if the session was opened
+struct RenderReply
+{
+    std::uint32_t magic{ renderMagic };
+    std::int32_t status{ 0 };
+    std::int32_t latency{ 0 };
+    std::uint32_t reserved{ 0 };
+    std::uint64_t memorySize{ 0 };
+};
+
+//==============================================================================
+// a block of audio in the shared memory, the samples of each channel follow the slot
+// the client fills the slot with the input and the daemon replaces it with the output in place
+struct RenderSlot
+{
+    std::uint32_t numSamples{ 0 };
+
+    // the parameters are applied by the daemon when the serial is different from the last block
+    std::uint32_t parameterSerial{ 0 };
+    ParameterSnapshot parameters;
+
+    // the latency of the engine in samples after the block, set by the daemon
+    std::int32_t latency{ 0 };
+};
+
+//==============================================================================
+/**
+    A single producer single consumer queue of slot indices that lives in the shared memory.
+    The counters only ever increase and wrap around, the slot is the counter modulo the capacity.
+    The producer and consumer counters are on separate cache lines so the two processes
+    don't fight over the same line.
+*/
+class SlotQueue
+{
+public:
+    // the counters at the start of the queue, followed by the capacity indices
+    struct Counters
+    {
+        alignas(64) std::atomic<std::uint32_t> writeCount;
+        alignas(64) std::atomic<std::uint32_t> readCount;
+    };
+
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "the shared counters have to be lock free to work across processes");
+
+    // returns the size in bytes the queue needs in the shared memory
+    static size_t getRequiredSize(size_t capacity);
+
+    // uses a queue at the given memory, clear() has to be called once by the process that creates it
+    void attach(void* memory, size_t capacity);
+
+    // empties the queue
+    void clear() noexcept;
+
+    // adds an index, returns false if the queue is full, only one thread may push
+    bool push(std::uint32_t index) noexcept;
+
+    // takes the oldest index, returns false if the queue is empty, only one thread may pop
+    bool pop(std::uint32_t& index) noexcept;
+
+private:
+    Counters* m_counters{ nullptr };
+    std::uint32_t* m_indices{ nullptr };
+    std::uint32_t m_capacity{ 0 };
+};
+
+//==============================================================================
+/**
+    This class maps the shared memory of a session.  The memory holds a header with the
+    settings of the session, the request queue from the client to the daemon, the response
+    queue back to the client and the slots.  Every part starts on a cache line and each
+    channel of a slot is padded to a cache line.
+*/
+class RenderMemory
+{
+public:
+    RenderMemory() = default;
+    ~RenderMemory();
+
+    // creates and maps an anonymous shared memory file for the settings of a request
+    bool create(const RenderRequest& request);
+
+    // maps the shared memory passed by the daemon and checks that it matches the request
+    // this takes ownership of the file descriptor
+    bool attach(int fd, size_t size, const RenderRequest& request);
+
+    // unmaps the memory and closes the file
+    void release();
+
+    // returns the file descriptor of the memory, to pass it to the client
+    int getFileDescriptor() const;
+
+    // returns the size of the mapped memory in bytes
+    size_t getSize() const;
+
+    // returns one of the slots
+    RenderSlot& getSlot(size_t slot) const;
+
+    // returns the samples of a channel of a slot
+    float* getChannel(size_t slot, size_t channel) const;
+
+    // the queue of slots sent to the daemon and the queue of processed slots sent back
+    SlotQueue& getRequestQueue();
+    SlotQueue& getResponseQueue();
+
+    size_t getNumChannels() const;
+    size_t getMaxBlockSize() const;
+    size_t getNumSlots() const;
+    double getSampleRate() const;
+
+private:
+    // the header at the start of the memory
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t numChannels;
+        std::uint32_t maxBlockSize;
+        std::uint32_t numSlots;
+        std::uint32_t reserved;
+        double sampleRate;
+    };
+
+    // the offsets of each part of the memory in bytes
+    struct Layout
+    {
+        size_t requestQueue;
+        size_t responseQueue;
+        size_t slots;
+        size_t slotStride;
+        size_t channelStride;
+        size_t size;
+    };
+
+    static Layout getLayout(const RenderRequest& request);
+
+    // maps the file and finds the parts of the memory
+    bool map(int fd, size_t size, const RenderRequest& request);
+
+    int m_fd{ -1 };
+    char* m_data{ nullptr };
+    Layout m_layout{};
+    RenderRequest m_request;
+
+    SlotQueue m_requestQueue;
+    SlotQueue m_responseQueue;
+};
+
+//==============================================================================
+/**
+    A wrapper for an eventfd used to wake the other side of the session.  Notifying
+    adds to the counter of the eventfd, the other side polls the eventfd together with the
+    control socket so it also wakes up when the session is closed.  The queues are always
+    checked after waking so a notification is never lost, a stale one only wakes the other
+    side when there's nothing new to read.
+*/
+class EventSignal
+{
+public:
+    EventSignal() = default;
+    ~EventSignal();
+
+    // creates a new eventfd
+    bool create();
+
+    // uses an eventfd passed by the other side, this takes ownership of the file descriptor
+    void attach(int fd);
+
+    // closes the eventfd
+    void release();
+
+    int getFileDescriptor() const;
+
+    // wakes the side waiting on the eventfd
+    void notify() noexcept;
+
+    // clears the counter after the eventfd was signalled
+    void consume() noexcept;
+
+private:
+    int m_fd{ -1 };
+};
+
+//==============================================================================
+// sends a message over a unix socket along with some file descriptors, returns false on failure
+bool sendMessage(int socket, const void* data, size_t size, const int* fds, size_t numFds);
+
+// receives a message and the file descriptors sent with it, the unused descriptors are set to -1
+// returns false if the socket was closed or the message doesn't have the expected size
+bool receiveMessage(int socket, void* data, size_t size, int* fds, size_t numFds);
+
+//==============================================================================
+} // dingus
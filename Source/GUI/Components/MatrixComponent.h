@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    MatrixComponent.h
+    Created: 20 Oct 2026 3:26:44am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+
+//==============================================================================
+/*
+    This matrix component holds the routes of the mod matrix that aren't tied to the
+    mod or envelope tabs, each row has a source, a target and a depth.  The second lfo 
+    and the random source are set under the routes.
+*/
+class MatrixComponent : public juce::Component
+{
+public:
+    MatrixComponent(juce::AudioProcessorValueTreeState& vts) :
+        parameters(vts)
+    {
+        using namespace juce;
+
+        // Routes
+        for (size_t route = 0; route < rows.size(); ++route)
+        {
+            auto& row = rows[route];
+            auto& ids = routeIDs[route];
+
+            // the items are in the order of the choices, starting at 1
+            row.sourceBox.addItemList({ "LFO 1", "LFO 2", "Random", "Macro", "Envelope" }, 1);
+            row.sourceBox.setJustificationType(Justification::centred);
+            row.sourceAttach.reset(new AudioProcessorValueTreeState::ComboBoxAttachment(parameters, ids[0], row.sourceBox));
+            addAndMakeVisible(&row.sourceBox);
+
+            row.targetBox.addItemList({ "None", "Rate", "Depth", "Mix", "Delay", "Width", "Spread", 
+                "Phase L", "Phase R", "High Pass", "Low Pass", "Input", "Output" }, 1);
+            row.targetBox.setJustificationType(Justification::centred);
+            row.targetAttach.reset(new AudioProcessorValueTreeState::ComboBoxAttachment(parameters, ids[1], row.targetBox));
+            addAndMakeVisible(&row.targetBox);
+
+            row.depthSlider.setSliderStyle(Slider::LinearHorizontal);
+            row.depthSlider.setTextBoxStyle(Slider::TextBoxRight, false, 50, 20);
+            row.depthAttach.reset(new AudioProcessorValueTreeState::SliderAttachment(parameters, ids[2], row.depthSlider));
+            addAndMakeVisible(&row.depthSlider);
+        }
+
+        // Sources
+
+        // lfo 2 rate slider
+        lfoRateSlider.setSliderStyle(Slider::LinearHorizontal);
+        lfoRateSlider.setTextBoxStyle(Slider::TextBoxRight, false, 50, 20);
+        lfoRateAttach.reset(new AudioProcessorValueTreeState::SliderAttachment(parameters, "39_lfo2_rate", lfoRateSlider));
+        addAndMakeVisible(&lfoRateSlider);
+
+        // lfo 2 sine button, this is connected to the lfo 2 type parameter
+        lfoSineButton.setButtonText("sine");
+        lfoSineAttach.reset(new AudioProcessorValueTreeState::ButtonAttachment(parameters, "40_lfo2_type", lfoSineButton));
+        addAndMakeVisible(&lfoSineButton);
+
+        // random rate slider
+        randomRateSlider.setSliderStyle(Slider::LinearHorizontal);
+        randomRateSlider.setTextBoxStyle(Slider::TextBoxRight, false, 50, 20);
+        randomRateAttach.reset(new AudioProcessorValueTreeState::SliderAttachment(parameters, "41_random_rate", randomRateSlider));
+        addAndMakeVisible(&randomRateSlider);
+
+        // Labels
+
+        // lfo 2 rate label
+        lfoRateLabel.setText("LFO 2", dontSendNotification);
+        lfoRateLabel.attachToComponent(&lfoRateSlider, true);
+        addAndMakeVisible(&lfoRateLabel);
+
+        // random rate label
+        randomRateLabel.setText("Random", dontSendNotification);
+        randomRateLabel.attachToComponent(&randomRateSlider, true);
+        addAndMakeVisible(&randomRateLabel);
+    }
+
+    ~MatrixComponent() override
+    {
+    }
+
+    void paint(juce::Graphics& /*g*/) override
+    {
+
+    }
+
+    void resized() override
+    {
+        juce::Rectangle<int> area = getLocalBounds().reduced(padding);
+
+        int rowHeight = area.getHeight() / static_cast<int>(rows.size() + 1);
+        int componentWidth = area.getWidth() / 3;
+
+        for (auto& row : rows)
+        {
+            juce::Rectangle<int> rowArea = area.removeFromTop(rowHeight).reduced(0, padding / 4);
+            row.sourceBox.setBounds(rowArea.removeFromLeft(componentWidth).reduced(padding / 2, 0));
+            row.targetBox.setBounds(rowArea.removeFromLeft(componentWidth).reduced(padding / 2, 0));
+            row.depthSlider.setBounds(rowArea);
+        }
+
+        // the labels are attached on the left of the sliders
+        juce::Rectangle<int> sourceArea = area.reduced(0, padding / 4);
+        sourceArea.removeFromLeft(componentWidth / 3);
+        lfoRateSlider.setBounds(sourceArea.removeFromLeft(componentWidth));
+        lfoSineButton.setBounds(sourceArea.removeFromLeft(componentWidth / 2));
+        sourceArea.removeFromLeft(componentWidth / 3);
+        randomRateSlider.setBounds(sourceArea);
+    }
+
+private:
+    juce::AudioProcessorValueTreeState& parameters;
+
+    const int padding{ 10 };
+
+    struct Row
+    {
+        juce::ComboBox sourceBox;
+        juce::ComboBox targetBox;
+        juce::Slider depthSlider;
+
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> sourceAttach;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> targetAttach;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> depthAttach;
+    };
+
+    // the source, target and depth parameters of each row
+    const std::array<std::array<const char*, 3>, 3> routeIDs
+    { {
+        { "30_route1_source", "31_route1_target", "32_route1_depth" },
+        { "33_route2_source", "34_route2_target", "35_route2_depth" },
+        { "36_route3_source", "37_route3_target", "38_route3_depth" }
+    } };
+
+    std::array<Row, 3> rows;
+
+    juce::Slider lfoRateSlider;
+    juce::Slider randomRateSlider;
+    juce::ToggleButton lfoSineButton;
+
+    juce::Label lfoRateLabel;
+    juce::Label randomRateLabel;
+
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> lfoRateAttach;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> lfoSineAttach;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> randomRateAttach;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MatrixComponent)
+};
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    MorphComponent.h
+    Created: 20 Oct 2026 2:51:09am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <functional>
+#include <memory>
+#include "../../ParameterSnapshot.h"
+
+//==============================================================================
+/*
+    This morph component holds the controls for the preset morph.  The store buttons 
+    save the current parameters as one of the snapshots and the position morphs between them.
+*/
+class MorphComponent : public juce::Component
+{
+public:
+    MorphComponent(juce::AudioProcessorValueTreeState& vts) :
+        parameters(vts)
+    {
+        using namespace juce;
+        // Buttons
+
+        // enabled
+        enabledButton.setButtonText("on");
+        enabledAttach.reset(new AudioProcessorValueTreeState::ButtonAttachment(parameters, "23_morph_enabled", enabledButton));
+        addAndMakeVisible(&enabledButton);
+
+        // store buttons, one for each snapshot
+        for (size_t slot = 0; slot < storeButtons.size(); ++slot)
+        {
+            storeButtons[slot].setButtonText("Store " + String(static_cast<int>(slot) + 1));
+            storeButtons[slot].setConnectedEdges(slot == 0 ? 2 : (slot + 1 == storeButtons.size() ? 1 : 3));
+            storeButtons[slot].onClick = [this, slot] { if (onStore != nullptr) onStore(slot); };
+            addAndMakeVisible(&storeButtons[slot]);
+        }
+
+        // clear button
+        clearButton.onClick = [this] { if (onClear != nullptr) onClear(); };
+        addAndMakeVisible(&clearButton);
+
+        // Sliders
+
+        // position slider
+        positionSlider.setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
+        positionSlider.setTextBoxStyle(Slider::TextBoxBelow, false, 60, 20);
+        positionAttach.reset(new AudioProcessorValueTreeState::SliderAttachment(parameters, "22_morph_position", positionSlider));
+        addAndMakeVisible(&positionSlider);
+
+        // Labels
+
+        // position label
+        positionLabel.setText("Position", dontSendNotification);
+        positionLabel.setJustificationType(Justification::centred);
+        positionLabel.attachToComponent(&positionSlider, false);
+        addAndMakeVisible(&positionLabel);
+
+        // snapshot label
+        snapshotLabel.setJustificationType(Justification::centred);
+        setNumSnapshots(0);
+        addAndMakeVisible(&snapshotLabel);
+    }
+
+    ~MorphComponent() override
+    {
+    }
+
+    // called with the slot of a store button
+    std::function<void(size_t)> onStore;
+
+    // called by the clear button
+    std::function<void()> onClear;
+
+    // shows how many snapshots the position morphs between
+    void setNumSnapshots(size_t numSnapshots)
+    {
+        snapshotLabel.setText(numSnapshots < 2 ? "Store 2 snapshots to morph" : juce::String(static_cast<int>(numSnapshots)) + " snapshots", 
+            juce::dontSendNotification);
+    }
+
+    void paint(juce::Graphics& /*g*/) override
+    {
+
+    }
+
+    void resized() override
+    {
+        juce::Rectangle<int> area = getLocalBounds().reduced(padding);
+
+        int labelArea = padding * 2;
+        area.removeFromTop(labelArea);
+
+        int componentWidth = area.getWidth() / 3;
+        int componentHeight = area.getHeight();
+
+        positionSlider.setBounds(area.removeFromLeft(componentWidth));
+        enabledButton.setBounds(area.removeFromLeft(componentWidth / 2));
+
+        // the store buttons are in a row with the clear button and the label under them
+        juce::Rectangle<int> buttonArea = area.removeFromTop(componentHeight / 3);
+        int buttonWidth = buttonArea.getWidth() / static_cast<int>(storeButtons.size());
+
+        for (auto& button : storeButtons)
+            button.setBounds(buttonArea.removeFromLeft(buttonWidth).reduced(0, padding / 2));
+
+        clearButton.setBounds(area.removeFromTop(componentHeight / 3).reduced(padding, padding / 2));
+        snapshotLabel.setBounds(area);
+    }
+
+private:
+    juce::AudioProcessorValueTreeState& parameters;
+
+    const int padding{ 10 };
+
+    juce::ToggleButton enabledButton;
+
+    std::array<juce::TextButton, dingus::maxMorphSnapshots> storeButtons;
+    juce::TextButton clearButton{ "Clear" };
+
+    juce::Slider positionSlider;
+
+    juce::Label positionLabel;
+    juce::Label snapshotLabel;
+
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> enabledAttach;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> positionAttach;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MorphComponent)
+};
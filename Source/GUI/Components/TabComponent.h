@@ -16,6 +16,8 @@
 #include "LfoComponent.h"
 #include "FilterComponent.h"
 #include "ModComponent.h"
+#include "MatrixComponent.h"
+#include "MorphComponent.h"
 
 //==============================================================================
 /*
@@ -27,7 +29,7 @@ class TabComponent : public juce::Component
 public:
     TabComponent(juce::AudioProcessorValueTreeState& vts) :
         parameters(vts), tabbedComponent(juce::TabbedButtonBar::Orientation::TabsAtTop),
-        voiceComponent(vts), lfoComponent(vts), filterComponent(vts), modComponent(vts)
+        voiceComponent(vts), lfoComponent(vts), filterComponent(vts), modComponent(vts), matrixComponent(vts), morphComponent(vts)
     {
         tabbedComponent.setOutline(0);
         tabbedComponent.setIndent(0);
@@ -35,6 +37,8 @@ public:
         tabbedComponent.addTab("LFO", juce::Colours::transparentBlack, &lfoComponent, true, 1);
         tabbedComponent.addTab("Filter", juce::Colours::transparentBlack, &filterComponent, true, 2);
         tabbedComponent.addTab("Mod", juce::Colours::transparentBlack, &modComponent, true, 3);
+        tabbedComponent.addTab("Matrix", juce::Colours::transparentBlack, &matrixComponent, true, 4);
+        tabbedComponent.addTab("Morph", juce::Colours::transparentBlack, &morphComponent, true, 5);
         addAndMakeVisible(&tabbedComponent);
     }
 
@@ -57,6 +61,12 @@ public:
         tabbedComponent.setBounds(area);
     }
 
+    // the morph controls need the processor to store the snapshots
+    MorphComponent& getMorphComponent()
+    {
+        return morphComponent;
+    }
+
 private:
     juce::AudioProcessorValueTreeState& parameters;
 
@@ -68,6 +78,8 @@ private:
     LfoComponent lfoComponent;
     FilterComponent filterComponent;
     ModComponent modComponent;
+    MatrixComponent matrixComponent;
+    MorphComponent morphComponent;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TabComponent)
 };
\ No newline at end of file
@@ -35,6 +35,13 @@ public:
         modeAttach.reset(new AudioProcessorValueTreeState::ComboBoxAttachment(parameters, "05_chorus_mode", modeBox));
         addAndMakeVisible(&modeBox);
 
+        // latency combobox
+        latencyBox.addItem("Zero Latency", 1);
+        latencyBox.addItem("Aligned", 2);
+        latencyBox.setJustificationType(Justification::centred);
+        latencyAttach.reset(new AudioProcessorValueTreeState::ComboBoxAttachment(parameters, "20_latency_mode", latencyBox));
+        addAndMakeVisible(&latencyBox);
+
         // Sliders
 
         // voice slider
@@ -49,6 +56,12 @@ public:
         spreadAttach.reset(new AudioProcessorValueTreeState::SliderAttachment(parameters, "07_chorus_spread", spreadSlider));
         addAndMakeVisible(&spreadSlider);
 
+        // align slider
+        alignSlider.setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
+        alignSlider.setTextBoxStyle(Slider::TextBoxBelow, false, 60, 20);
+        alignAttach.reset(new AudioProcessorValueTreeState::SliderAttachment(parameters, "21_latency_reference", alignSlider));
+        addAndMakeVisible(&alignSlider);
+
         // Labels
 
         // mode label
@@ -68,6 +81,12 @@ public:
         spreadLabel.setJustificationType(Justification::centred);
         spreadLabel.attachToComponent(&spreadSlider, false);
         addAndMakeVisible(&spreadSlider);
+
+        // align label
+        alignLabel.setText("Align", dontSendNotification);
+        alignLabel.setJustificationType(Justification::centred);
+        alignLabel.attachToComponent(&alignSlider, false);
+        addAndMakeVisible(&alignLabel);
     }
 
     ~VoiceComponent() override
@@ -86,14 +105,21 @@ public:
         int labelArea = padding * 2;
         area.removeFromTop(labelArea);
 
-        int componentWidth = area.getWidth() / 3;
+        int componentWidth = area.getWidth() / 4;
         int componentHeight = area.getHeight();
 
         voiceSlider.setBounds(area.removeFromLeft(componentWidth));
         spreadSlider.setBounds(area.removeFromLeft(componentWidth));
+        alignSlider.setBounds(area.removeFromLeft(componentWidth));
+
+        // mode and latency share the last column
+        juce::Rectangle<int> boxArea = area.removeFromLeft(componentWidth);
 
         modeBox.setSize(componentWidth, componentHeight / 4);
-        modeBox.setBoundsToFit(area.removeFromLeft(componentWidth), juce::Justification::centred, true);
+        modeBox.setBoundsToFit(boxArea.removeFromTop(componentHeight / 2), juce::Justification::centred, true);
+
+        latencyBox.setSize(componentWidth, componentHeight / 4);
+        latencyBox.setBoundsToFit(boxArea, juce::Justification::centred, true);
     }
 
 private:
@@ -102,16 +128,21 @@ private:
     const int padding{ 10 };
 
     juce::ComboBox modeBox;
+    juce::ComboBox latencyBox;
     juce::Slider voiceSlider;
     juce::Slider spreadSlider;
+    juce::Slider alignSlider;
 
     juce::Label modeLabel;
     juce::Label voiceLabel;
     juce::Label spreadLabel;
+    juce::Label alignLabel;
 
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> modeAttach;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> latencyAttach;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> voiceAttach;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> spreadAttach;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> alignAttach;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoiceComponent)
 };
\ No newline at end of file
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 19 Oct 2026 2:37:08pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace dingus
+{
+
+// the number of plugin parameters, this has to match the parameter IDs of the processor
+constexpr size_t numParameters{ 42 };
+
+// the number of snapshots the preset morph can hold, these are saved with the state
+constexpr size_t maxMorphSnapshots{ 4 };
+
+//==============================================================================
+// the value of every plugin parameter in its real range, in the order of the parameter IDs
+struct ParameterSnapshot
+{
+    std::array<float, numParameters> values{};
+};
+
+// the range of a plugin parameter in its real values, the discrete parameters hold the index of a choice
+struct ParameterRange
+{
+    float minimum;
+    float maximum;
+    float defaultValue;
+    bool isDiscrete;
+};
+
+// in the order of the parameter IDs, this has to match the parameter layout of the processor
+// values that come from outside the plugin, eg. the shared memory of the daemon, are checked against this
+const std::array<ParameterRange, numParameters> parameterRanges
+{ {
+    { 0.01f, 20.0f, 2.0f, false },          // rate
+    { 0.0f, 1.0f, 0.5f, false },            // depth
+    { 0.0f, 1.0f, 1.0f, false },            // mix
+    { 0.005f, 0.075f, 0.005f, false },      // delay
+    { 0.0f, 1.0f, 0.0f, false },            // width
+    { 0.0f, 3.0f, 0.0f, true },             // mode
+    { 0.0f, 7.0f, 0.0f, true },             // voices
+    { 0.0f, 1.0f, 1.0f, false },            // spread
+    { 0.0f, 1.0f, 0.0f, true },             // lfo type
+    { 0.0f, 1.0f, 0.5f, false },            // phase left
+    { 0.0f, 1.0f, 0.0f, false },            // phase right
+    { 20.0f, 20000.0f, 20.0f, false },      // high pass
+    { 20.0f, 20000.0f, 20000.0f, false },   // low pass
+    { 0.0f, 1.0f, 0.0f, true },             // filter bypass
+    { 0.0f, 4.0f, 0.0f, true },             // mod target
+    { 0.0f, 1.0f, 0.0f, true },             // mod type
+    { 0.01f, 10.0f, 2.0f, false },          // mod rate
+    { 0.0f, 1.0f, 0.0f, false },            // mod depth
+    { 0.0f, 1.0f, 1.0f, false },            // input gain
+    { 0.0f, 1.0f, 1.0f, false },            // output gain
+    { 0.0f, 1.0f, 0.0f, true },             // latency mode
+    { 0.001f, 0.075f, 0.005f, false },      // latency reference
+    { 0.0f, 1.0f, 0.0f, false },            // morph position
+    { 0.0f, 1.0f, 0.0f, true },             // morph enabled
+    { 0.0f, 1.0f, 0.0f, false },            // macro
+    { 0.0f, 4.0f, 1.0f, true },             // envelope target
+    { -1.0f, 1.0f, 0.0f, false },           // envelope depth
+    { 1.0f, 100.0f, 10.0f, false },         // envelope attack
+    { 10.0f, 1000.0f, 150.0f, false },      // envelope release
+    { 0.0f, 1.0f, 1.0f, true },             // envelope type
+    { 0.0f, 4.0f, 1.0f, true },             // route 1 source
+    { 0.0f, 12.0f, 0.0f, true },            // route 1 target
+    { -1.0f, 1.0f, 0.0f, false },           // route 1 depth
+    { 0.0f, 4.0f, 2.0f, true },             // route 2 source
+    { 0.0f, 12.0f, 0.0f, true },            // route 2 target
+    { -1.0f, 1.0f, 0.0f, false },           // route 2 depth
+    { 0.0f, 4.0f, 3.0f, true },             // route 3 source
+    { 0.0f, 12.0f, 0.0f, true },            // route 3 target
+    { -1.0f, 1.0f, 0.0f, false },           // route 3 depth
+    { 0.01f, 10.0f, 0.5f, false },          // lfo 2 rate
+    { 0.0f, 1.0f, 0.0f, true },             // lfo 2 type
+    { 0.1f, 20.0f, 1.0f, false }            // random rate
+} };
+
+// returns true if a value is in the range of a parameter, this is false for nan and inf
+inline bool isInRange(size_t parameter, float value)
+{
+    auto& range = parameterRanges[parameter];
+    return value >= range.minimum && value <= range.maximum;
+}
+
+// returns the default values of every parameter
+inline ParameterSnapshot getDefaultSnapshot()
+{
+    ParameterSnapshot snapshot;
+
+    for (size_t i = 0; i < numParameters; ++i)
+        snapshot.values[i] = parameterRanges[i].defaultValue;
+
+    return snapshot;
+}
+
+//==============================================================================
+/**
+    A lock free triple buffer used to hand complete values from one writing thread
+    to one reading thread, eg. a snapshot of the parameters from the message thread
+    to the audio thread.  The writer fills the write buffer and publishes it, the reader
+    calls update() to swap in the latest published buffer.  Neither side ever waits 
+    and the reader never sees a partly written value.
+*/
+template <typename Type>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // returns the buffer the writer can fill, only one thread may write
+    Type& getWriteBuffer() noexcept
+    {
+        return m_buffers[m_writeIndex];
+    }
+
+    // publishes the write buffer, the writer takes the previous middle buffer to write next
+    void publish() noexcept
+    {
+        m_writeIndex = m_middle.exchange(m_writeIndex | freshBit) & indexMask;
+    }
+
+    // swaps in the latest published buffer, returns true if there was a new one
+    // only one thread may read
+    bool update() noexcept
+    {
+        if ((m_middle.load() & freshBit) == 0)
+            return false;
+
+        m_readIndex = m_middle.exchange(m_readIndex) & indexMask;
+        return true;
+    }
+
+    // returns the buffer swapped in by the last update()
+    const Type& getReadBuffer() const noexcept
+    {
+        return m_buffers[m_readIndex];
+    }
+
+private:
+    static constexpr unsigned int freshBit{ 4 };
+    static constexpr unsigned int indexMask{ 3 };
+
+    std::array<Type, 3> m_buffers{};
+    unsigned int m_writeIndex{ 0 };
+    unsigned int m_readIndex{ 1 };
+    std::atomic<unsigned int> m_middle{ 2 };
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+};
+//==============================================================================
+
+} // dingus
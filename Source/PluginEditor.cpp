@@ -19,6 +19,19 @@ ChoruspluginAudioProcessorEditor::ChoruspluginAudioProcessorEditor (Chorusplugin
     addAndMakeVisible(&mainComponent);
     addAndMakeVisible(&titleComponent);
     addAndMakeVisible(&tabComponent);
+
+    // the snapshots are stored on the message thread, the processor passes them to the audio thread
+    auto& morphComponent = tabComponent.getMorphComponent();
+    morphComponent.onStore = [this](size_t slot) { audioProcessor.storeMorphSnapshot(slot); timerCallback(); };
+    morphComponent.onClear = [this] { audioProcessor.clearMorphSnapshots(); timerCallback(); };
+    morphComponent.setNumSnapshots(displayedMorphSnapshots = audioProcessor.getNumMorphSnapshots());
+
+    qualityLabel.setJustificationType(juce::Justification::centredRight);
+    qualityLabel.setFont(juce::Font(12.0f));
+    updateQualityLabel();
+    addAndMakeVisible(&qualityLabel);
+
+    startTimerHz(4);
 }
 
 ChoruspluginAudioProcessorEditor::~ChoruspluginAudioProcessorEditor()
@@ -44,4 +57,34 @@ void ChoruspluginAudioProcessorEditor::resized()
     tabComponent.setBounds(top.removeFromLeft(componentWidth));
 
     mainComponent.setBounds(area.removeFromTop(componentHeight));
+
+    // the quality is shown in the padding under the main component
+    qualityLabel.setBounds(getLocalBounds().removeFromBottom(windowPadding).reduced(windowPadding, 0));
+}
+
+void ChoruspluginAudioProcessorEditor::timerCallback()
+{
+    if (audioProcessor.getQualityTier() != displayedQualityTier || getLoadPercent() != displayedLoadPercent)
+        updateQualityLabel();
+
+    // a loaded state can bring its own snapshots
+    if (audioProcessor.getNumMorphSnapshots() != displayedMorphSnapshots)
+    {
+        displayedMorphSnapshots = audioProcessor.getNumMorphSnapshots();
+        tabComponent.getMorphComponent().setNumSnapshots(displayedMorphSnapshots);
+    }
+}
+
+void ChoruspluginAudioProcessorEditor::updateQualityLabel()
+{
+    displayedQualityTier = audioProcessor.getQualityTier();
+    displayedLoadPercent = getLoadPercent();
+    qualityLabel.setText("Quality: " + qualityTierNames[static_cast<int>(displayedQualityTier)] 
+        + ", estimated load: " + juce::String(displayedLoadPercent) + "%", juce::dontSendNotification);
+    qualityLabel.setColour(juce::Label::textColourId, displayedQualityTier == 0 ? juce::Colours::grey : juce::Colours::orange);
+}
+
+int ChoruspluginAudioProcessorEditor::getLoadPercent() const
+{
+    return juce::roundToInt(audioProcessor.estimateLoad() * 100.0);
 }
@@ -17,7 +17,8 @@
 //==============================================================================
 /**
 */
-class ChoruspluginAudioProcessorEditor  : public juce::AudioProcessorEditor
+class ChoruspluginAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                           private juce::Timer
 {
 public:
     ChoruspluginAudioProcessorEditor (ChoruspluginAudioProcessor&, juce::AudioProcessorValueTreeState&);
@@ -39,5 +40,22 @@ private:
     TitleComponent titleComponent;
     TabComponent tabComponent;
 
+    // shows the quality tier the processor has dropped to when the cpu can't keep up
+    // and the load the current parameters are estimated to use at full quality
+    juce::Label qualityLabel;
+    size_t displayedQualityTier{ 0 };
+    int displayedLoadPercent{ 0 };
+    const juce::StringArray qualityTierNames{ "Full", "Slow lfo", "16 voices", "4 voices" };
+
+    // the number of morph snapshots shown by the morph tab
+    size_t displayedMorphSnapshots{ 0 };
+
+    // polls the processor for the quality tier, the estimated load of the current parameters and the morph snapshots
+    void timerCallback() override;
+    void updateQualityLabel();
+
+    // the estimated load rounded to a percent
+    int getLoadPercent() const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChoruspluginAudioProcessorEditor)
 };
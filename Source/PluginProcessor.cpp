@@ -31,22 +31,76 @@ ChoruspluginAudioProcessor::ChoruspluginAudioProcessor()
 {
     // adds a listener for each ID
     for (auto id : parameterIDs)
+    {
         parameters.addParameterListener(id, this);
+        parameterList.push_back(parameters.getParameter(id));
+        rawValues.push_back(parameters.getRawParameterValue(id));
+    }
+
+    jassert(parameterList.size() == dingus::numParameters);
+
+    // the ranges shared with the daemon have to match the layout
+    for (size_t i = 0; i < parameterList.size(); ++i)
+        jassert(parameterList[i]->getNormalisableRange().start == dingus::parameterRanges[i].minimum
+            && parameterList[i]->getNormalisableRange().end == dingus::parameterRanges[i].maximum);
+
+    // set up how each parameter is morphed
+    for (size_t i = 0; i < parameterList.size(); ++i)
+    {
+        switch (i)
+        {
+        case (5): // mode
+        case (6): // voices
+        case (8): // lfo type
+            presetMorph.setMorphType(i, dingus::MorphType::DISCRETE);
+            break;
+
+            // filter bypass, modulator target and type, latency, the morph itself, the macro and envelope target and type,
+            // the route sources and targets and the type of lfo 2
+        case (13):
+        case (14):
+        case (15):
+        case (20):
+        case (21):
+        case (22):
+        case (23):
+        case (24):
+        case (25):
+        case (29):
+        case (30):
+        case (31):
+        case (33):
+        case (34):
+        case (36):
+        case (37):
+        case (40):
+            break;
+
+        default:
+            presetMorph.setMorphType(i, dingus::MorphType::CONTINUOUS, parameterList[i]->getNormalisableRange());
+            break;
+        }
+    }
 
-    // set the processCallback for the modulator to change a parameter
-    modulator.setProcessCallback([this](const juce::String& id, float value) { 
-        parameterChanged(id, value); 
-        });
+    // any parameter can be a target of the mod matrix, route 0 is the mod lfo and route 1 is the envelope
+    // the other routes are set by the route parameters
+    modMatrix.setNumTargets(dingus::numParameters);
+    modMatrix.setControlRate(modulationRate);
+    modMatrix.setRouteSource(0, dingus::ModSource::LFO1);
+    modMatrix.setRouteSource(1, dingus::ModSource::ENVELOPE);
 
     // set gain ramp duration for input/output both chains
     floatChain.get<inputGainIndex>().setRampDurationSeconds(0.1);
     floatChain.get<outputGainIndex>().setRampDurationSeconds(0.1);
     doubleChain.get<inputGainIndex>().setRampDurationSeconds(0.1);
     doubleChain.get<outputGainIndex>().setRampDurationSeconds(0.1);
+
+    startTimerHz(10);
 }
 
 ChoruspluginAudioProcessor::~ChoruspluginAudioProcessor()
 {
+    stopTimer();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout ChoruspluginAudioProcessor::createParameterLayout()
@@ -62,7 +116,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout ChoruspluginAudioProcessor::
     params.push_back(std::make_unique<AudioParameterFloat>("03_chorus_delay", "Delay Time", NormalisableRange<float>(0.005f, 0.075f, 0.001f), 0.005f));
     params.push_back(std::make_unique<AudioParameterFloat>("04_chorus_width", "Width", NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
     params.push_back(std::make_unique<AudioParameterChoice>("05_chorus_mode", "Mode", StringArray("Stereo", "Mono", "Dim", "Vib"), 0));
-    params.push_back(std::make_unique<AudioParameterChoice>("06_chorus_voices", "Voices", StringArray("2", "4", "6", "8"), 0));
+    params.push_back(std::make_unique<AudioParameterChoice>("06_chorus_voices", "Voices", StringArray("2", "4", "6", "8", "16", "32", "64", "128"), 0));
     params.push_back(std::make_unique<AudioParameterFloat>("07_chorus_spread", "Spread", NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
 
     // lfo
@@ -90,11 +144,76 @@ juce::AudioProcessorValueTreeState::ParameterLayout ChoruspluginAudioProcessor::
     params.push_back(std::make_unique<AudioParameterFloat>("18_input_gain", "Input", NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
     params.push_back(std::make_unique<AudioParameterFloat>("19_output_gain", "Output", NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
 
+    // latency
+    // "Zero Latency" reports no latency and is intended for live tracking, the dry signal is not delayed
+    // so it arrives ahead of the wet signal and the wet/dry sum will have some comb filtering
+    // "Aligned" delays the dry signal by the reference delay so the wet/dry sum is phase coherent,
+    // the host compensates for the reference delay so this is better suited to mixing
+    params.push_back(std::make_unique<AudioParameterChoice>("20_latency_mode", "Latency", StringArray("Zero Latency", "Aligned"), 0));
+    params.push_back(std::make_unique<AudioParameterFloat>("21_latency_reference", "Align Delay", NormalisableRange<float>(0.001f, 0.075f, 0.001f), 0.005f));
+
+    // morph
+    // the position morphs between the stored snapshots, see storeMorphSnapshot()
+    params.push_back(std::make_unique<AudioParameterFloat>("22_morph_position", "Morph", NormalisableRange<float>(0.0f, 1.0f, 0.001f), 0.0f));
+    params.push_back(std::make_unique<AudioParameterBool>("23_morph_enabled", "Morph On", false));
+
+    // the macro is a modulation source for the route parameters
+    params.push_back(std::make_unique<AudioParameterFloat>("24_mod_macro", "Macro", NormalisableRange<float>(0.0f, 1.0f, 0.001f), 0.0f));
+
+    // envelope follower
+    // the level of the input modulates the target, eg. the depth or mix follow the playing dynamics
+    params.push_back(std::make_unique<AudioParameterChoice>("25_env_target", "Env Target", StringArray(
+        "00_chorus_rate",
+        "01_chorus_depth",
+        "02_chorus_mix",
+        "03_chorus_delay",
+        "04_chorus_width"), 1));
+    params.push_back(std::make_unique<AudioParameterFloat>("26_env_depth", "Env Depth", NormalisableRange<float>(-1.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<AudioParameterFloat>("27_env_attack", "Env Attack", NormalisableRange<float>(1.0f, 100.0f, 0.1f, 0.5f), 10.0f));
+    params.push_back(std::make_unique<AudioParameterFloat>("28_env_release", "Env Release", NormalisableRange<float>(10.0f, 1000.0f, 1.0f, 0.5f), 150.0f));
+    params.push_back(std::make_unique<AudioParameterChoice>("29_env_type", "Env Type", StringArray("Peak", "RMS"), 1));
+
+    // mod matrix routes
+    // each route adds a source to a continuous parameter, a depth of 1 moves the target by up to half of its max value
+    const StringArray sourceNames("LFO 1", "LFO 2", "Random", "Macro", "Envelope");
+    const StringArray targetNames("None", "Rate", "Depth", "Mix", "Delay", "Width", "Spread",
+        "Phase L", "Phase R", "High Pass", "Low Pass", "Input", "Output");
+
+    params.push_back(std::make_unique<AudioParameterChoice>("30_route1_source", "Route 1 Source", sourceNames, 1));
+    params.push_back(std::make_unique<AudioParameterChoice>("31_route1_target", "Route 1 Target", targetNames, 0));
+    params.push_back(std::make_unique<AudioParameterFloat>("32_route1_depth", "Route 1 Depth", NormalisableRange<float>(-1.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<AudioParameterChoice>("33_route2_source", "Route 2 Source", sourceNames, 2));
+    params.push_back(std::make_unique<AudioParameterChoice>("34_route2_target", "Route 2 Target", targetNames, 0));
+    params.push_back(std::make_unique<AudioParameterFloat>("35_route2_depth", "Route 2 Depth", NormalisableRange<float>(-1.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<AudioParameterChoice>("36_route3_source", "Route 3 Source", sourceNames, 3));
+    params.push_back(std::make_unique<AudioParameterChoice>("37_route3_target", "Route 3 Target", targetNames, 0));
+    params.push_back(std::make_unique<AudioParameterFloat>("38_route3_depth", "Route 3 Depth", NormalisableRange<float>(-1.0f, 1.0f, 0.01f), 0.0f));
+
+    // the second lfo and the random source are only used by the routes
+    params.push_back(std::make_unique<AudioParameterFloat>("39_lfo2_rate", "LFO 2 Rate", frequencyRange(0.01f, 10.0f, 0.01f), 0.5f));
+    params.push_back(std::make_unique<AudioParameterBool>("40_lfo2_type", "LFO 2 Type", false));
+    params.push_back(std::make_unique<AudioParameterFloat>("41_random_rate", "Random Rate", frequencyRange(0.1f, 20.0f, 0.01f), 1.0f));
+
     return { params.begin(), params.end() };
 }
 
 // callback for when a parameter is changed
 void ChoruspluginAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    int index = parameterIDs.indexOf(parameterID);
+
+    // the values of a loaded state are applied as a whole in process()
+    if (index < 0 || loadingValues[static_cast<size_t>(index)])
+        return;
+
+    // the morph sets the morphed parameters while it's enabled
+    if (morphEnabled && presetMorph.getMorphType(static_cast<size_t>(index)) != dingus::MorphType::NONE)
+        return;
+
+    applyParameter(parameterID, newValue);
+}
+
+void ChoruspluginAudioProcessor::applyParameter(const juce::String& parameterID, float newValue)
 {
     // update the parameters of only the active precision chain
     if (isUsingDoublePrecision())
@@ -105,12 +224,18 @@ void ChoruspluginAudioProcessor::parameterChanged(const juce::String& parameterI
 
 template <typename SampleType>
 void ChoruspluginAudioProcessor::updateParameters(const juce::String& parameterID, SampleType newValue, ProcessorChain<SampleType>& chain)
+{
+    updateParameter(parameterIDs.indexOf(parameterID), newValue, chain);
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::updateParameter(int parameterIndex, SampleType newValue, ProcessorChain<SampleType>& chain)
 {
     using namespace juce;
 
     auto& chorus = chain.get<chorusIndex>();
 
-    switch (parameterIDs.indexOf(parameterID))
+    switch (parameterIndex)
     {
         // chorus
     case (0): // rate
@@ -132,7 +257,7 @@ void ChoruspluginAudioProcessor::updateParameters(const juce::String& parameterI
         chorus.setMode(static_cast<dingus::Mode>(newValue));
         break;
     case (6): // voices
-        chorus.setNumVoice(static_cast<size_t>(newValue));
+        chorus.setNumVoice(voiceCounts[static_cast<size_t>(newValue)]);
         break;
     case (7): // spread
         chorus.setVoiceSpread(newValue);
@@ -162,31 +287,17 @@ void ChoruspluginAudioProcessor::updateParameters(const juce::String& parameterI
 
         // modulator
     case (14): // target
-    {
-        // keep track of the last value
-        String lastID = modulator.getCurrentID();
-        std::atomic<float>* lastValue = parameters.getRawParameterValue(lastID);
-
-        // set the new target
-        int targetIndex = static_cast<int>(newValue);
-        std::atomic<float>* value = parameters.getRawParameterValue(modTargets[targetIndex]);
-        NormalisableRange<float> range = parameters.getParameterRange(modTargets[targetIndex]);
-        modulator.setTargetParameter(value, range, modTargets[targetIndex]);
-
-        // recursive call to reset the last parameter
-        // make sure the last value wasn't nullptr
-        if (lastValue)
-            parameterChanged(lastID, *parameters.getRawParameterValue(lastID));
-    }
-    break;
+        // the last target goes back to its base value when it's released by the matrix
+        modMatrix.setRouteTarget(0, parameterIDs.indexOf(modTargets[static_cast<int>(newValue)]));
+        break;
     case (15): // type
-        modulator.setLfoType(static_cast<dingus::WaveType>(newValue));
+        modMatrix.setLfoType(0, static_cast<dingus::WaveType>(newValue));
         break;
     case (16): // rate
-        modulator.setLfoRate(newValue);
+        modMatrix.setLfoRate(0, static_cast<float>(newValue));
         break;
     case (17): // depth
-        modulator.setLfoDepth(newValue);
+        modMatrix.setRouteDepth(0, static_cast<float>(newValue));
         break;
 
         // gain
@@ -203,11 +314,194 @@ void ChoruspluginAudioProcessor::updateParameters(const juce::String& parameterI
     }
     break;
 
+        // latency
+    case (20): // mode
+        chorus.setLatencyMode(static_cast<dingus::LatencyMode>(newValue));
+        updateLatency(chain);
+        break;
+    case (21): // reference delay
+        chorus.setReferenceDelay(newValue);
+        updateLatency(chain);
+        break;
+
+        // morph
+    case (22): // position
+        morphPosition = static_cast<float>(newValue);
+        break;
+    case (23): // enabled
+        // this can be called on the message thread, the morph is switched at the start of the next block
+        morphRequested = newValue >= SampleType(0.5);
+        break;
+
+        // macro
+    case (24):
+        modMatrix.setMacro(static_cast<float>(newValue));
+        break;
+
+        // envelope
+    case (25): // target
+        modMatrix.setRouteTarget(1, parameterIDs.indexOf(modTargets[static_cast<int>(newValue)]));
+        break;
+    case (26): // depth
+        modMatrix.setRouteDepth(1, static_cast<float>(newValue));
+        break;
+    case (27): // attack
+        modMatrix.setEnvelopeAttack(static_cast<float>(newValue));
+        break;
+    case (28): // release
+        modMatrix.setEnvelopeRelease(static_cast<float>(newValue));
+        break;
+    case (29): // type
+        modMatrix.setEnvelopeType(static_cast<dingus::EnvelopeType>(newValue));
+        break;
+
+        // routes
+    case (30): // source
+    case (33):
+    case (36):
+        modMatrix.setRouteSource(firstParameterRoute + static_cast<size_t>(parameterIndex - firstRouteParameter) / 3, 
+            static_cast<dingus::ModSource>(static_cast<int>(newValue)));
+        break;
+    case (31): // target
+    case (34):
+    case (37):
+        modMatrix.setRouteTarget(firstParameterRoute + static_cast<size_t>(parameterIndex - firstRouteParameter) / 3,
+            routeTargets[static_cast<size_t>(newValue)]);
+        break;
+    case (32): // depth
+    case (35):
+    case (38):
+        modMatrix.setRouteDepth(firstParameterRoute + static_cast<size_t>(parameterIndex - firstRouteParameter) / 3,
+            static_cast<float>(newValue));
+        break;
+
+        // sources
+    case (39): // lfo 2 rate
+        modMatrix.setLfoRate(1, static_cast<float>(newValue));
+        break;
+    case (40): // lfo 2 type
+        modMatrix.setLfoType(1, static_cast<dingus::WaveType>(newValue));
+        break;
+    case (41): // random rate
+        modMatrix.setRandomRate(static_cast<float>(newValue));
+        break;
+
     default:
         break;
     }
 }
 
+float ChoruspluginAudioProcessor::getBaseValue(size_t parameterIndex) const
+{
+    if (morphEnabled && presetMorph.getMorphType(parameterIndex) == dingus::MorphType::CONTINUOUS)
+        return morphedValues[parameterIndex];
+
+    return *rawValues[parameterIndex];
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::releaseModulatedTargets(ProcessorChain<SampleType>& chain)
+{
+    std::array<bool, dingus::numParameters> isModulated{};
+
+    for (size_t i = 0; i < modMatrix.getNumActiveTargets(); ++i)
+        isModulated[modMatrix.getActiveTarget(i)] = true;
+
+    for (size_t i = 0; i < isModulated.size(); ++i)
+        if (wasModulated[i] && !isModulated[i])
+            updateParameter(static_cast<int>(i), static_cast<SampleType>(getBaseValue(i)), chain);
+
+    wasModulated = isModulated;
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::applyModulation(size_t point, ProcessorChain<SampleType>& chain)
+{
+    for (size_t i = 0; i < modMatrix.getNumActiveTargets(); ++i)
+    {
+        auto target = modMatrix.getActiveTarget(i);
+        auto& range = parameterList[target]->getNormalisableRange();
+
+        // a depth of 1 moves the target by up to half of its max value, the value is hard limited by the range
+        float offset = modMatrix.getOffsets(target)[point] * range.end * 0.5f;
+        float value = juce::jlimit(range.start, range.end, getBaseValue(target) + offset);
+
+        updateParameter(static_cast<int>(target), static_cast<SampleType>(value), chain);
+    }
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::applySnapshot(const dingus::ParameterSnapshot& snapshot, ProcessorChain<SampleType>& chain)
+{
+    // a value that changed after the state was loaded, eg. by automation, was already applied by its callback
+    for (size_t i = 0; i < snapshot.values.size(); ++i)
+        if (snapshot.values[i] == rawValues[i]->load())
+            updateParameter(static_cast<int>(i), static_cast<SampleType>(snapshot.values[i]), chain);
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::setMorphEnabled(bool enabled, ProcessorChain<SampleType>& chain)
+{
+    if (enabled == morphEnabled)
+        return;
+
+    // the morphed values start where the parameters are
+    for (size_t i = 0; i < morphedValues.size(); ++i)
+        morphedValues[i] = rawValues[i]->load();
+
+    morphEnabled = enabled;
+
+    if (enabled)
+    {
+        presetMorph.reset();
+        return;
+    }
+
+    // put back the values of the parameters, the discrete parameters are faded like they are while morphing
+    for (size_t i = 0; i < morphedValues.size(); ++i)
+        if (presetMorph.getMorphType(i) == dingus::MorphType::CONTINUOUS)
+            updateParameter(static_cast<int>(i), static_cast<SampleType>(morphedValues[i].load()), chain);
+
+    chain.get<chorusIndex>().setDiscreteParameters(static_cast<dingus::Mode>(morphedValues[5].load()),
+        voiceCounts[static_cast<size_t>(morphedValues[6].load())], static_cast<dingus::WaveType>(morphedValues[8].load()));
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::applyMorph(const dingus::ParameterSnapshot& snapshot, ProcessorChain<SampleType>& chain)
+{
+    for (size_t i = 0; i < snapshot.values.size(); ++i)
+    {
+        if (presetMorph.getMorphType(i) == dingus::MorphType::CONTINUOUS)
+        {
+            morphedValues[i] = snapshot.values[i];
+            updateParameter(static_cast<int>(i), static_cast<SampleType>(snapshot.values[i]), chain);
+        }
+    }
+
+    // mode, voices and lfo type
+    chain.get<chorusIndex>().setDiscreteParameters(static_cast<dingus::Mode>(snapshot.values[5]),
+        voiceCounts[static_cast<size_t>(snapshot.values[6])], static_cast<dingus::WaveType>(snapshot.values[8]));
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::updateLatency(ProcessorChain<SampleType>& chain)
+{
+    chorusLatency = chain.get<chorusIndex>().getLatency();
+}
+
+void ChoruspluginAudioProcessor::reportLatency()
+{
+    int latency = chorusLatency;
+
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void ChoruspluginAudioProcessor::timerCallback()
+{
+    reportLatency();
+}
+
 //==============================================================================
 const juce::String ChoruspluginAudioProcessor::getName() const
 {
@@ -275,26 +569,57 @@ void ChoruspluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
 {
     ProcessingPrecision precision = getProcessingPrecision();
 
+    // prepare for the actual bus layout, a mono input can feed a stereo output
+    auto numInputChannels = static_cast<size_t>(getTotalNumInputChannels());
+    auto numOutputChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
+
+    floatChain.get<chorusIndex>().setNumInputChannels(numInputChannels);
+    doubleChain.get<chorusIndex>().setNumInputChannels(numInputChannels);
+
+    // pair channels according to the output layout
+    auto channelGroups = createChannelGroups(getChannelLayoutOfBus(false, 0));
+    floatChain.get<chorusIndex>().setChannelGroups(channelGroups);
+    doubleChain.get<chorusIndex>().setChannelGroups(channelGroups);
+
+    // independent groups can be processed in parallel when rendering offline
+    if (channelGroups.size() > 1 && renderPool == nullptr)
+        renderPool = std::make_unique<juce::ThreadPool>(juce::jmax(1, juce::SystemStats::getNumCpus() - 1));
+
+    floatChain.get<chorusIndex>().setThreadPool(renderPool.get());
+    doubleChain.get<chorusIndex>().setThreadPool(renderPool.get());
+
+    // playback starts at full quality
+    qualityGovernor.prepare(sampleRate);
+    appliedQualityTier = 0;
+    applyQualityTier(0, floatChain);
+    applyQualityTier(0, doubleChain);
+
     if (precision == ProcessingPrecision::doublePrecision)
     {
         DBG("set to double precision");
-        doubleChain.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), 2 });
-        floatChain.prepare({ sampleRate, static_cast<juce::uint32>(1), 2 });
+        doubleChain.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), numOutputChannels });
+        floatChain.prepare({ sampleRate, static_cast<juce::uint32>(1), numOutputChannels });
     }
     else
     {
         DBG("set to float precision");
-        floatChain.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), 2 });
-        doubleChain.prepare({ sampleRate, static_cast<juce::uint32>(1), 2 });
+        floatChain.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), numOutputChannels });
+        doubleChain.prepare({ sampleRate, static_cast<juce::uint32>(1), numOutputChannels });
     }
 
-    modulator.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), 2 });
+    modMatrix.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), numOutputChannels });
 
     // set initial values for each parameter
     for (auto id : parameterIDs)
     {
-        parameterChanged(id, *parameters.getRawParameterValue(id));
+        applyParameter(id, *parameters.getRawParameterValue(id));
     }
+
+    // the morph overrides the initial values at the first block
+    presetMorph.reset();
+
+    // the host reads the latency after this returns so it can't wait for the timer
+    reportLatency();
 }
 
 void ChoruspluginAudioProcessor::releaseResources()
@@ -311,14 +636,15 @@ bool ChoruspluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     return true;
   #else
     // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // any layout is supported, channels are paired using createChannelGroups()
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
+    // a mono input to a stereo output is also supported
    #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet()
+     && layouts.getMainInputChannelSet() != juce::AudioChannelSet::mono())
         return false;
    #endif
 
@@ -336,16 +662,98 @@ template <typename SampleType>
 void ChoruspluginAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, ProcessorChain<SampleType>& chain)
 {
     juce::ScopedNoDenormals noDenormals;
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // the quality is only lowered for real time playback
+    size_t qualityTier = isNonRealtime() ? 0 : qualityGovernor.getTier();
+
+    if (qualityTier != appliedQualityTier.load())
+    {
+        applyQualityTier(qualityTier, chain);
+        appliedQualityTier = qualityTier;
+    }
+
+    // a loaded state is applied at the block boundary
+    if (stateSnapshots.update())
+    {
+        applySnapshot(stateSnapshots.getReadBuffer(), chain);
+        presetMorph.reset();
+    }
+
+    // the morph is only switched here so the engine is never changed from two threads
+    if (morphRequested != morphEnabled)
+        setMorphEnabled(morphRequested, chain);
+
+    // the morph overrides the morphed parameters while it's enabled
+    if (morphEnabled && presetMorph.process(morphPosition, morphValues))
+        applyMorph(morphValues, chain);
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
+    // a mono input feeds every output channel, otherwise clear outputs without an input
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, buffer.getNumSamples());
+    {
+        if (totalNumInputChannels == 1)
+            buffer.copyFrom(i, 0, buffer, 0, 0, buffer.getNumSamples());
+        else
+            buffer.clear(i, 0, buffer.getNumSamples());
+    }
+
+    // the thread pool and the higher quality interpolation are only used when rendering offline
+    chain.get<chorusIndex>().setUseTaskRunner(isNonRealtime());
+    chain.get<chorusIndex>().setInterpolation(getInterpolation());
 
     auto block = juce::dsp::AudioBlock<SampleType>(buffer);
     auto context = juce::dsp::ProcessContextReplacing<SampleType>(block);
-    modulator.process(context);
-    chain.process(context);
+
+    // the envelope follower reads the input before the chain
+    auto numSamples = block.getNumSamples();
+    auto numPoints = modMatrix.process(juce::dsp::AudioBlock<const SampleType>(block));
+    releaseModulatedTargets(chain);
+
+    // without modulation the whole block is processed at once
+    if (modMatrix.getNumActiveTargets() == 0)
+    {
+        chain.process(context);
+    }
+    else
+    {
+        // otherwise the modulation is applied at each control point and the chain is processed up to the next one
+        // the control points carry on across blocks, so small blocks are mostly processed whole with the last point's values
+        auto controlInterval = modMatrix.getControlInterval();
+        auto firstPoint = modMatrix.getFirstPoint();
+
+        if (firstPoint > 0)
+        {
+            auto subBlock = block.getSubBlock(0, firstPoint);
+            chain.process(juce::dsp::ProcessContextReplacing<SampleType>(subBlock));
+        }
+
+        for (size_t point = 0; point < numPoints; ++point)
+        {
+            applyModulation(point, chain);
+
+            auto startSample = firstPoint + point * controlInterval;
+            auto subBlock = block.getSubBlock(startSample, juce::jmin(controlInterval, numSamples - startSample));
+            chain.process(juce::dsp::ProcessContextReplacing<SampleType>(subBlock));
+        }
+    }
+
+    if (!isNonRealtime())
+        qualityGovernor.addBlock(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks), numSamples);
+}
+
+template <typename SampleType>
+void ChoruspluginAudioProcessor::applyQualityTier(size_t tier, ProcessorChain<SampleType>& chain)
+{
+    chain.get<chorusIndex>().setVoiceLimit(qualityTiers[tier].maxVoices);
+    chain.get<chorusIndex>().setLfoControlRate(static_cast<SampleType>(qualityTiers[tier].lfoControlRate));
+}
+
+dingus::Interpolation ChoruspluginAudioProcessor::getInterpolation() const
+{
+    return isNonRealtime() ? offlineInterpolation : realtimeInterpolation;
 }
 
 // float processing
@@ -362,6 +770,60 @@ void ChoruspluginAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
     process(buffer, doubleChain);
 }
 
+std::vector<std::vector<size_t>> ChoruspluginAudioProcessor::createChannelGroups(const juce::AudioChannelSet& layout)
+{
+    using ChannelType = juce::AudioChannelSet::ChannelType;
+
+    std::vector<std::vector<size_t>> groups;
+    int numChannels = layout.size();
+
+    // discrete and ambisonic channels have no left/right counterparts so each one is processed on its own
+    // pairing them would spread one channel into the other in the stereo and dimension modes,
+    // for ambisonics that mixes the spherical harmonics and smears the soundfield
+    if (layout.isDiscreteLayout() || layout.getAmbisonicOrder() >= 0)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            groups.push_back({ static_cast<size_t>(channel) });
+
+        return groups;
+    }
+
+    const std::vector<std::pair<ChannelType, ChannelType>> channelPairs
+    {
+        { juce::AudioChannelSet::left, juce::AudioChannelSet::right },
+        { juce::AudioChannelSet::leftCentre, juce::AudioChannelSet::rightCentre },
+        { juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::rightSurround },
+        { juce::AudioChannelSet::leftSurroundSide, juce::AudioChannelSet::rightSurroundSide },
+        { juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::rightSurroundRear },
+        { juce::AudioChannelSet::wideLeft, juce::AudioChannelSet::wideRight },
+        { juce::AudioChannelSet::topFrontLeft, juce::AudioChannelSet::topFrontRight },
+        { juce::AudioChannelSet::topSideLeft, juce::AudioChannelSet::topSideRight },
+        { juce::AudioChannelSet::topRearLeft, juce::AudioChannelSet::topRearRight }
+    };
+
+    std::vector<bool> isGrouped(static_cast<size_t>(numChannels), false);
+
+    for (auto& channelPair : channelPairs)
+    {
+        int left = layout.getChannelIndexForType(channelPair.first);
+        int right = layout.getChannelIndexForType(channelPair.second);
+
+        if (left >= 0 && right >= 0)
+        {
+            groups.push_back({ static_cast<size_t>(left), static_cast<size_t>(right) });
+            isGrouped[static_cast<size_t>(left)] = true;
+            isGrouped[static_cast<size_t>(right)] = true;
+        }
+    }
+
+    // everything else is processed on its own
+    for (size_t channel = 0; channel < isGrouped.size(); ++channel)
+        if (!isGrouped[channel])
+            groups.push_back({ channel });
+
+    return groups;
+}
+
 //==============================================================================
 bool ChoruspluginAudioProcessor::hasEditor() const
 {
@@ -377,18 +839,149 @@ juce::AudioProcessorEditor* ChoruspluginAudioProcessor::createEditor()
 //==============================================================================
 void ChoruspluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // the values are stored in their real range so the state doesn't depend on the normalisation
+    dingus::PluginState state;
+    getParameterSnapshot(state.values);
+    state.numSnapshots = presetMorph.getNumSnapshots();
+
+    for (size_t slot = 0; slot < state.numSnapshots; ++slot)
+        state.snapshots[slot] = presetMorph.getSnapshot(slot);
+
+    destData.setSize(dingus::getStateSize(state.numSnapshots));
+    dingus::writeState(state, static_cast<char*>(destData.getData()));
 }
 
 void ChoruspluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // the host and the editor are still notified of each parameter
+    // but the chain only sees the complete state, at the start of the next block
+    // anything that isn't a binary state is an xml state from an older version
+    if (!setBinaryState(data, sizeInBytes))
+    {
+        presetMorph.clear();
+        setXmlState(data, sizeInBytes);
+    }
+
+    publishStateSnapshot();
+}
+
+void ChoruspluginAudioProcessor::getParameterSnapshot(dingus::ParameterSnapshot& snapshot) const
+{
+    // the raw values are what applySnapshot() compares against
+    for (size_t i = 0; i < rawValues.size(); ++i)
+        snapshot.values[i] = rawValues[i]->load();
+}
+
+void ChoruspluginAudioProcessor::setLoadedValue(size_t parameterIndex, float normalisedValue)
+{
+    // the listener callback is made on this thread before setValueNotifyingHost() returns
+    loadingValues[parameterIndex] = true;
+    parameterList[parameterIndex]->setValueNotifyingHost(normalisedValue);
+    loadingValues[parameterIndex] = false;
+}
+
+void ChoruspluginAudioProcessor::publishStateSnapshot()
+{
+    getParameterSnapshot(stateSnapshots.getWriteBuffer());
+    stateSnapshots.publish();
+}
+
+bool ChoruspluginAudioProcessor::setBinaryState(const void* data, int sizeInBytes)
+{
+    // nan, inf and missing values are replaced with the defaults by readState()
+    dingus::PluginState state;
+    auto result = dingus::readState(data, static_cast<size_t>(juce::jmax(sizeInBytes, 0)), state);
+
+    if (result == dingus::StateResult::NOT_BINARY)
+        return false;
+
+    // a newer version may have changed the meaning of the values
+    if (result == dingus::StateResult::NEWER_VERSION)
+    {
+        jassertfalse;
+        return true;
+    }
+
+    for (size_t i = 0; i < parameterList.size(); ++i)
+        setLoadedValue(i, parameterList[i]->convertTo0to1(state.values[i]));
+
+    presetMorph.clear();
+
+    for (size_t slot = 0; slot < state.numSnapshots; ++slot)
+        presetMorph.setSnapshot(slot, state.snapshots[slot]);
+
+    return true;
+}
+
+void ChoruspluginAudioProcessor::storeMorphSnapshot(size_t slot)
+{
+    dingus::ParameterSnapshot snapshot;
+    getParameterSnapshot(snapshot);
+    presetMorph.setSnapshot(slot, snapshot);
+}
+
+void ChoruspluginAudioProcessor::clearMorphSnapshots()
+{
+    presetMorph.clear();
+}
+
+size_t ChoruspluginAudioProcessor::getNumMorphSnapshots() const
+{
+    return presetMorph.getNumSnapshots();
+}
+
+size_t ChoruspluginAudioProcessor::getQualityTier() const
+{
+    return appliedQualityTier.load();
+}
+
+float ChoruspluginAudioProcessor::getProcessingLoad() const
+{
+    return qualityGovernor.getLoad();
+}
+
+double ChoruspluginAudioProcessor::estimateCost(const dingus::ParameterSnapshot& snapshot) const
+{
+    dingus::ProcessSpec spec{ getSampleRate(), static_cast<std::uint32_t>(juce::jmax(getBlockSize(), 1)), 
+        static_cast<std::uint32_t>(getTotalNumOutputChannels()) };
+
+    dingus::CostSettings settings;
+    settings.mode = static_cast<dingus::Mode>(snapshot.values[5]);
+    settings.numVoices = juce::jmin(voiceCounts[juce::jmin(static_cast<size_t>(snapshot.values[6]), voiceCounts.size() - 1)],
+        qualityTiers[appliedQualityTier.load()].maxVoices);
+    settings.filterBypass = snapshot.values[13] >= 0.5f;
+    settings.interpolation = getInterpolation();
+    settings.mix = snapshot.values[2];
+
+    if (isUsingDoublePrecision())
+        return dingus::ChorusEngine<double>::estimateCost(spec, settings);
+
+    return dingus::ChorusEngine<float>::estimateCost(spec, settings);
+}
+
+double ChoruspluginAudioProcessor::estimateLoad() const
+{
+    dingus::ParameterSnapshot snapshot;
+    getParameterSnapshot(snapshot);
+
+    return estimateCost(snapshot) * getSampleRate() * 1e-9;
+}
+
+void ChoruspluginAudioProcessor::setXmlState(const void* data, int sizeInBytes)
 {
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
-    if (xmlState.get() != nullptr)
-        if (xmlState->hasTagName(parameters.state.getType()))
-            parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    if (xmlState.get() == nullptr || !xmlState->hasTagName(parameters.state.getType()))
+        return;
+
+    // an xml state replaces every parameter at once
+    for (auto& loading : loadingValues)
+        loading = true;
+
+    parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+
+    for (auto& loading : loadingValues)
+        loading = false;
 }
 
 //==============================================================================
@@ -9,14 +9,20 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "DSP/ChorusEngine.h"
-#include "DSP/Modulator.h"
+#include <array>
+#include "DSP/JuceAdapters.h"
+#include "DSP/ModMatrix.h"
+#include "DSP/QualityGovernor.h"
+#include "ParameterSnapshot.h"
+#include "PluginState.h"
+#include "PresetMorph.h"
 
 //==============================================================================
 /**
 */
 class ChoruspluginAudioProcessor  : public juce::AudioProcessor,
-                                    public juce::AudioProcessorValueTreeState::Listener
+                                    public juce::AudioProcessorValueTreeState::Listener,
+                                    private juce::Timer
 {
 public:
     //==============================================================================
@@ -64,10 +70,35 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
     // callback for when a parameter is changed, inherited from vts listener
+    // the changes made by loading a state are ignored, the whole state is applied at the next block instead
     void parameterChanged(const juce::String& parameterID, float newValue) override;
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    //==============================================================================
+    // stores the current parameter values as one of the morph snapshots
+    void storeMorphSnapshot(size_t slot);
+
+    // removes all of the morph snapshots
+    void clearMorphSnapshots();
+
+    // returns the number of stored morph snapshots, the morph needs at least two
+    size_t getNumMorphSnapshots() const;
+
+    // returns the quality tier used for the last block, 0 is full quality
+    size_t getQualityTier() const;
+
+    // returns the fraction of the real time budget used to process each block, averaged
+    float getProcessingLoad() const;
+
+    // estimates the time in ns it takes to process each sample with the values of a snapshot at the current quality tier
+    // this uses the current channels, block size, precision, interpolation and the voice cap of the tier applied to the last block,
+    // eg. to compare presets before loading them, the model is fitted at the full quality control rate
+    double estimateCost(const dingus::ParameterSnapshot& snapshot) const;
+
+    // estimates the fraction of the real time budget the current parameter values use at the current quality tier
+    double estimateLoad() const;
+
 private:
     //==============================================================================
     juce::AudioProcessorValueTreeState parameters;
@@ -93,7 +124,29 @@ private:
         "16_mod_rate",
         "17_mod_depth",
         "18_input_gain",
-        "19_output_gain"
+        "19_output_gain",
+        "20_latency_mode",
+        "21_latency_reference",
+        "22_morph_position",
+        "23_morph_enabled",
+        "24_mod_macro",
+        "25_env_target",
+        "26_env_depth",
+        "27_env_attack",
+        "28_env_release",
+        "29_env_type",
+        "30_route1_source",
+        "31_route1_target",
+        "32_route1_depth",
+        "33_route2_source",
+        "34_route2_target",
+        "35_route2_depth",
+        "36_route3_source",
+        "37_route3_target",
+        "38_route3_depth",
+        "39_lfo2_rate",
+        "40_lfo2_type",
+        "41_random_rate"
     };
 
     const juce::StringArray modTargets
@@ -105,7 +158,69 @@ private:
         "04_chorus_width"
     };
 
-    dingus::Modulator modulator;
+    // the number of voices per channel for each choice of the voices parameter
+    // the choices are labelled with the number of delay lines in stereo
+    const std::array<size_t, 8> voiceCounts{ 1, 2, 3, 4, 8, 16, 32, 64 };
+
+    // routes the modulation sources to the parameters
+    // route 0 is the lfo of the mod parameters, route 1 is the envelope follower and the routes after them
+    // are set by the route parameters, each with a source, a target and a depth
+    // the modulation is applied to the chain at the control points of the matrix, the block is processed in pieces in between
+    dingus::ModMatrix modMatrix;
+    const float modulationRate{ 500.0f };
+
+    // the route parameters start at firstRouteParameter and set the routes from firstParameterRoute
+    static constexpr int firstRouteParameter{ 30 };
+    static constexpr size_t firstParameterRoute{ 2 };
+
+    // the parameter index of each choice of the route targets, the first choice disables the route
+    const std::array<int, 13> routeTargets{ { -1, 0, 1, 2, 3, 4, 7, 9, 10, 11, 12, 18, 19 } };
+
+    // the targets modulated in the last block, targets that are no longer modulated go back to their base value
+    std::array<bool, dingus::numParameters> wasModulated{};
+
+    // returns the unmodulated value of a parameter, this is the morphed value while morphing
+    float getBaseValue(size_t parameterIndex) const;
+
+    // puts back the base value of targets that are no longer modulated
+    template <typename SampleType>
+    void releaseModulatedTargets(ProcessorChain<SampleType>& chain);
+
+    // applies the modulated targets at a control point
+    template <typename SampleType>
+    void applyModulation(size_t point, ProcessorChain<SampleType>& chain);
+
+    // the settings of a quality tier, the lfos are evaluated at the control rate in Hz and interpolated in between
+    struct QualityTier
+    {
+        size_t maxVoices;
+        float lfoControlRate;
+    };
+
+    // the governor steps down through the quality tiers while the blocks take too long to process
+    // the first step slows the control rate, which helps patches with only a few voices
+    // the later steps cap the number of voices as well, the voices cost nearly all of the processing time
+    const std::array<QualityTier, dingus::QualityGovernor::numTiers> qualityTiers{ {
+        { 64, 2500.0f },
+        { 64, 500.0f },
+        { 16, 500.0f },
+        { 4, 250.0f } } };
+
+    dingus::QualityGovernor qualityGovernor;
+
+    // the tier used for the last block, offline renders don't have a budget so they always use the first tier
+    std::atomic<size_t> appliedQualityTier{ 0 };
+
+    // applies the voice limit and control rate of a quality tier to the chain
+    template <typename SampleType>
+    void applyQualityTier(size_t tier, ProcessorChain<SampleType>& chain);
+
+    // returns the interpolation used for the next block, offline renders use the more expensive lagrange interpolation
+    dingus::Interpolation getInterpolation() const;
+
+    // linear interpolation is used for playback at every tier
+    const dingus::Interpolation realtimeInterpolation{ dingus::Interpolation::LINEAR };
+    const dingus::Interpolation offlineInterpolation{ dingus::Interpolation::LAGRANGE };
 
     enum
     {
@@ -118,17 +233,99 @@ private:
     template <typename SampleType>
     using ProcessorChain = juce::dsp::ProcessorChain<
         juce::dsp::Gain<SampleType>,
-        dingus::ChorusEngine<SampleType>,
+        dingus::JuceChorusEngine<SampleType>,
         juce::dsp::Gain<SampleType> >;
 
     // private process function to call in overloaded processBlocks for float & double
     template <typename SampleType>
     void process(juce::AudioBuffer<SampleType>& buffer, ProcessorChain<SampleType>& chain);
 
-    // private update function which can be called on either version of the chain in parameterChanged()
+    // applies a parameter change to the active precision chain
+    void applyParameter(const juce::String& parameterID, float newValue);
+
+    // private update function which can be called on either version of the chain in applyParameter()
     template <typename SampleType>
     void updateParameters(const juce::String& parameterID, SampleType newValue, ProcessorChain<SampleType>& chain);
 
+    // updates a parameter by its index in parameterIDs
+    template <typename SampleType>
+    void updateParameter(int parameterIndex, SampleType newValue, ProcessorChain<SampleType>& chain);
+
+    // groups the channels of a layout into the left/right pairs used by the chorus engine
+    // channels without a counterpart (center, lfe, ...) are processed on their own
+    // discrete and ambisonic channels are never paired
+    static std::vector<std::vector<size_t>> createChannelGroups(const juce::AudioChannelSet& layout);
+
+    // thread pool used to process channel groups in parallel during offline renders
+    std::unique_ptr<juce::ThreadPool> renderPool;
+
+    // passes the chorus latency to the message thread, this can be called on the audio thread
+    template <typename SampleType>
+    void updateLatency(ProcessorChain<SampleType>& chain);
+
+    // the latency of the chain, reported to the host by the timer on the message thread
+    // setLatencySamples() notifies the host, which isn't safe on the audio thread
+    std::atomic<int> chorusLatency{ 0 };
+
+    // reports the latency to the host, only notifies the host when the latency has changed
+    void reportLatency();
+
+    // inherited from timer, reports the latency
+    void timerCallback() override;
+
+    // the parameters and their raw values in the order of parameterIDs so they can be used without any lookups
+    std::vector<juce::RangedAudioParameter*> parameterList;
+    std::vector<std::atomic<float>*> rawValues;
+
+    // restores a binary state, returns false if the data isn't a binary state
+    bool setBinaryState(const void* data, int sizeInBytes);
+
+    // restores a state saved as xml by older versions
+    void setXmlState(const void* data, int sizeInBytes);
+
+    // set while setStateInformation() updates a parameter so only the callback of that change is ignored
+    // other changes that arrive during a load, eg. automation on another thread, are still applied
+    std::array<std::atomic<bool>, dingus::numParameters> loadingValues{};
+
+    // sets a parameter from a loaded state without applying it to the chain
+    void setLoadedValue(size_t parameterIndex, float normalisedValue);
+
+    // loaded states are passed to the audio thread as a snapshot of every parameter
+    dingus::TripleBuffer<dingus::ParameterSnapshot> stateSnapshots;
+
+    // fills a snapshot with the current parameter values
+    void getParameterSnapshot(dingus::ParameterSnapshot& snapshot) const;
+
+    // fills a snapshot with the current parameter values and passes it to the audio thread
+    void publishStateSnapshot();
+
+    // applies every value of a snapshot to the chain in one pass
+    template <typename SampleType>
+    void applySnapshot(const dingus::ParameterSnapshot& snapshot, ProcessorChain<SampleType>& chain);
+
+    // while the morph is enabled it sets the morphed parameters from the morph position
+    // the mode, voices and lfo type are switched by the engine behind a short fade of the wet signal
+    dingus::PresetMorph presetMorph;
+    dingus::ParameterSnapshot morphValues;
+    std::atomic<float> morphPosition{ 0.0f };
+
+    // the parameter sets the requested state on any thread, process() switches the morph when it differs
+    // morphEnabled is only written by process() and read by the parameter callbacks
+    std::atomic<bool> morphRequested{ false };
+    std::atomic<bool> morphEnabled{ false };
+
+    // the base values of the morphed parameters, modulation is added to these while morphing
+    std::array<std::atomic<float>, dingus::numParameters> morphedValues{};
+
+    // enables the morph, when it's disabled the morphed parameters go back to their own values
+    // this is only called by process()
+    template <typename SampleType>
+    void setMorphEnabled(bool enabled, ProcessorChain<SampleType>& chain);
+
+    // applies the morphed parameters to the chain
+    template <typename SampleType>
+    void applyMorph(const dingus::ParameterSnapshot& snapshot, ProcessorChain<SampleType>& chain);
+
     ProcessorChain<float> floatChain;
     ProcessorChain<double> doubleChain;
 
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    PluginState.cpp
+    Created: 20 Oct 2026 2:14:37am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace dingus
+{
+
+namespace
+{
+    // little endian helpers, the state reads the same on every platform
+    void writeUnsigned(char* data, std::uint32_t value, size_t numBytes)
+    {
+        for (size_t i = 0; i < numBytes; ++i)
+            data[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+
+    std::uint32_t readUnsigned(const char* data, size_t numBytes)
+    {
+        std::uint32_t value = 0;
+
+        for (size_t i = 0; i < numBytes; ++i)
+            value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+
+        return value;
+    }
+
+    void writeFloat(char* data, float value)
+    {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(value));
+        writeUnsigned(data, bits, sizeof(bits));
+    }
+
+    // reads the value of a parameter, a value that isn't finite goes back to the default
+    float readValue(const char* data, size_t parameter)
+    {
+        std::uint32_t bits = readUnsigned(data, sizeof(bits));
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        auto& range = parameterRanges[parameter];
+
+        if (!std::isfinite(value))
+            return range.defaultValue;
+
+        return std::min(std::max(value, range.minimum), range.maximum);
+    }
+
+    // reads the values saved in a state, the parameters added after the state was saved get their default
+    void readValues(const char* data, size_t numValues, ParameterSnapshot& snapshot)
+    {
+        for (size_t i = 0; i < numParameters; ++i)
+            snapshot.values[i] = i < numValues ? readValue(data + i * sizeof(float), i) : parameterRanges[i].defaultValue;
+    }
+}
+
+//==============================================================================
+size_t getStateSize(size_t numSnapshots)
+{
+    return PluginState::headerSize + (1 + numSnapshots) * numParameters * sizeof(float) + sizeof(std::uint16_t);
+}
+
+void writeState(const PluginState& state, char* data)
+{
+    writeUnsigned(data, PluginState::magic, 4);
+    writeUnsigned(data + 4, PluginState::version, 2);
+    writeUnsigned(data + 6, static_cast<std::uint32_t>(numParameters), 2);
+
+    char* values = data + PluginState::headerSize;
+
+    for (size_t i = 0; i < numParameters; ++i)
+        writeFloat(values + i * sizeof(float), state.values.values[i]);
+
+    // older versions stop reading after the values so the snapshots didn't need a new version
+    char* snapshots = values + numParameters * sizeof(float);
+    size_t numSnapshots = std::min(state.numSnapshots, maxMorphSnapshots);
+    writeUnsigned(snapshots, static_cast<std::uint32_t>(numSnapshots), 2);
+    snapshots += sizeof(std::uint16_t);
+
+    for (size_t slot = 0; slot < numSnapshots; ++slot)
+        for (size_t i = 0; i < numParameters; ++i)
+            writeFloat(snapshots + (slot * numParameters + i) * sizeof(float), state.snapshots[slot].values[i]);
+}
+
+StateResult readState(const void* data, size_t size, PluginState& state)
+{
+    auto* bytes = static_cast<const char*>(data);
+
+    if (bytes == nullptr || size < PluginState::headerSize || readUnsigned(bytes, 4) != PluginState::magic)
+        return StateResult::NOT_BINARY;
+
+    if (readUnsigned(bytes + 4, 2) > PluginState::version)
+        return StateResult::NEWER_VERSION;
+
+    // the number of values is only trusted as far as the data goes
+    size_t numValues = std::min(static_cast<size_t>(readUnsigned(bytes + 6, 2)), (size - PluginState::headerSize) / sizeof(float));
+    size_t valueSize = numValues * sizeof(float);
+
+    readValues(bytes + PluginState::headerSize, numValues, state.values);
+    state.numSnapshots = 0;
+
+    // states saved before morphing was added end after the values
+    size_t snapshotsOffset = PluginState::headerSize + valueSize;
+
+    if (size < snapshotsOffset + sizeof(std::uint16_t))
+        return StateResult::LOADED;
+
+    size_t numSnapshots = readUnsigned(bytes + snapshotsOffset, 2);
+    size_t available = (size - snapshotsOffset - sizeof(std::uint16_t)) / std::max(valueSize, size_t(1));
+    state.numSnapshots = std::min({ numSnapshots, maxMorphSnapshots, available });
+
+    for (size_t slot = 0; slot < state.numSnapshots; ++slot)
+        readValues(bytes + snapshotsOffset + sizeof(std::uint16_t) + slot * valueSize, numValues, state.snapshots[slot]);
+
+    return StateResult::LOADED;
+}
+
+//==============================================================================
+} // dingus
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+    Created: 20 Oct 2026 2:14:37am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "ParameterSnapshot.h"
+
+namespace dingus
+{
+
+//==============================================================================
+// the saved state of the plugin, the parameter values and the morph snapshots
+// the state is saved as a header followed by the value of each parameter in the order of the parameter IDs
+// the header is the magic number, the version and the number of values, all little endian
+// new parameters can be appended without a new version, the version only changes if existing values change meaning
+// the values are followed by the number of morph snapshots and the values of each snapshot
+struct PluginState
+{
+    static constexpr std::uint32_t magic{ 0x53484344 }; // "DCHS"
+    static constexpr std::uint16_t version{ 1 };
+    static constexpr size_t headerSize{ 8 };
+
+    ParameterSnapshot values;
+    std::array<ParameterSnapshot, maxMorphSnapshots> snapshots{};
+    size_t numSnapshots{ 0 };
+};
+
+// the result of reading a state
+enum class StateResult
+{
+    NOT_BINARY,     // the data isn't a binary state, eg. an xml state from an older version
+    NEWER_VERSION,  // the state was saved by a newer version and the values may mean something else
+    LOADED
+};
+
+// returns the size in bytes of a binary state with a number of morph snapshots
+size_t getStateSize(size_t numSnapshots);
+
+// writes a binary state into getStateSize() bytes
+void writeState(const PluginState& state, char* data);
+
+// reads a binary state, the state is only filled if this returns LOADED
+// the values come from the host or a file so none of them are trusted, values that are missing, nan or inf 
+// go back to their default and the others are limited to the range of their parameter
+// this doesn't allocate, eg. for undo snapshots or hundreds of instances loading at once
+StateResult readState(const void* data, size_t size, PluginState& state);
+
+//==============================================================================
+} // dingus
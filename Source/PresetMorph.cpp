@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    PresetMorph.cpp
+    Created: 19 Oct 2026 4:12:51pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "PresetMorph.h"
+
+namespace dingus
+{
+
+//==============================================================================
+constexpr size_t PresetMorph::maxSnapshots;
+
+PresetMorph::PresetMorph()
+{
+}
+
+void PresetMorph::setMorphType(size_t index, MorphType type, juce::NormalisableRange<float> range)
+{
+    jassert(index < numParameters);
+    m_types[index] = type;
+    m_ranges[index] = range;
+}
+
+MorphType PresetMorph::getMorphType(size_t index) const
+{
+    jassert(index < numParameters);
+    return m_types[index];
+}
+
+//==============================================================================
+
+void PresetMorph::setSnapshot(size_t slot, const ParameterSnapshot& snapshot)
+{
+    jassert(slot < maxSnapshots);
+    m_bank.snapshots[slot] = snapshot;
+    m_bank.numSnapshots = juce::jmax(m_bank.numSnapshots, slot + 1);
+    publishBank();
+}
+
+void PresetMorph::clear()
+{
+    m_bank.numSnapshots = 0;
+    publishBank();
+}
+
+size_t PresetMorph::getNumSnapshots() const
+{
+    return m_bank.numSnapshots;
+}
+
+const ParameterSnapshot& PresetMorph::getSnapshot(size_t slot) const
+{
+    jassert(slot < maxSnapshots);
+    return m_bank.snapshots[slot];
+}
+
+void PresetMorph::publishBank()
+{
+    m_banks.getWriteBuffer() = m_bank;
+    m_banks.publish();
+}
+
+//==============================================================================
+
+void PresetMorph::reset() noexcept
+{
+    m_needsUpdate = true;
+}
+
+bool PresetMorph::process(float position, ParameterSnapshot& output) noexcept
+{
+    if (m_banks.update())
+        m_needsUpdate = true;
+
+    auto& bank = m_banks.getReadBuffer();
+
+    if (bank.numSnapshots < 2)
+        return false;
+
+    position = juce::jlimit(0.0f, 1.0f, position);
+
+    if (!m_needsUpdate.exchange(false) && position == m_lastPosition)
+        return false;
+
+    m_lastPosition = position;
+
+    // find the two snapshots on either side of the position
+    float segment = position * static_cast<float>(bank.numSnapshots - 1);
+    size_t index = juce::jmin(static_cast<size_t>(segment), bank.numSnapshots - 2);
+    float fraction = segment - static_cast<float>(index);
+
+    auto& valuesA = bank.snapshots[index].values;
+    auto& valuesB = bank.snapshots[index + 1].values;
+
+    for (size_t i = 0; i < numParameters; ++i)
+    {
+        switch (m_types[i])
+        {
+        case MorphType::CONTINUOUS:
+        {
+            auto& range = m_ranges[i];
+            float a = range.convertTo0to1(valuesA[i]);
+            float b = range.convertTo0to1(valuesB[i]);
+            output.values[i] = range.convertFrom0to1(a + (b - a) * fraction);
+        }
+        break;
+        case MorphType::DISCRETE:
+            output.values[i] = fraction < 0.5f ? valuesA[i] : valuesB[i];
+            break;
+        case MorphType::NONE:
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+} // dingus
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    PresetMorph.h
+    Created: 19 Oct 2026 4:12:51pm
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "ParameterSnapshot.h"
+
+namespace dingus
+{
+
+// determines how a parameter takes part in a morph
+// CONTINUOUS parameters are interpolated, DISCRETE parameters take the value of the nearest snapshot
+enum class MorphType
+{
+    NONE,
+    CONTINUOUS,
+    DISCRETE
+};
+
+//==============================================================================
+/**
+    This class morphs between up to maxSnapshots parameter snapshots from a single position.
+    The snapshots are stored in a preallocated bank which is passed to the audio thread
+    with a triple buffer, so storing a snapshot never blocks or allocates on the audio thread.
+    Continuous parameters are interpolated in their normalised range between the two nearest 
+    snapshots so skewed parameters move evenly.  A morph only costs a single pass over the 
+    parameters, and only when the position or the snapshots have changed.
+*/
+class PresetMorph
+{
+public:
+    static constexpr size_t maxSnapshots{ maxMorphSnapshots };
+
+    PresetMorph();
+
+    // sets how a parameter is morphed and the range it's interpolated in
+    // this has to be set up before process is called
+    void setMorphType(size_t index, MorphType type, juce::NormalisableRange<float> range = {});
+
+    // returns how a parameter is morphed
+    MorphType getMorphType(size_t index) const;
+
+    // stores a snapshot in a slot, the morph covers every slot up to the highest one stored
+    // only one thread may store snapshots
+    void setSnapshot(size_t slot, const ParameterSnapshot& snapshot);
+
+    // removes all of the snapshots
+    void clear();
+
+    // returns the number of snapshots being morphed
+    size_t getNumSnapshots() const;
+
+    // returns a stored snapshot, only on the thread that stores them
+    const ParameterSnapshot& getSnapshot(size_t slot) const;
+
+    // forces the next call to process() to write the morph, eg. after the morphed parameters were set directly
+    void reset() noexcept;
+
+    // writes the morph at a position from 0 to 1 into the morphed parameters of the output
+    // returns false without touching the output when nothing has changed or there are less than two snapshots
+    bool process(float position, ParameterSnapshot& output) noexcept;
+
+private:
+    struct Bank
+    {
+        std::array<ParameterSnapshot, maxSnapshots> snapshots{};
+        size_t numSnapshots{ 0 };
+    };
+
+    // the stored snapshots, a copy is published to the audio thread on every change
+    Bank m_bank;
+    TripleBuffer<Bank> m_banks;
+
+    std::array<MorphType, numParameters> m_types{};
+    std::array<juce::NormalisableRange<float>, numParameters> m_ranges;
+
+    float m_lastPosition{ -1.0f };
+    std::atomic<bool> m_needsUpdate{ true };
+
+    void publishBank();
+};
+
+//==============================================================================
+} // dingus
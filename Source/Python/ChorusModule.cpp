@@ -0,0 +1,747 @@
+/*
+  ==============================================================================
+
+    ChorusModule.cpp
+    Created: 20 Oct 2026 12:18:44am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../DSP/ChorusEngine.h"
+
+//==============================================================================
+// python bindings for the chorus engine, eg. to apply the chorus to a large set of clips
+//
+//     import chorus
+//     engine = chorus.Engine(48000, channels=2, dtype="float32")
+//     engine.set_parameters(rate=1.5, depth=0.7, voices=4, mode="dimension")
+//     engine.process(audio)               # in place, audio has the shape (channels, samples)
+//     engine.process(audio, out=output)   # into a preallocated output
+//
+// the audio is read and written through the buffer protocol without any copies, each channel has to
+// be contiguous but the channels can be anywhere, eg. rows of a larger array
+// the gil is released while processing so threads with their own engines render in parallel
+
+namespace dingus
+{
+
+namespace
+{
+    //==============================================================================
+    // the values of the engine parameters, kept so they can be read back
+    // the defaults are the plugin defaults, with the offline interpolation of the plugin
+    struct EngineParameters
+    {
+        double rate{ 2.0 };
+        double depth{ 0.5 };
+        double mix{ 1.0 };
+        double delay{ 0.005 };
+        double width{ 0.0 };
+        Mode mode{ Mode::STEREO };
+        long voices{ 1 };
+        double spread{ 1.0 };
+        WaveType lfoType{ WaveType::TRI };
+        double phaseLeft{ 0.5 };
+        double phaseRight{ 0.0 };
+        double highPass{ 20.0 };
+        double lowPass{ 20000.0 };
+        bool filterBypass{ false };
+        LatencyMode latencyMode{ LatencyMode::ZERO };
+        double latencyReference{ 0.005 };
+        Interpolation interpolation{ Interpolation::LAGRANGE };
+        double lfoControlRate{ 2500.0 };
+    };
+
+    const char* modeNames[] = { "stereo", "mono", "dimension", "vibrato" };
+    const char* waveNames[] = { "triangle", "sine" };
+    const char* latencyNames[] = { "zero", "aligned" };
+    const char* interpolationNames[] = { "linear", "hermite", "lagrange", "thiran" };
+
+    // the ranges of the numeric parameters, the same as the plugin and the c api
+    struct NumberRange
+    {
+        const char* name;
+        double minimum;
+        double maximum;
+        double EngineParameters::* value;
+    };
+
+    const NumberRange numberRanges[] =
+    {
+        { "rate", 0.01, 20.0, &EngineParameters::rate },
+        { "depth", 0.0, 1.0, &EngineParameters::depth },
+        { "mix", 0.0, 1.0, &EngineParameters::mix },
+        { "delay", 0.005, 0.075, &EngineParameters::delay },
+        { "width", 0.0, 1.0, &EngineParameters::width },
+        { "spread", 0.0, 1.0, &EngineParameters::spread },
+        { "phase_left", 0.0, 1.0, &EngineParameters::phaseLeft },
+        { "phase_right", 0.0, 1.0, &EngineParameters::phaseRight },
+        { "high_pass", 20.0, 20000.0, &EngineParameters::highPass },
+        { "low_pass", 20.0, 20000.0, &EngineParameters::lowPass },
+        { "latency_reference", 0.001, 0.075, &EngineParameters::latencyReference },
+        // 0 evaluates the lfos every sample, so does any rate above the sample rate
+        { "lfo_control_rate", 0.0, 1.0e6, &EngineParameters::lfoControlRate }
+    };
+
+    //==============================================================================
+    /**
+        The engine behind a python Engine object.  It holds a float or a double engine,
+        chosen when it's created, and splits the audio into blocks of the prepared size.
+    */
+    class PythonEngine
+    {
+    public:
+        PythonEngine(double sampleRate, size_t numChannels, size_t blockSize, bool isDouble)
+            : m_sampleRate(sampleRate), m_numChannels(numChannels), m_blockSize(blockSize), m_isDouble(isDouble)
+        {
+            ProcessSpec spec{ sampleRate, static_cast<std::uint32_t>(blockSize), static_cast<std::uint32_t>(numChannels) };
+
+            if (isDouble)
+                prepare(m_doubleEngine, spec);
+            else
+                prepare(m_floatEngine, spec);
+        }
+
+        // applies the parameters to the engine
+        void update()
+        {
+            if (m_isDouble)
+                apply(*m_doubleEngine);
+            else
+                apply(*m_floatEngine);
+        }
+
+        // clears the delay lines and filters and restarts the lfos, eg. between clips
+        void reset()
+        {
+            if (m_isDouble)
+                m_doubleEngine->reset();
+            else
+                m_floatEngine->reset();
+        }
+
+        int getLatency() const
+        {
+            return m_isDouble ? m_doubleEngine->getLatency() : m_floatEngine->getLatency();
+        }
+
+        // processes the whole length of the channels, the output may be the input
+        template<typename SampleType>
+        void process(const SampleType* const* inputs, SampleType* const* outputs, size_t numSamples) noexcept
+        {
+            auto& engine = getEngine<SampleType>();
+
+            std::vector<const SampleType*> inputPointers(inputs, inputs + m_numChannels);
+            std::vector<SampleType*> outputPointers(outputs, outputs + m_numChannels);
+
+            for (size_t start = 0; start < numSamples; start += m_blockSize)
+            {
+                size_t blockSize = std::min(m_blockSize, numSamples - start);
+
+                AudioBlock<const SampleType> inputBlock(inputPointers.data(), m_numChannels, start, blockSize);
+                AudioBlock<SampleType> outputBlock(outputPointers.data(), m_numChannels, start, blockSize);
+
+                if (inputs == outputs)
+                {
+                    ProcessContextReplacing<SampleType> context(outputBlock);
+                    engine.process(context);
+                }
+                else
+                {
+                    ProcessContextNonReplacing<SampleType> context(inputBlock, outputBlock);
+                    engine.process(context);
+                }
+            }
+        }
+
+        double getSampleRate() const { return m_sampleRate; }
+        size_t getNumChannels() const { return m_numChannels; }
+        size_t getBlockSize() const { return m_blockSize; }
+        bool isDouble() const { return m_isDouble; }
+
+        EngineParameters parameters;
+
+        // set while a thread is processing, an engine can't be used by two threads at once
+        std::atomic<bool> isBusy{ false };
+
+    private:
+        double m_sampleRate;
+        size_t m_numChannels;
+        size_t m_blockSize;
+        bool m_isDouble;
+
+        std::unique_ptr<ChorusEngine<float>> m_floatEngine;
+        std::unique_ptr<ChorusEngine<double>> m_doubleEngine;
+
+        template<typename SampleType>
+        ChorusEngine<SampleType>& getEngine();
+
+        template<typename SampleType>
+        void prepare(std::unique_ptr<ChorusEngine<SampleType>>& engine, const ProcessSpec& spec)
+        {
+            engine = std::make_unique<ChorusEngine<SampleType>>();
+            engine->setLfoControlRate(static_cast<SampleType>(parameters.lfoControlRate));
+            engine->prepare(spec);
+            apply(*engine);
+        }
+
+        template<typename SampleType>
+        void apply(ChorusEngine<SampleType>& engine)
+        {
+            engine.setRate(static_cast<SampleType>(parameters.rate));
+            engine.setDepth(static_cast<SampleType>(parameters.depth));
+            engine.setMix(static_cast<SampleType>(parameters.mix));
+            engine.setDelayTime(static_cast<SampleType>(parameters.delay));
+            engine.setDelayWidth(static_cast<SampleType>(parameters.width));
+            engine.setMode(parameters.mode);
+            engine.setNumVoice(static_cast<size_t>(parameters.voices));
+            engine.setVoiceSpread(static_cast<SampleType>(parameters.spread));
+            engine.setLfoType(parameters.lfoType);
+            engine.setPhaseOffset(static_cast<SampleType>(parameters.phaseLeft), 0);
+            engine.setPhaseOffset(static_cast<SampleType>(parameters.phaseRight), 1);
+            engine.setHighPass(static_cast<SampleType>(parameters.highPass));
+            engine.setLowPass(static_cast<SampleType>(parameters.lowPass));
+            engine.setFilterBypass(parameters.filterBypass);
+            engine.setLatencyMode(parameters.latencyMode);
+            engine.setReferenceDelay(static_cast<SampleType>(parameters.latencyReference));
+            engine.setInterpolation(parameters.interpolation);
+            engine.setLfoControlRate(static_cast<SampleType>(parameters.lfoControlRate));
+        }
+    };
+
+    template<>
+    ChorusEngine<float>& PythonEngine::getEngine<float>()
+    {
+        return *m_floatEngine;
+    }
+
+    template<>
+    ChorusEngine<double>& PythonEngine::getEngine<double>()
+    {
+        return *m_doubleEngine;
+    }
+
+    //==============================================================================
+    struct EngineObject
+    {
+        PyObject_HEAD
+        PythonEngine* engine;
+    };
+
+    // returns the sample type of a buffer format, 'f', 'd' or 0 if it's neither
+    char getSampleType(const char* format)
+    {
+        if (format == nullptr)
+            return 0;
+
+        // native order, or little endian which is native on every platform this is built for
+        if (*format == '@' || *format == '=' || *format == '<')
+            ++format;
+
+        if ((*format == 'f' || *format == 'd') && format[1] == '\0')
+            return *format;
+
+        return 0;
+    }
+
+    // finds the channel pointers of a buffer, sets a python error and returns false if it can't be processed
+    bool getChannels(const Py_buffer& view, const PythonEngine& engine, std::vector<char*>& channels, Py_ssize_t& numSamples)
+    {
+        char sampleType = getSampleType(view.format);
+
+        if (sampleType != (engine.isDouble() ? 'd' : 'f'))
+        {
+            PyErr_Format(PyExc_TypeError, "the engine processes %s samples", engine.isDouble() ? "float64" : "float32");
+            return false;
+        }
+
+        auto numChannels = static_cast<Py_ssize_t>(engine.getNumChannels());
+
+        // a mono engine also takes a 1d buffer
+        if (view.ndim == 1 && numChannels == 1)
+        {
+            channels.assign(1, static_cast<char*>(view.buf));
+            numSamples = view.shape[0];
+            return true;
+        }
+
+        if (view.ndim != 2 || view.shape[0] != numChannels)
+        {
+            PyErr_Format(PyExc_ValueError, "the audio needs the shape (%zd, samples)", numChannels);
+            return false;
+        }
+
+        if (view.strides[1] != view.itemsize)
+        {
+            PyErr_SetString(PyExc_ValueError, "the samples of each channel have to be contiguous, "
+                "eg. use numpy.ascontiguousarray(audio.T) for interleaved audio");
+            return false;
+        }
+
+        channels.resize(static_cast<size_t>(numChannels));
+
+        for (Py_ssize_t channel = 0; channel < numChannels; ++channel)
+            channels[static_cast<size_t>(channel)] = static_cast<char*>(view.buf) + channel * view.strides[0];
+
+        numSamples = view.shape[1];
+        return true;
+    }
+
+    // reads a value from a list of names, sets a python error and returns false if it isn't one of them
+    template<typename EnumType, size_t NumNames>
+    bool getChoice(PyObject* value, const char* const (&names)[NumNames], const char* parameter, EnumType& choice)
+    {
+        if (PyLong_Check(value))
+        {
+            long index = PyLong_AsLong(value);
+
+            if (index >= 0 && index < static_cast<long>(NumNames))
+            {
+                choice = static_cast<EnumType>(index);
+                return true;
+            }
+        }
+        else if (PyUnicode_Check(value))
+        {
+            const char* name = PyUnicode_AsUTF8(value);
+
+            for (size_t index = 0; name != nullptr && index < NumNames; ++index)
+            {
+                if (std::strcmp(name, names[index]) == 0)
+                {
+                    choice = static_cast<EnumType>(index);
+                    return true;
+                }
+            }
+        }
+
+        PyErr_Format(PyExc_ValueError, "%s must be one of the names or their index", parameter);
+        return false;
+    }
+
+    // reads a number, sets a python error and returns false if it isn't one
+    bool getNumber(PyObject* value, double& number)
+    {
+        number = PyFloat_AsDouble(value);
+        return !(number == -1.0 && PyErr_Occurred());
+    }
+
+    // returns the range of a numeric parameter or nullptr if there isn't one with that name
+    const NumberRange* findNumberRange(const std::string& parameter)
+    {
+        for (auto& range : numberRanges)
+            if (parameter == range.name)
+                return &range;
+
+        return nullptr;
+    }
+
+    //==============================================================================
+    int engineInit(EngineObject* self, PyObject* args, PyObject* kwargs)
+    {
+        static const char* keywords[] = { "sample_rate", "channels", "block_size", "dtype", nullptr };
+
+        double sampleRate = 0.0;
+        Py_ssize_t numChannels = 2;
+        Py_ssize_t blockSize = 512;
+        const char* dtype = "float32";
+
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|nns", const_cast<char**>(keywords), &sampleRate, &numChannels, &blockSize, &dtype))
+            return -1;
+
+        bool isDouble = std::strcmp(dtype, "float64") == 0;
+
+        if (!isDouble && std::strcmp(dtype, "float32") != 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "dtype must be float32 or float64");
+            return -1;
+        }
+
+        if (sampleRate <= 0.0 || numChannels < 1 || numChannels > 64 || blockSize < 1 || blockSize > 65536)
+        {
+            PyErr_SetString(PyExc_ValueError, "the sample rate, channels (1 to 64) or block size (1 to 65536) are out of range");
+            return -1;
+        }
+
+        // the engine can't be replaced under a thread that's processing with it
+        // the gil is held from here on so no thread can start processing in between
+        if (self->engine != nullptr && self->engine->isBusy)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "the engine is processing in another thread");
+            return -1;
+        }
+
+        delete self->engine;
+        self->engine = nullptr;
+
+        try
+        {
+            self->engine = new PythonEngine(sampleRate, static_cast<size_t>(numChannels), static_cast<size_t>(blockSize), isDouble);
+        }
+        catch (const std::bad_alloc&)
+        {
+            PyErr_NoMemory();
+            return -1;
+        }
+
+        return 0;
+    }
+
+    void engineDealloc(EngineObject* self)
+    {
+        delete self->engine;
+
+        auto* type = Py_TYPE(self);
+        type->tp_free(self);
+        Py_DECREF(type);
+    }
+
+    bool checkEngine(EngineObject* self)
+    {
+        if (self->engine != nullptr)
+            return true;
+
+        PyErr_SetString(PyExc_RuntimeError, "the engine wasn't initialised");
+        return false;
+    }
+
+    PyObject* engineSetParameters(EngineObject* self, PyObject* args, PyObject* kwargs)
+    {
+        if (!checkEngine(self))
+            return nullptr;
+
+        if (PyTuple_GET_SIZE(args) != 0)
+        {
+            PyErr_SetString(PyExc_TypeError, "set_parameters() only takes keyword arguments");
+            return nullptr;
+        }
+
+        if (self->engine->isBusy)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "the engine is processing in another thread");
+            return nullptr;
+        }
+
+        // the values are checked on a copy so nothing changes if one of them is wrong
+        EngineParameters parameters = self->engine->parameters;
+
+        PyObject* key;
+        PyObject* value;
+        Py_ssize_t position = 0;
+
+        while (kwargs != nullptr && PyDict_Next(kwargs, &position, &key, &value))
+        {
+            const char* name = PyUnicode_AsUTF8(key);
+
+            if (name == nullptr)
+                return nullptr;
+
+            std::string parameter(name);
+            double number = 0.0;
+            bool isValid = true;
+
+            if (parameter == "mode")
+                isValid = getChoice(value, modeNames, name, parameters.mode);
+            else if (parameter == "lfo_type")
+                isValid = getChoice(value, waveNames, name, parameters.lfoType);
+            else if (parameter == "latency_mode")
+                isValid = getChoice(value, latencyNames, name, parameters.latencyMode);
+            else if (parameter == "interpolation")
+                isValid = getChoice(value, interpolationNames, name, parameters.interpolation);
+            else if (parameter == "filter_bypass")
+            {
+                int isTrue = PyObject_IsTrue(value);
+                parameters.filterBypass = isTrue == 1;
+                isValid = isTrue >= 0;
+            }
+            else if (parameter == "voices")
+            {
+                parameters.voices = PyLong_AsLong(value);
+                isValid = !PyErr_Occurred();
+
+                if (isValid && (parameters.voices < 1 || parameters.voices > 64))
+                {
+                    PyErr_SetString(PyExc_ValueError, "voices must be from 1 to 64");
+                    isValid = false;
+                }
+            }
+            else if (!getNumber(value, number))
+                isValid = false;
+            else if (auto* range = findNumberRange(parameter))
+            {
+                // this is also false for nan
+                if (number >= range->minimum && number <= range->maximum)
+                {
+                    parameters.*(range->value) = number;
+                }
+                else
+                {
+                    // PyErr_Format() doesn't take floats
+                    char message[128];
+                    std::snprintf(message, sizeof(message), "%s must be a finite number from %g to %g", name, range->minimum, range->maximum);
+                    PyErr_SetString(PyExc_ValueError, message);
+                    isValid = false;
+                }
+            }
+            else
+            {
+                PyErr_Format(PyExc_TypeError, "unknown parameter %s", name);
+                isValid = false;
+            }
+
+            if (!isValid)
+                return nullptr;
+        }
+
+        self->engine->parameters = parameters;
+        self->engine->update();
+
+        Py_RETURN_NONE;
+    }
+
+    PyObject* engineGetParameters(EngineObject* self, PyObject*)
+    {
+        if (!checkEngine(self))
+            return nullptr;
+
+        auto& parameters = self->engine->parameters;
+
+        return Py_BuildValue("{s:d,s:d,s:d,s:d,s:d,s:s,s:l,s:d,s:s,s:d,s:d,s:d,s:d,s:O,s:s,s:d,s:s,s:d}",
+            "rate", parameters.rate,
+            "depth", parameters.depth,
+            "mix", parameters.mix,
+            "delay", parameters.delay,
+            "width", parameters.width,
+            "mode", modeNames[static_cast<size_t>(parameters.mode)],
+            "voices", parameters.voices,
+            "spread", parameters.spread,
+            "lfo_type", waveNames[static_cast<size_t>(parameters.lfoType)],
+            "phase_left", parameters.phaseLeft,
+            "phase_right", parameters.phaseRight,
+            "high_pass", parameters.highPass,
+            "low_pass", parameters.lowPass,
+            "filter_bypass", parameters.filterBypass ? Py_True : Py_False,
+            "latency_mode", latencyNames[static_cast<size_t>(parameters.latencyMode)],
+            "latency_reference", parameters.latencyReference,
+            "interpolation", interpolationNames[static_cast<size_t>(parameters.interpolation)],
+            "lfo_control_rate", parameters.lfoControlRate);
+    }
+
+    PyObject* engineReset(EngineObject* self, PyObject*)
+    {
+        if (!checkEngine(self))
+            return nullptr;
+
+        if (self->engine->isBusy)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "the engine is processing in another thread");
+            return nullptr;
+        }
+
+        self->engine->reset();
+        Py_RETURN_NONE;
+    }
+
+    PyObject* engineProcess(EngineObject* self, PyObject* args, PyObject* kwargs)
+    {
+        static const char* keywords[] = { "audio", "out", nullptr };
+
+        PyObject* audio = nullptr;
+        PyObject* out = Py_None;
+
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", const_cast<char**>(keywords), &audio, &out) || !checkEngine(self))
+            return nullptr;
+
+        bool isInPlace = out == Py_None || out == audio;
+        PyObject* result = isInPlace ? audio : out;
+
+        // the views keep the memory from being freed or resized while the gil is released
+        Py_buffer input{};
+        Py_buffer output{};
+
+        if (PyObject_GetBuffer(audio, &input, PyBUF_STRIDES | PyBUF_FORMAT | (isInPlace ? PyBUF_WRITABLE : 0)) != 0)
+            return nullptr;
+
+        if (!isInPlace && PyObject_GetBuffer(out, &output, PyBUF_STRIDES | PyBUF_FORMAT | PyBUF_WRITABLE) != 0)
+        {
+            PyBuffer_Release(&input);
+            return nullptr;
+        }
+
+        auto& engine = *self->engine;
+        std::vector<char*> inputs;
+        std::vector<char*> outputs;
+        Py_ssize_t numSamples = 0;
+        Py_ssize_t numOutputSamples = 0;
+
+        bool isValid = getChannels(input, engine, inputs, numSamples);
+
+        if (isValid && !isInPlace)
+        {
+            isValid = getChannels(output, engine, outputs, numOutputSamples);
+
+            if (isValid && numOutputSamples != numSamples)
+            {
+                PyErr_SetString(PyExc_ValueError, "the output has a different number of samples");
+                isValid = false;
+            }
+        }
+
+        if (isInPlace)
+            outputs = inputs;
+
+        bool wasBusy = false;
+
+        if (isValid && !engine.isBusy.compare_exchange_strong(wasBusy, true))
+        {
+            PyErr_SetString(PyExc_RuntimeError, "the engine is processing in another thread");
+            isValid = false;
+        }
+
+        if (isValid)
+        {
+            Py_BEGIN_ALLOW_THREADS
+
+            if (engine.isDouble())
+                engine.process(reinterpret_cast<const double* const*>(inputs.data()), reinterpret_cast<double* const*>(outputs.data()),
+                    static_cast<size_t>(numSamples));
+            else
+                engine.process(reinterpret_cast<const float* const*>(inputs.data()), reinterpret_cast<float* const*>(outputs.data()),
+                    static_cast<size_t>(numSamples));
+
+            Py_END_ALLOW_THREADS
+
+            engine.isBusy = false;
+        }
+
+        PyBuffer_Release(&input);
+
+        if (!isInPlace)
+            PyBuffer_Release(&output);
+
+        if (!isValid)
+            return nullptr;
+
+        Py_INCREF(result);
+        return result;
+    }
+
+    PyObject* engineGetLatency(EngineObject* self, void*)
+    {
+        return checkEngine(self) ? PyLong_FromLong(self->engine->getLatency()) : nullptr;
+    }
+
+    PyObject* engineGetSampleRate(EngineObject* self, void*)
+    {
+        return checkEngine(self) ? PyFloat_FromDouble(self->engine->getSampleRate()) : nullptr;
+    }
+
+    PyObject* engineGetChannels(EngineObject* self, void*)
+    {
+        return checkEngine(self) ? PyLong_FromSize_t(self->engine->getNumChannels()) : nullptr;
+    }
+
+    PyObject* engineGetBlockSize(EngineObject* self, void*)
+    {
+        return checkEngine(self) ? PyLong_FromSize_t(self->engine->getBlockSize()) : nullptr;
+    }
+
+    PyObject* engineGetDtype(EngineObject* self, void*)
+    {
+        return checkEngine(self) ? PyUnicode_FromString(self->engine->isDouble() ? "float64" : "float32") : nullptr;
+    }
+
+    //==============================================================================
+    PyMethodDef engineMethods[] =
+    {
+        { "process", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(engineProcess)), METH_VARARGS | METH_KEYWORDS,
+            "process(audio, out=None)\n--\n\n"
+            "Processes audio with the shape (channels, samples), in place or into out, and returns the output.\n"
+            "The gil is released while processing." },
+        { "set_parameters", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(engineSetParameters)), METH_VARARGS | METH_KEYWORDS,
+            "set_parameters(**parameters)\n--\n\n"
+            "Sets any of rate, depth, mix, delay, width, mode, voices, spread, lfo_type, phase_left, phase_right,\n"
+            "high_pass, low_pass, filter_bypass, latency_mode, latency_reference, interpolation and lfo_control_rate.\n"
+            "The continuous parameters glide to their new values like they do in the plugin." },
+        { "get_parameters", reinterpret_cast<PyCFunction>(engineGetParameters), METH_NOARGS,
+            "get_parameters()\n--\n\nReturns the parameters as a dict." },
+        { "reset", reinterpret_cast<PyCFunction>(engineReset), METH_NOARGS,
+            "reset()\n--\n\nClears the delay lines and filters and restarts the lfos, eg. between clips." },
+        { nullptr, nullptr, 0, nullptr }
+    };
+
+    PyGetSetDef engineProperties[] =
+    {
+        { "latency", reinterpret_cast<getter>(engineGetLatency), nullptr, "the latency in samples", nullptr },
+        { "sample_rate", reinterpret_cast<getter>(engineGetSampleRate), nullptr, "the sample rate", nullptr },
+        { "channels", reinterpret_cast<getter>(engineGetChannels), nullptr, "the number of channels", nullptr },
+        { "block_size", reinterpret_cast<getter>(engineGetBlockSize), nullptr, "the size of the blocks the audio is processed in", nullptr },
+        { "dtype", reinterpret_cast<getter>(engineGetDtype), nullptr, "float32 or float64", nullptr },
+        { nullptr, nullptr, nullptr, nullptr, nullptr }
+    };
+
+    PyType_Slot engineSlots[] =
+    {
+        { Py_tp_init, reinterpret_cast<void*>(engineInit) },
+        { Py_tp_dealloc, reinterpret_cast<void*>(engineDealloc) },
+        { Py_tp_methods, engineMethods },
+        { Py_tp_getset, engineProperties },
+        { Py_tp_doc, const_cast<char*>("Engine(sample_rate, channels=2, block_size=512, dtype='float32')\n--\n\n"
+            "A chorus engine for audio with the given sample rate, number of channels and sample type.") },
+        { 0, nullptr }
+    };
+
+    PyType_Spec engineSpec =
+    {
+        "chorus.Engine",
+        sizeof(EngineObject),
+        0,
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+        engineSlots
+    };
+
+    PyModuleDef chorusModule =
+    {
+        PyModuleDef_HEAD_INIT,
+        "chorus",
+        "Python bindings for the chorus engine.",
+        -1,
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr
+    };
+}
+
+} // dingus
+
+//==============================================================================
+PyMODINIT_FUNC PyInit_chorus()
+{
+    PyObject* module = PyModule_Create(&dingus::chorusModule);
+
+    if (module == nullptr)
+        return nullptr;
+
+    PyObject* engineType = PyType_FromSpec(&dingus::engineSpec);
+
+    if (engineType == nullptr || PyModule_AddObject(module, "Engine", engineType) != 0)
+    {
+        Py_XDECREF(engineType);
+        Py_DECREF(module);
+        return nullptr;
+    }
+
+    return module;
+}
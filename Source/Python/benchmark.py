@@ -0,0 +1,100 @@
+#
+#   benchmark.py
+#   Created: 20 Oct 2026 1:02:17am
+#   Author:  Daniel Schwartz
+#
+#   measures how many clips per second the python bindings render, with one engine per thread
+#   given chorus-bench it runs `chorus-bench clips` with the same clips and prints the overhead of the bindings against it
+#
+#       python3 benchmark.py [clips] [seconds per clip] [threads] [path to chorus-bench]
+#
+
+import re
+import subprocess
+import sys
+import threading
+import time
+
+import numpy as np
+
+import chorus
+
+clips = int(sys.argv[1]) if len(sys.argv) > 1 else 40
+length = float(sys.argv[2]) if len(sys.argv) > 2 else 5.0
+threads = int(sys.argv[3]) if len(sys.argv) > 3 else 4
+native_bench = sys.argv[4] if len(sys.argv) > 4 else None
+
+# the fastest of a few runs, with one run of chorus-bench before each so both see the same load
+runs = 5
+
+sample_rate = 48000
+parameters = dict(rate=1.5, depth=0.7, width=0.3, mode="dimension", voices=4, lfo_type="sine")
+
+
+def render(engine, audio, output, count):
+    for _ in range(count):
+        engine.reset()
+        engine.process(audio, out=output)
+
+
+# the clips per second of one run of chorus-bench clips for each dtype and thread count
+def measure_native():
+    output = subprocess.run([native_bench, "clips", str(clips), str(length), str(threads), "1"],
+                            check=True, capture_output=True, text=True).stdout
+    pattern = re.compile(r"(float\d+), (\d+) thread\(s\): ([\d.]+) clips/s")
+    return {(match.group(1), int(match.group(2))): float(match.group(3)) for match in pattern.finditer(output)}
+
+
+# the engines and the audio of a dtype and thread count
+def prepare(dtype, num_threads):
+    audio = np.random.default_rng(1).uniform(-1.0, 1.0, (2, int(sample_rate * length))).astype(dtype)
+    engines = []
+
+    for _ in range(num_threads):
+        engine = chorus.Engine(sample_rate, channels=2, block_size=512, dtype=dtype)
+        engine.set_parameters(**parameters)
+        engines.append(engine)
+
+    return engines, audio
+
+
+# the clips per second of one run
+def measure(engines, audio):
+    workers = []
+
+    for index, engine in enumerate(engines):
+        count = clips // len(engines) + (1 if index < clips % len(engines) else 0)
+        workers.append(threading.Thread(target=render, args=(engine, audio, np.empty_like(audio), count)))
+
+    start = time.perf_counter()
+
+    for worker in workers:
+        worker.start()
+
+    for worker in workers:
+        worker.join()
+
+    return clips / (time.perf_counter() - start)
+
+
+keys = [(dtype, num_threads) for dtype in ("float32", "float64") for num_threads in sorted({1, threads})]
+setups = {key: prepare(*key) for key in keys}
+rates = {}
+native = {}
+
+for _ in range(runs):
+    if native_bench:
+        for key, rate in measure_native().items():
+            native[key] = max(native.get(key, 0.0), rate)
+
+    for key in keys:
+        rates[key] = max(rates.get(key, 0.0), measure(*setups[key]))
+
+for key in keys:
+    line = "%s, %d thread(s): %.1f clips/s of %g s" % (key[0], key[1], rates[key], length)
+
+    # the overhead is the extra time per clip over the native engine
+    if key in native:
+        line += ", native %.1f clips/s, binding overhead %.1f%%" % (native[key], 100.0 * (native[key] / rates[key] - 1.0))
+
+    print(line)
@@ -0,0 +1,626 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 4:26:53am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ReferenceChorus.h"
+#include "../DSP/ChorusEngine.h"
+#include "../DSP/ChorusEngineBatch.h"
+
+//==============================================================================
+// chorus-verify [runs] [seconds] [seed]
+//     runs random parameter sequences and signals through the reference chorus and every optimized backend,
+//     prints the largest difference from the reference and the speedup of each backend,
+//     and fails if a backend's output isn't bit exact or the reference's output is too quiet to show a difference
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // the plugin's lfo control rate
+    const float pluginControlRate{ 2500.0f };
+
+    //==============================================================================
+    // the parameters that are applied to the reference and a backend together
+    struct Settings
+    {
+        float rate{ 2.0f };
+        float depth{ 0.5f };
+        float mix{ 0.5f };
+        float delayTime{ 0.005f };
+        float width{ 0.0f };
+        float spread{ 1.0f };
+        float phaseLeft{ 0.5f };
+        float phaseRight{ 0.0f };
+        float highPass{ 20.0f };
+        float lowPass{ 20000.0f };
+        bool filterBypass{ false };
+        dingus::Mode mode{ dingus::Mode::STEREO };
+        size_t numVoices{ 1 };
+        dingus::WaveType lfoType{ dingus::WaveType::TRI };
+        dingus::Interpolation interpolation{ dingus::Interpolation::LINEAR };
+        dingus::LatencyMode latencyMode{ dingus::LatencyMode::ZERO };
+        float referenceDelay{ 0.005f };
+    };
+
+    // sets the discrete parameters without a fade
+    template<typename EngineType>
+    void applyDiscreteSettings(EngineType& engine, const Settings& settings)
+    {
+        engine.setMode(settings.mode);
+        engine.setNumVoice(settings.numVoices);
+        engine.setLfoType(settings.lfoType);
+    }
+
+    // applies the settings to a ChorusEngine or the reference, the discrete parameters are faded after the first block
+    template<typename EngineType>
+    void applySettings(EngineType& engine, const Settings& settings, bool hasProcessed)
+    {
+        engine.setRate(settings.rate);
+        engine.setDepth(settings.depth);
+        engine.setMix(settings.mix);
+        engine.setDelayTime(settings.delayTime);
+        engine.setDelayWidth(settings.width);
+        engine.setVoiceSpread(settings.spread);
+        engine.setPhaseOffset(settings.phaseLeft, 0);
+        engine.setPhaseOffset(settings.phaseRight, 1);
+        engine.setHighPass(settings.highPass);
+        engine.setLowPass(settings.lowPass);
+        engine.setFilterBypass(settings.filterBypass);
+        engine.setInterpolation(settings.interpolation);
+        engine.setLatencyMode(settings.latencyMode);
+        engine.setReferenceDelay(settings.referenceDelay);
+
+        if (hasProcessed)
+        {
+            engine.setDiscreteParameters(settings.mode, settings.numVoices, settings.lfoType);
+            return;
+        }
+
+        applyDiscreteSettings(engine, settings);
+    }
+
+    //==============================================================================
+    // runs the tasks of an engine on a worker thread
+    class WorkerTaskRunner : public dingus::TaskRunner
+    {
+    public:
+        WorkerTaskRunner() : m_thread([this]() { work(); }) {}
+
+        ~WorkerTaskRunner()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_isStopping = true;
+            }
+
+            m_taskAdded.notify_one();
+            m_thread.join();
+        }
+
+        void run(std::function<void()> task) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+
+            m_taskAdded.notify_one();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_taskAdded;
+        std::deque<std::function<void()>> m_tasks;
+        bool m_isStopping{ false };
+        std::thread m_thread;
+
+        void work()
+        {
+            for (;;)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_taskAdded.wait(lock, [this]() { return m_isStopping || !m_tasks.empty(); });
+
+                if (m_tasks.empty())
+                    return;
+
+                auto task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+                lock.unlock();
+
+                task();
+            }
+        }
+    };
+
+    //==============================================================================
+    // something that processes the chorus in place, the reference or an optimized backend
+    template<typename SampleType>
+    class Backend
+    {
+    public:
+        virtual ~Backend() = default;
+
+        virtual void prepare(const dingus::ProcessSpec& spec) = 0;
+        virtual void applyDiscrete(const Settings& settings) = 0;
+        virtual void apply(const Settings& settings, bool hasProcessed) = 0;
+        virtual void process(dingus::AudioBlock<SampleType> block) = 0;
+    };
+
+    template<typename SampleType, typename EngineType>
+    class EngineBackend : public Backend<SampleType>
+    {
+    public:
+        EngineType engine;
+
+        void prepare(const dingus::ProcessSpec& spec) override
+        {
+            engine.prepare(spec);
+        }
+
+        void applyDiscrete(const Settings& settings) override
+        {
+            applyDiscreteSettings(engine, settings);
+        }
+
+        void apply(const Settings& settings, bool hasProcessed) override
+        {
+            applySettings(engine, settings, hasProcessed);
+        }
+
+        void process(dingus::AudioBlock<SampleType> block) override
+        {
+            dingus::ProcessContextReplacing<SampleType> context(block);
+            engine.process(context);
+        }
+
+        // keeps a task runner alive for as long as the engine
+        std::unique_ptr<WorkerTaskRunner> taskRunner;
+    };
+
+    template<typename SampleType>
+    class BatchBackend : public Backend<SampleType>
+    {
+    public:
+        dingus::ChorusEngineBatch<SampleType> batch;
+
+        void prepare(const dingus::ProcessSpec& spec) override
+        {
+            batch.prepare({ spec.sampleRate, spec.maximumBlockSize, 2 }, spec.numChannels / 2);
+        }
+
+        void applyDiscrete(const Settings& settings) override
+        {
+            applyDiscreteSettings(batch, settings);
+        }
+
+        // the discrete parameters are fixed for a run, see Scenario::FIXED_SWITCHES
+        void apply(const Settings& settings, bool hasProcessed) override
+        {
+            batch.setRate(settings.rate);
+            batch.setDepth(settings.depth);
+            batch.setMix(settings.mix);
+            batch.setDelayTime(settings.delayTime);
+            batch.setDelayWidth(settings.width);
+            batch.setVoiceSpread(settings.spread);
+            batch.setPhaseOffset(settings.phaseLeft, 0);
+            batch.setPhaseOffset(settings.phaseRight, 1);
+            batch.setHighPass(settings.highPass);
+            batch.setLowPass(settings.lowPass);
+            batch.setFilterBypass(settings.filterBypass);
+            batch.setInterpolation(settings.interpolation);
+
+            if (!hasProcessed)
+                applyDiscreteSettings(batch, settings);
+        }
+
+        void process(dingus::AudioBlock<SampleType> block) override
+        {
+            dingus::ProcessContextReplacing<SampleType> context(block);
+            batch.process(context);
+        }
+    };
+
+    //==============================================================================
+    // how the parameters of a run are picked
+    enum class Scenario
+    {
+        // the depth and the mix never reach 0, so the voices always move and are always heard
+        MOVING,
+        // the depth switches between 0 and moving, while it's 0 the voice delay times are held
+        CONSTANT_DELAY,
+        // the mix switches between 0 and heard
+        DRY_MIX,
+        // the mode, voices and lfo type are set once and the latency is 0, as the batch needs
+        FIXED_SWITCHES
+    };
+
+    // the optimized paths that are checked against the reference
+    enum class BackendType
+    {
+        PER_SAMPLE,
+        MONO_INPUT,
+        TASK_RUNNER,
+        CONTROL_RATE,
+        CONSTANT_DELAY,
+        DRY_MIX,
+        BATCH,
+        BATCH_CONTROL_RATE,
+        NUM_BACKENDS
+    };
+
+    struct BackendInfo
+    {
+        const char* name;
+        Scenario scenario;
+        size_t numChannels;
+        size_t numInputChannels;
+
+        // the lfo control rate of the backend and the reference, 0 evaluates the lfo every sample
+        float lfoControlRate;
+    };
+
+    // the reads, the skips, the lfo interpolation and the voice sums do the same arithmetic as the reference,
+    // so every backend has to be bit exact with every interpolation, thiran included
+    const BackendInfo backendInfos[static_cast<size_t>(BackendType::NUM_BACKENDS)]
+    {
+        { "per sample", Scenario::MOVING, 2, 2, 0.0f },
+        { "mono input", Scenario::MOVING, 2, 1, 0.0f },
+        { "task runner", Scenario::MOVING, 4, 4, 0.0f },
+        { "control rate", Scenario::MOVING, 2, 2, pluginControlRate },
+        { "constant delay", Scenario::CONSTANT_DELAY, 2, 2, 0.0f },
+        { "dry mix", Scenario::DRY_MIX, 2, 2, 0.0f },
+        { "batch", Scenario::FIXED_SWITCHES, 8, 8, 0.0f },
+        { "batch control rate", Scenario::FIXED_SWITCHES, 8, 8, pluginControlRate }
+    };
+
+    // the reference's output has to reach this peak in a run, so a run can't pass on silence
+    // the test signals are at least 0.25 and reach the output through the dry signal or the voices
+    const double minimumPeak{ 0.1 };
+
+    template<typename SampleType>
+    std::unique_ptr<Backend<SampleType>> createBackend(BackendType type)
+    {
+        auto& info = backendInfos[static_cast<size_t>(type)];
+
+        if (type == BackendType::BATCH || type == BackendType::BATCH_CONTROL_RATE)
+        {
+            auto backend = std::make_unique<BatchBackend<SampleType>>();
+            backend->batch.setLfoControlRate(info.lfoControlRate);
+            return backend;
+        }
+
+        auto backend = std::make_unique<EngineBackend<SampleType, dingus::ChorusEngine<SampleType>>>();
+        backend->engine.setNumInputChannels(info.numInputChannels);
+        backend->engine.setLfoControlRate(info.lfoControlRate);
+
+        if (type == BackendType::TASK_RUNNER)
+        {
+            backend->taskRunner = std::make_unique<WorkerTaskRunner>();
+            backend->engine.setTaskRunner(backend->taskRunner.get());
+            backend->engine.setUseTaskRunner(true);
+        }
+
+        return backend;
+    }
+
+    //==============================================================================
+    float getUniform(std::mt19937& random, float minimum, float maximum)
+    {
+        return std::uniform_real_distribution<float>(minimum, maximum)(random);
+    }
+
+    // a log scale for rates and cutoffs
+    float getExponential(std::mt19937& random, float minimum, float maximum)
+    {
+        return minimum * std::pow(maximum / minimum, getUniform(random, 0.0f, 1.0f));
+    }
+
+    // picks new settings, state is flipped on each call in the scenarios that switch something to 0
+    Settings getRandomSettings(std::mt19937& random, Scenario scenario, const Settings& last, bool isFirst, bool& state)
+    {
+        const size_t voiceChoices[]{ 1, 2, 3, 4, 6, 8, 16, 64 };
+
+        Settings settings;
+        settings.rate = getExponential(random, 0.01f, 20.0f);
+        settings.depth = getUniform(random, 0.05f, 1.0f);
+        settings.mix = random() % 4 == 0 ? 1.0f : getUniform(random, 0.05f, 1.0f);
+        settings.delayTime = getUniform(random, 0.005f, 0.075f);
+        settings.width = getUniform(random, 0.0f, 1.0f);
+        settings.spread = getUniform(random, 0.0f, 1.0f);
+        settings.phaseLeft = getUniform(random, 0.0f, 1.0f);
+        settings.phaseRight = getUniform(random, 0.0f, 1.0f);
+        settings.highPass = getExponential(random, 20.0f, 2000.0f);
+        settings.lowPass = getExponential(random, 500.0f, 20000.0f);
+        settings.filterBypass = random() % 4 == 0;
+        settings.mode = static_cast<dingus::Mode>(random() % 4);
+        settings.numVoices = voiceChoices[random() % 8];
+        settings.lfoType = static_cast<dingus::WaveType>(random() % 2);
+        settings.interpolation = static_cast<dingus::Interpolation>(random() % 4);
+        settings.latencyMode = static_cast<dingus::LatencyMode>(random() % 2);
+        settings.referenceDelay = getUniform(random, 0.001f, 0.075f);
+
+        state = !state;
+
+        switch (scenario)
+        {
+        case Scenario::CONSTANT_DELAY:
+            // the constant delay kernel is only used with linear interpolation
+            settings.interpolation = dingus::Interpolation::LINEAR;
+
+            // nothing that moves the voice delay times changes while the depth is 0
+            if (state)
+            {
+                settings.depth = 0.0f;
+                settings.delayTime = last.delayTime;
+                settings.width = last.width;
+                settings.spread = last.spread;
+                settings.mode = last.mode;
+                settings.numVoices = last.numVoices;
+                settings.lfoType = last.lfoType;
+            }
+            break;
+        case Scenario::DRY_MIX:
+            if (state)
+                settings.mix = 0.0f;
+            break;
+        case Scenario::FIXED_SWITCHES:
+            if (!isFirst)
+            {
+                settings.mode = last.mode;
+                settings.numVoices = last.numVoices;
+                settings.lfoType = last.lfoType;
+            }
+
+            settings.latencyMode = dingus::LatencyMode::ZERO;
+            break;
+        case Scenario::MOVING:
+        default:
+            break;
+        }
+
+        return settings;
+    }
+
+    //==============================================================================
+    // the test signal of a channel
+    class Signal
+    {
+    public:
+        Signal(std::mt19937& random, double sampleRate) : m_random(random()), m_type(random() % 5)
+        {
+            m_amplitude = getUniform(random, 0.25f, 1.0f);
+            m_phaseDelta = 2.0 * 3.141592653589793 * static_cast<double>(getExponential(random, 20.0f, 8000.0f)) / sampleRate;
+            m_sweepDelta = m_phaseDelta * 1.0e-5;
+        }
+
+        float getNextSample()
+        {
+            switch (m_type)
+            {
+            case 0:
+                // white noise
+                return m_amplitude * getUniform(m_random, -1.0f, 1.0f);
+            case 1:
+                // a sine
+                m_phase += m_phaseDelta;
+                return m_amplitude * static_cast<float>(std::sin(m_phase));
+            case 2:
+                // a sine sweeping up
+                m_phaseDelta += m_sweepDelta;
+                m_phase += m_phaseDelta;
+                return m_amplitude * static_cast<float>(std::sin(m_phase));
+            case 3:
+                // sparse clicks
+                return m_random() % 2000 == 0 ? m_amplitude : 0.0f;
+            default:
+                // bursts of noise between silence
+                if (m_random() % 20000 == 0)
+                    m_isBurst = !m_isBurst;
+
+                return m_isBurst ? m_amplitude * getUniform(m_random, -1.0f, 1.0f) : 0.0f;
+            }
+        }
+
+    private:
+        std::mt19937 m_random;
+        unsigned m_type;
+        float m_amplitude{ 1.0f };
+        double m_phase{ 0.0 };
+        double m_phaseDelta{ 0.0 };
+        double m_sweepDelta{ 0.0 };
+        bool m_isBurst{ false };
+    };
+
+    //==============================================================================
+    struct RunResult
+    {
+        double maxError{ 0.0 };
+        double referencePeak{ 0.0 };
+        double referenceSeconds{ 0.0 };
+        double backendSeconds{ 0.0 };
+        bool isFinite{ true };
+    };
+
+    // runs the reference and a backend side by side with random settings and signals
+    template<typename SampleType>
+    RunResult runBackend(BackendType type, unsigned seed, double seconds)
+    {
+        auto& info = backendInfos[static_cast<size_t>(type)];
+        std::mt19937 random(seed);
+
+        const double sampleRates[]{ 44100.0, 48000.0, 96000.0 };
+        const size_t blockSizes[]{ 64, 256, 512, 1024 };
+
+        double sampleRate = sampleRates[random() % 3];
+        size_t maxBlockSize = blockSizes[random() % 4];
+        size_t numChannels = info.numChannels;
+        dingus::ProcessSpec spec{ sampleRate, static_cast<std::uint32_t>(maxBlockSize), static_cast<std::uint32_t>(numChannels) };
+
+        bool scenarioState = true;
+        Settings settings = getRandomSettings(random, info.scenario, Settings(), true, scenarioState);
+
+        EngineBackend<SampleType, dingus::ReferenceChorus<SampleType>> reference;
+        reference.engine.setNumInputChannels(info.numInputChannels);
+        reference.engine.setLfoControlRate(info.lfoControlRate);
+
+        auto backend = createBackend<SampleType>(type);
+
+        // the first discrete parameters are set before prepare so the engines start with them without a fade, like the batch
+        reference.applyDiscrete(settings);
+        backend->applyDiscrete(settings);
+        reference.prepare(spec);
+        backend->prepare(spec);
+
+        std::vector<Signal> signals;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            signals.emplace_back(random, sampleRate);
+
+        std::vector<std::vector<SampleType>> referenceBuffer(numChannels, std::vector<SampleType>(maxBlockSize));
+        std::vector<std::vector<SampleType>> backendBuffer(numChannels, std::vector<SampleType>(maxBlockSize));
+        std::vector<SampleType*> referenceChannels;
+        std::vector<SampleType*> backendChannels;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            referenceChannels.push_back(referenceBuffer[channel].data());
+            backendChannels.push_back(backendBuffer[channel].data());
+        }
+
+        RunResult result;
+
+        auto totalSamples = static_cast<size_t>(seconds * sampleRate);
+        size_t nextChange = 0;
+
+        for (size_t position = 0; position < totalSamples;)
+        {
+            if (position >= nextChange)
+            {
+                if (position > 0)
+                    settings = getRandomSettings(random, info.scenario, settings, false, scenarioState);
+
+                reference.apply(settings, position > 0);
+                backend->apply(settings, position > 0);
+
+                // the constant delay and the dry mix need to settle before their paths are used
+                double changeTime = info.scenario == Scenario::MOVING ? getUniform(random, 0.01f, 0.3f) : getUniform(random, 0.6f, 1.2f);
+                nextChange = position + static_cast<size_t>(changeTime * sampleRate);
+            }
+
+            size_t numSamples = std::min(totalSamples - position, static_cast<size_t>(1 + random() % maxBlockSize));
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    auto sample = static_cast<SampleType>(signals[channel].getNextSample());
+                    referenceBuffer[channel][i] = sample;
+                    backendBuffer[channel][i] = sample;
+                }
+            }
+
+            dingus::AudioBlock<SampleType> referenceBlock(referenceChannels.data(), numChannels, numSamples);
+            dingus::AudioBlock<SampleType> backendBlock(backendChannels.data(), numChannels, numSamples);
+
+            auto start = Clock::now();
+            reference.process(referenceBlock);
+            auto middle = Clock::now();
+            backend->process(backendBlock);
+            auto end = Clock::now();
+
+            result.referenceSeconds += std::chrono::duration<double>(middle - start).count();
+            result.backendSeconds += std::chrono::duration<double>(end - middle).count();
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    SampleType expected = referenceBuffer[channel][i];
+                    SampleType actual = backendBuffer[channel][i];
+
+                    if (!std::isfinite(expected) || !std::isfinite(actual))
+                        result.isFinite = false;
+
+                    result.maxError = std::max(result.maxError, static_cast<double>(std::abs(expected - actual)));
+                    result.referencePeak = std::max(result.referencePeak, static_cast<double>(std::abs(expected)));
+                }
+            }
+
+            position += numSamples;
+        }
+
+        return result;
+    }
+
+    //==============================================================================
+    template<typename SampleType>
+    bool verify(const char* typeName, size_t numRuns, double seconds, unsigned seed)
+    {
+        bool passed = true;
+
+        for (size_t backend = 0; backend < static_cast<size_t>(BackendType::NUM_BACKENDS); ++backend)
+        {
+            auto type = static_cast<BackendType>(backend);
+            auto& info = backendInfos[backend];
+            RunResult total;
+
+            // the quietest run is printed, it has to reach minimumPeak
+            double minPeak = std::numeric_limits<double>::max();
+
+            for (size_t run = 0; run < numRuns; ++run)
+            {
+                auto result = runBackend<SampleType>(type, seed + static_cast<unsigned>(run), seconds);
+                total.maxError = std::max(total.maxError, result.maxError);
+                total.referenceSeconds += result.referenceSeconds;
+                total.backendSeconds += result.backendSeconds;
+                total.isFinite = total.isFinite && result.isFinite;
+                minPeak = std::min(minPeak, result.referencePeak);
+            }
+
+            bool isExact = total.isFinite && total.maxError == 0.0;
+            bool isAudible = minPeak >= minimumPeak;
+            passed = passed && isExact && isAudible;
+
+            std::printf("%-20s %-7s max error %-9.3g reference peak %-6.3g speedup %.2fx%s%s\n", info.name, typeName, total.maxError,
+                minPeak, total.referenceSeconds / total.backendSeconds, isExact ? "" : "  FAILED", isAudible ? "" : "  TOO QUIET");
+            std::fflush(stdout);
+        }
+
+        return passed;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    size_t numRuns = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 10;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 1;
+
+    bool passed = verify<float>("float", numRuns, seconds, seed);
+    passed = verify<double>("double", numRuns, seconds, seed) && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,786 @@
+/*
+  ==============================================================================
+
+    ReferenceChorus.cpp
+    Created: 20 Oct 2026 3:41:08am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#include "ReferenceChorus.h"
+
+namespace dingus
+{
+
+//==============================================================================
+template<typename SampleType>
+constexpr size_t ReferenceChorus<SampleType>::maxVoices;
+
+template<typename SampleType>
+constexpr size_t ReferenceChorus<SampleType>::Lfo::tableSize;
+
+template<typename SampleType>
+ReferenceChorus<SampleType>::ReferenceChorus()
+{
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setNumInputChannels(size_t numInputChannels)
+{
+    m_numInputChannels = numInputChannels;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::prepare(const ProcessSpec& spec)
+{
+    assert(spec.numChannels > 0);
+    assert(m_numInputChannels <= spec.numChannels);
+
+    if (m_numInputChannels != 1)
+        m_numInputChannels = spec.numChannels;
+
+    m_channels.resize(spec.numChannels);
+    m_sampleRate = static_cast<SampleType>(spec.sampleRate);
+
+    size_t dryDelaySize = static_cast<size_t>(std::ceil(m_maxReferenceDelay * m_sampleRate)) + 1;
+    size_t delayLineSize = static_cast<size_t>(std::ceil(m_maxDelayTime * m_sampleRate));
+
+    auto boostCoef = BiquadCoefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(13e-1));
+    auto cutCoef = BiquadCoefficients<SampleType>::makeLowShelf(spec.sampleRate, m_crossoverFreq, SampleType(1), SampleType(7e-1));
+
+    for (size_t channel = 0; channel < m_channels.size(); ++channel)
+    {
+        auto& state = m_channels[channel];
+
+        // channels are paired in order, a last odd channel is on its own
+        state.side = channel % 2;
+        state.partner = channel % 2 == 0 ? std::min(channel + 1, m_channels.size() - 1) : channel - 1;
+
+        state.dryDelay.resize(dryDelaySize);
+        state.delayLine.resize(delayLineSize);
+        state.lfo.prepare(spec.sampleRate);
+        state.depth.reset(spec.sampleRate, 0.2);
+
+        for (auto& delayTime : state.delayTimes)
+            delayTime.reset(spec.sampleRate, 0.5);
+
+        state.boostFilter.reset();
+        state.boostFilter.coefficients = boostCoef;
+        state.cutFilter.reset();
+        state.cutFilter.coefficients = cutCoef;
+    }
+
+    // nothing is playing so every voice jumps to its delay time, like the engine
+    updateDelayTime(0, maxVoices, true);
+
+    m_dryDelaySamples = static_cast<size_t>(roundToInt(m_referenceDelay * m_sampleRate));
+    clearAllpassStates();
+
+    m_controlInterval = getControlInterval(spec.sampleRate, static_cast<double>(m_lfoControlRate));
+    clearLfoValues();
+
+    m_wetBlock = m_wetStorage.allocate(spec.numChannels, spec.maximumBlockSize);
+    m_alignedBlock = m_alignedStorage.allocate(spec.numChannels, spec.maximumBlockSize);
+    m_bandLimiter.prepare(spec);
+
+    m_mixLevel.reset(spec.sampleRate, 0.2);
+    m_mixGains.assign(spec.maximumBlockSize, SampleType(0));
+
+    applyPendingSwitch();
+    m_switchFade.reset(spec.sampleRate, static_cast<double>(m_switchFadeTime));
+    m_switchFade.setCurrentAndTargetValue(SampleType(1));
+    m_switchGains.assign(spec.maximumBlockSize, SampleType(1));
+
+    m_mixMode = m_mode;
+    m_modeFade.reset(spec.sampleRate, static_cast<double>(m_modeFadeTime));
+    m_modeFade.setCurrentAndTargetValue(SampleType(1));
+    m_fadeOutGains.assign(spec.maximumBlockSize, SampleType(0));
+    m_fadeInGains.assign(spec.maximumBlockSize, SampleType(1));
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::reset()
+{
+    for (auto& state : m_channels)
+    {
+        state.delayLine.clear();
+        state.lfo.phase = 0;
+        state.dryDelay.clear();
+        state.boostFilter.reset();
+        state.cutFilter.reset();
+    }
+
+    clearAllpassStates();
+    clearLfoValues();
+    m_bandLimiter.reset();
+}
+
+//==============================================================================
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::processBlock(const AudioBlock<const SampleType>& inputBlock,
+    const AudioBlock<SampleType>& outputBlock) noexcept
+{
+    auto numSamples = outputBlock.getNumSamples();
+    auto numChannels = outputBlock.getNumChannels();
+    auto wetBlock = m_wetBlock.getSubBlock(0, numSamples);
+    auto alignedBlock = m_alignedBlock.getSubBlock(0, numSamples);
+
+    bool isSwitchFading = updateSwitchFade(numSamples);
+
+    LatencyMode currentLatencyMode = m_latencyMode;
+    bool isAligned = currentLatencyMode == LatencyMode::ALIGNED;
+
+    if (currentLatencyMode != m_lastLatencyMode)
+    {
+        for (auto& state : m_channels)
+            state.dryDelay.clear();
+
+        m_lastLatencyMode = currentLatencyMode;
+    }
+
+    // a mono input is delayed for every channel
+    if (isAligned)
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* input = inputBlock.getChannelPointer(m_numInputChannels == 1 ? 0 : channel);
+            auto* aligned = alignedBlock.getChannelPointer(channel);
+            auto& dryDelay = m_channels[channel].dryDelay;
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                dryDelay.push(input[i]);
+                aligned[i] = dryDelay.get(m_dryDelaySamples);
+            }
+        }
+    }
+
+    AudioBlock<const SampleType> dryBlock(inputBlock);
+
+    if (isAligned)
+        dryBlock = alignedBlock;
+
+    bool isModeFading = updateModeFade(numSamples);
+
+    // the wet signal is muted once the mix has settled at 0, the filters aren't run while it is
+    bool isMuted = false;
+
+    if (!m_mixLevel.isSmoothing() && !isSwitchFading)
+        isMuted = m_mixLevel.getTargetValue() * m_switchFade.getTargetValue() == SampleType(0);
+
+    updateMixGains(numSamples);
+
+    // the engine skips the allpass states while the wet signal is muted, so they start from 0 when it's heard again
+    if (!isMuted && m_isWetMuted)
+        clearAllpassStates();
+
+    // the voices always run
+    processVoices(inputBlock, dryBlock, wetBlock);
+
+    if (isMuted)
+    {
+        m_isWetMuted = true;
+    }
+    else
+    {
+        if (m_isWetMuted)
+        {
+            m_bandLimiter.reset();
+
+            for (auto& state : m_channels)
+                state.cutFilter.reset();
+
+            m_isWetMuted = false;
+        }
+
+        ProcessContextReplacing<SampleType> filterContext(wetBlock);
+        m_bandLimiter.process(filterContext);
+    }
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto* dry = dryBlock.getChannelPointer(channel);
+        auto* wetA = wetBlock.getChannelPointer(channel);
+        auto* wetB = wetBlock.getChannelPointer(m_channels[channel].partner);
+        auto* output = outputBlock.getChannelPointer(channel);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            SampleType mixed = mixSample(m_mixMode, channel, dry[i], wetA[i], wetB[i], m_mixGains[i], isMuted);
+
+            if (isModeFading)
+            {
+                SampleType fadedOut = mixSample(m_fadeFromMode, channel, dry[i], wetA[i], wetB[i], m_mixGains[i], isMuted);
+                mixed = fadedOut * m_fadeOutGains[i] + mixed * m_fadeInGains[i];
+            }
+
+            output[i] = mixed;
+        }
+    }
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::processVoices(const AudioBlock<const SampleType>& inputBlock,
+    const AudioBlock<const SampleType>& dryBlock, const AudioBlock<SampleType>& wetBlock) noexcept
+{
+    auto numSamples = wetBlock.getNumSamples();
+    auto numChannels = wetBlock.getNumChannels();
+
+    size_t currentVoices = m_activeVoices;
+    SampleType gain = SampleType(1) / std::sqrt(static_cast<SampleType>(currentVoices));
+    size_t interval = m_controlInterval;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto& state = m_channels[channel];
+            SampleType lfoValue{};
+
+            if (interval == 1)
+            {
+                lfoValue = getNextLfoValue(state);
+            }
+            else
+            {
+                // each block starts a control period, the lfo is stepped to the end of the period and the offset
+                // is interpolated from the value at the start of it, the same as ModDelay
+                size_t step = i % interval;
+
+                if (step == 0)
+                {
+                    if (std::isnan(state.lfoValue))
+                        state.lfoValue = getNextLfoValue(state);
+
+                    size_t numSteps = std::min(interval, numSamples - i);
+
+                    for (size_t lfoStep = 0; lfoStep < numSteps; ++lfoStep)
+                        state.nextLfoValue = getNextLfoValue(state);
+
+                    state.lfoIncrement = (state.nextLfoValue - state.lfoValue) / static_cast<SampleType>(numSteps);
+                }
+
+                lfoValue = state.lfoValue + state.lfoIncrement * static_cast<SampleType>(step);
+
+                if (step + 1 == interval || i + 1 == numSamples)
+                    state.lfoValue = state.nextLfoValue;
+            }
+
+            SampleType voiceSum = 0;
+
+            for (size_t voice = 0; voice < currentVoices; ++voice)
+                voiceSum += state.delayLine.read((state.delayTimes[voice].getNextValue() + lfoValue) * m_sampleRate,
+                    m_interpolation, state.allpassStates[voice]);
+
+            wetBlock.getChannelPointer(channel)[i] = dryBlock.getChannelPointer(channel)[i] + voiceSum * gain;
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            m_channels[channel].delayLine.push(inputBlock.getChannelPointer(m_numInputChannels == 1 ? 0 : channel)[i]);
+    }
+
+    // the inactive voices keep moving towards their delay times
+    for (auto& state : m_channels)
+        for (size_t voice = currentVoices; voice < maxVoices; ++voice)
+            state.delayTimes[voice].skip(static_cast<int>(numSamples));
+}
+
+template<typename SampleType>
+SampleType ReferenceChorus<SampleType>::mixSample(Mode mode, size_t channel, SampleType dry, SampleType wetA, SampleType wetB,
+    SampleType mixLevel, bool isMuted) noexcept
+{
+    auto& state = m_channels[channel];
+    bool isPaired = mode != Mode::VIBRATO && state.partner != channel;
+
+    if (!isPaired)
+        return isMuted ? dry : dry * (1 - mixLevel) + wetA * mixLevel;
+
+    switch (mode)
+    {
+    case Mode::STEREO:
+        return isMuted ? dry : dry * (1 - mixLevel) + (wetA - wetB) * mixLevel;
+    case Mode::MONO:
+        return isMuted ? dry : dry * (1 - mixLevel) + (wetA + wetB) * mixLevel * (SampleType(1) / MathConstants<SampleType>::sqrt2);
+    case Mode::DIMENSION:
+    {
+        // the dry signal is boosted even when muted
+        SampleType boosted = state.boostFilter.processSample(dry);
+
+        if (isMuted)
+            return boosted;
+
+        return boosted * (1 - mixLevel) + (wetA - state.cutFilter.processSample(wetB)) * mixLevel;
+    }
+    case Mode::VIBRATO:
+    default:
+        return dry;
+    }
+}
+
+//==============================================================================
+
+template<typename SampleType>
+bool ReferenceChorus<SampleType>::updateSwitchFade(size_t numSamples) noexcept
+{
+    if (m_hasPendingSwitch)
+    {
+        if (!m_switchFade.isSmoothing() && m_switchFade.getCurrentValue() == SampleType(0))
+        {
+            applyPendingSwitch();
+            m_switchFade.setTargetValue(SampleType(1));
+        }
+        else
+        {
+            m_switchFade.setTargetValue(SampleType(0));
+        }
+    }
+
+    bool isFading = m_switchFade.isSmoothing();
+
+    for (size_t i = 0; i < numSamples; ++i)
+        m_switchGains[i] = m_switchFade.getNextValue();
+
+    return isFading;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::updateMixGains(size_t numSamples) noexcept
+{
+    for (size_t i = 0; i < numSamples; ++i)
+        m_mixGains[i] = m_mixLevel.getNextValue() * m_switchGains[i];
+}
+
+template<typename SampleType>
+bool ReferenceChorus<SampleType>::updateModeFade(size_t numSamples) noexcept
+{
+    if (!m_modeFade.isSmoothing() && m_mode != m_mixMode)
+    {
+        m_fadeFromMode = m_mixMode;
+        m_mixMode = m_mode;
+        m_modeFade.setCurrentAndTargetValue(SampleType(0));
+        m_modeFade.setTargetValue(SampleType(1));
+    }
+
+    if (!m_modeFade.isSmoothing())
+        return false;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        SampleType position = m_modeFade.getNextValue() * MathConstants<SampleType>::halfPi;
+        m_fadeOutGains[i] = std::cos(position);
+        m_fadeInGains[i] = std::sin(position);
+    }
+
+    return true;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::applyPendingSwitch()
+{
+    m_mode = m_pendingMode;
+    setActiveVoices(std::min(m_pendingNumVoices, m_voiceLimit));
+
+    for (auto& state : m_channels)
+        state.lfo.type = m_pendingLfoType;
+
+    m_hasPendingSwitch = false;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setActiveVoices(size_t numVoices)
+{
+    assert(numVoices > 0 && numVoices <= maxVoices);
+    size_t lastVoices = m_activeVoices;
+    m_activeVoices = numVoices;
+
+    // the voices that weren't active jump to their delay time
+    updateDelayTime(0, std::min(lastVoices, numVoices), false);
+    updateDelayTime(lastVoices, numVoices, true);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::updateDelayTime(size_t firstVoice, size_t lastVoice, bool force)
+{
+    SampleType spreadVoices = static_cast<SampleType>(std::max(m_activeVoices, size_t(4)));
+
+    for (size_t voice = firstVoice; voice < lastVoice; ++voice)
+    {
+        // the voices are spread down towards 5ms and the right side is scaled down towards 1ms by the width
+        SampleType voiceOffset = m_delayTime - m_spread * (m_delayTime - SampleType(5e-3))
+            * std::min(SampleType(1), static_cast<SampleType>(voice) / spreadVoices);
+
+        for (auto& state : m_channels)
+        {
+            SampleType delayTime = state.side == 1 ? voiceOffset - m_delayWidth * (voiceOffset - SampleType(1e-3)) : voiceOffset;
+            assert(delayTime > SampleType(0) && delayTime < (m_maxDelayTime - m_maxDepth));
+
+            if (force)
+                state.delayTimes[voice].setCurrentAndTargetValue(delayTime);
+            else
+                state.delayTimes[voice].setTargetValue(delayTime);
+        }
+    }
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::clearAllpassStates()
+{
+    for (auto& state : m_channels)
+        state.allpassStates.fill(SampleType(0));
+}
+
+template<typename SampleType>
+SampleType ReferenceChorus<SampleType>::getNextLfoValue(Channel& state) noexcept
+{
+    return (state.lfo.processSample() + SampleType(2)) * SampleType(5e-1) * state.depth.getNextValue();
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::clearLfoValues()
+{
+    for (auto& state : m_channels)
+        state.lfoValue = std::numeric_limits<SampleType>::quiet_NaN();
+}
+
+//==============================================================================
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setMix(SampleType mix)
+{
+    m_mixLevel.setTargetValue(mix);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setHighPass(SampleType cutoff)
+{
+    m_bandLimiter.setHighPass(cutoff);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setLowPass(SampleType cutoff)
+{
+    m_bandLimiter.setLowPass(cutoff);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setFilterBypass(bool bypass)
+{
+    m_bandLimiter.setBypass(bypass);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setRate(SampleType rate)
+{
+    assert(rate >= SampleType(0));
+
+    for (auto& state : m_channels)
+        state.lfo.setFrequency(rate);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setDepth(SampleType depth)
+{
+    for (auto& state : m_channels)
+        state.depth.setTargetValue(depth * m_maxDepth);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setLfoControlRate(SampleType controlRate)
+{
+    assert(controlRate >= SampleType(0));
+    m_lfoControlRate = controlRate;
+
+    size_t interval = getControlInterval(static_cast<double>(m_sampleRate), static_cast<double>(controlRate));
+
+    if (interval == m_controlInterval)
+        return;
+
+    m_controlInterval = interval;
+    clearLfoValues();
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setInterpolation(Interpolation interpolation)
+{
+    assert(interpolation != Interpolation::MAX);
+
+    if (interpolation == m_interpolation)
+        return;
+
+    m_interpolation = interpolation;
+    clearAllpassStates();
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setDelayTime(SampleType delayTime)
+{
+    m_delayTime = delayTime;
+    updateDelayTime(0, m_activeVoices, false);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setDelayWidth(SampleType width)
+{
+    m_delayWidth = width;
+    updateDelayTime(0, m_activeVoices, false);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setVoiceSpread(SampleType spread)
+{
+    m_spread = spread;
+    updateDelayTime(0, m_activeVoices, false);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setMode(Mode mode)
+{
+    m_mode = mode;
+    m_pendingMode = mode;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setNumVoice(size_t numVoices)
+{
+    m_pendingNumVoices = limit(size_t(1), maxVoices, numVoices);
+    setActiveVoices(std::min(m_pendingNumVoices, m_voiceLimit));
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setVoiceLimit(size_t maxVoiceCount)
+{
+    maxVoiceCount = limit(size_t(1), maxVoices, maxVoiceCount);
+
+    if (maxVoiceCount == m_voiceLimit)
+        return;
+
+    if (std::min(m_pendingNumVoices, maxVoiceCount) != std::min(m_pendingNumVoices, m_voiceLimit))
+        m_hasPendingSwitch = true;
+
+    m_voiceLimit = maxVoiceCount;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setDiscreteParameters(Mode mode, size_t numVoices, WaveType lfoType)
+{
+    numVoices = limit(size_t(1), maxVoices, numVoices);
+
+    if (mode == m_pendingMode && numVoices == m_pendingNumVoices && lfoType == m_pendingLfoType)
+        return;
+
+    m_pendingMode = mode;
+    m_pendingNumVoices = numVoices;
+    m_pendingLfoType = lfoType;
+    m_hasPendingSwitch = true;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setPhaseOffset(SampleType phaseOffset, size_t side/* = 0*/)
+{
+    for (auto& state : m_channels)
+        if (state.side == side)
+            state.lfo.phaseOffset.setTargetValue(phaseOffset);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setLfoType(WaveType type)
+{
+    m_pendingLfoType = type;
+
+    for (auto& state : m_channels)
+        state.lfo.type = type;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setLatencyMode(LatencyMode mode)
+{
+    m_latencyMode = mode;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::setReferenceDelay(SampleType delayTime)
+{
+    assert(delayTime >= SampleType(0) && delayTime < m_maxReferenceDelay);
+    m_referenceDelay = limit(SampleType(0), m_maxReferenceDelay, delayTime);
+    m_dryDelaySamples = static_cast<size_t>(roundToInt(m_referenceDelay * m_sampleRate));
+}
+
+template<typename SampleType>
+int ReferenceChorus<SampleType>::getLatency() const
+{
+    if (m_latencyMode == LatencyMode::ALIGNED)
+        return static_cast<int>(m_dryDelaySamples);
+
+    return 0;
+}
+
+//==============================================================================
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::DelayLine::resize(size_t size)
+{
+    data.resize(size);
+    position = 0;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::DelayLine::clear()
+{
+    std::fill(data.begin(), data.end(), SampleType(0));
+    position = 0;
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::DelayLine::push(SampleType value)
+{
+    data[position] = value;
+    position = position == 0 ? data.size() - 1 : position - 1;
+}
+
+template<typename SampleType>
+SampleType ReferenceChorus<SampleType>::DelayLine::get(size_t delayInSamples) const
+{
+    return data[(position + delayInSamples + 1) % data.size()];
+}
+
+template<typename SampleType>
+SampleType ReferenceChorus<SampleType>::DelayLine::read(SampleType delayTime, Interpolation interpolation, SampleType& state) const
+{
+    size_t size = data.size();
+    assert(delayTime >= SampleType(0) && delayTime < static_cast<SampleType>(size - 2));
+
+    // the fraction is taken from the delay alone, the position wraps at most once
+    size_t delayInSamples = static_cast<size_t>(delayTime);
+    SampleType frac = delayTime - static_cast<SampleType>(delayInSamples);
+    size_t index = (position + delayInSamples + 1) % size;
+
+    // the 4 point reads need a newer sample, so they are linear under 1 sample
+    if (interpolation == Interpolation::LINEAR
+        || ((interpolation == Interpolation::HERMITE || interpolation == Interpolation::LAGRANGE) && delayTime < SampleType(1)))
+    {
+        SampleType value0 = data[index];
+        SampleType value1 = data[(index + 1) % size];
+
+        return value0 + frac * (value1 - value0);
+    }
+
+    if (interpolation == Interpolation::THIRAN)
+    {
+        // the allpass delay is kept between 0.618 and 1.618 samples
+        if (frac < SampleType(0.618) && delayTime >= SampleType(1))
+        {
+            index = index == 0 ? size - 1 : index - 1;
+            frac += SampleType(1);
+        }
+
+        SampleType coefficient = (SampleType(1) - frac) / (SampleType(1) + frac);
+        state = coefficient * (data[index] - state) + data[(index + 1) % size];
+
+        return state;
+    }
+
+    // the points at -1, 0, 1 and 2 around the read position
+    SampleType points[4];
+    points[0] = data[index == 0 ? size - 1 : index - 1];
+    points[1] = data[index];
+    points[2] = data[(index + 1) % size];
+    points[3] = data[(index + 2) % size];
+
+    if (interpolation == Interpolation::HERMITE)
+    {
+        SampleType c1 = SampleType(5e-1) * (points[2] - points[0]);
+        SampleType c2 = points[0] - SampleType(25e-1) * points[1] + SampleType(2) * points[2] - SampleType(5e-1) * points[3];
+        SampleType c3 = SampleType(5e-1) * (points[3] - points[0]) + SampleType(15e-1) * (points[1] - points[2]);
+
+        return ((c3 * frac + c2) * frac + c1) * frac + points[1];
+    }
+
+    SampleType fracPlusOne = frac + SampleType(1);
+    SampleType fracMinusOne = frac - SampleType(1);
+    SampleType fracMinusTwo = frac - SampleType(2);
+
+    SampleType h0 = -frac * fracMinusOne * fracMinusTwo / SampleType(6);
+    SampleType h1 = fracPlusOne * fracMinusOne * fracMinusTwo * SampleType(5e-1);
+    SampleType h2 = -fracPlusOne * frac * fracMinusTwo * SampleType(5e-1);
+    SampleType h3 = fracPlusOne * frac * fracMinusOne / SampleType(6);
+
+    return h0 * points[0] + h1 * points[1] + h2 * points[2] + h3 * points[3];
+}
+
+//==============================================================================
+
+template<typename SampleType>
+ReferenceChorus<SampleType>::Lfo::Lfo()
+{
+    size_t triIndex = static_cast<size_t>(WaveType::TRI);
+    size_t sineIndex = static_cast<size_t>(WaveType::SINE);
+
+    for (auto& table : tables)
+        table.assign(tableSize + 1, SampleType(0));
+
+    SampleType currentAngle = MathConstants<SampleType>::pi * SampleType(-1);
+    SampleType angleDelta = MathConstants<SampleType>::twoPi / tableSize;
+
+    for (size_t i = 0; i < tableSize; ++i)
+    {
+        tables[triIndex][i] = (2 / MathConstants<SampleType>::pi) * std::asin(std::sin(currentAngle));
+        tables[sineIndex][i] = std::sin(currentAngle);
+        currentAngle += angleDelta;
+    }
+
+    tables[triIndex][tableSize] = tables[triIndex][0];
+    tables[sineIndex][tableSize] = tables[sineIndex][0];
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::Lfo::prepare(double newSampleRate)
+{
+    phase = 0;
+    sampleRate = static_cast<SampleType>(newSampleRate);
+    phaseToTable = static_cast<SampleType>(static_cast<double>(tableSize) / 4294967296.0);
+    setFrequency(frequency);
+    phaseOffset.reset(newSampleRate, 0.5);
+}
+
+template<typename SampleType>
+void ReferenceChorus<SampleType>::Lfo::setFrequency(SampleType newFrequency)
+{
+    frequency = newFrequency;
+
+    if (sampleRate <= SampleType(0))
+    {
+        phaseDelta = 0;
+        return;
+    }
+
+    // the phase is a 32 bit fraction of a cycle
+    double cycles = 2.0 * static_cast<double>(frequency) / static_cast<double>(sampleRate);
+    phaseDelta = static_cast<std::uint32_t>((cycles - std::floor(cycles)) * 4294967296.0);
+}
+
+template<typename SampleType>
+SampleType ReferenceChorus<SampleType>::Lfo::processSample()
+{
+    SampleType offsetPos = std::fmod(static_cast<SampleType>(phase) * phaseToTable
+        + phaseOffset.getNextValue() * static_cast<SampleType>(tableSize),
+        static_cast<SampleType>(tableSize));
+
+    size_t index0 = static_cast<size_t>(offsetPos);
+    SampleType frac = offsetPos - static_cast<SampleType>(index0);
+
+    auto& table = tables[static_cast<size_t>(type)];
+    SampleType sample = table[index0] + frac * (table[index0 + 1] - table[index0]);
+
+    phase += phaseDelta;
+
+    return sample;
+}
+
+//==============================================================================
+
+template class ReferenceChorus<float>;
+template class ReferenceChorus<double>;
+
+} // dingus
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    ReferenceChorus.h
+    Created: 20 Oct 2026 3:41:08am
+    Author:  Daniel Schwartz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "../DSP/DspCore.h"
+#include "../DSP/ChorusEngine.h"
+
+namespace dingus
+{
+
+//==============================================================================
+/**
+    A frozen scalar copy of the chorus, used as the reference that the optimized engines are checked against.
+    It has the same set functions and the same output as a ChorusEngine, but everything is done one sample at a time.
+    At an lfo control rate the lfo is still stepped every sample and its values at the control points are interpolated
+    in between, the same as ModDelay.  Every voice reads its delay line with the lfo of its channel,
+    there are no constant delay, shared buffer or parallel paths, and the voices keep running while the mix is dry.
+    The delay lines, lfos and voice delay times are copies of DelayBuffer, Oscillator, ModDelay and ChorusVoices,
+    so optimizing those classes can't change the reference.  SmoothedValue, BiquadFilter and BandLimiter are
+    shared with the engine.  The channels are always paired in order.
+    This is meant to stay simple and slow, don't optimize it.
+*/
+template<typename SampleType>
+class ReferenceChorus
+{
+public:
+    static constexpr size_t maxVoices{ 64 };
+
+    ReferenceChorus();
+
+    // sets the number of input channels, this must be called before prepare(), see ChorusEngine
+    void setNumInputChannels(size_t numInputChannels);
+
+    // prepares the chorus for playback
+    void prepare(const ProcessSpec& spec);
+
+    // resets the voices and filters
+    void reset();
+
+    // processes a block of samples using a ProcessContext
+    template<typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        processBlock(context.getInputBlock(), context.getOutputBlock());
+    }
+
+    //==============================================================================
+    // set functions, these match ChorusEngine
+
+    void setMix(SampleType mix);
+    void setHighPass(SampleType cutoff);
+    void setLowPass(SampleType cutoff);
+    void setFilterBypass(bool bypass);
+    void setRate(SampleType rate);
+    void setDepth(SampleType depth);
+    void setLfoControlRate(SampleType controlRate);
+    void setInterpolation(Interpolation interpolation);
+    void setDelayTime(SampleType delayTime);
+    void setDelayWidth(SampleType width);
+    void setVoiceSpread(SampleType spread);
+    void setMode(Mode mode);
+    void setNumVoice(size_t numVoices);
+    void setVoiceLimit(size_t maxVoices);
+    void setDiscreteParameters(Mode mode, size_t numVoices, WaveType lfoType);
+    void setPhaseOffset(SampleType phaseOffset, size_t side = 0);
+    void setLfoType(WaveType type);
+    void setLatencyMode(LatencyMode mode);
+    void setReferenceDelay(SampleType delayTime);
+
+    int getLatency() const;
+
+private:
+    //==============================================================================
+    // a circular buffer, a copy of DelayBuffer
+    struct DelayLine
+    {
+        std::vector<SampleType> data;
+        size_t position{ 0 };
+
+        void resize(size_t size);
+        void clear();
+        void push(SampleType value);
+
+        // reads an integer delay in samples
+        SampleType get(size_t delayInSamples) const;
+
+        // reads a fractional delay in samples, the state is only used by the thiran allpass
+        SampleType read(SampleType delayTime, Interpolation interpolation, SampleType& state) const;
+    };
+
+    // a wavetable lfo, a copy of Oscillator
+    struct Lfo
+    {
+        Lfo();
+
+        static constexpr size_t tableSize{ 128 };
+        std::array<std::vector<SampleType>, static_cast<size_t>(WaveType::MAX)> tables;
+        WaveType type{ WaveType::TRI };
+        SampleType sampleRate{};
+        std::uint32_t phase{ 0 };
+        std::uint32_t phaseDelta{ 0 };
+        SampleType phaseToTable{};
+        SampleType frequency{ SampleType(2) };
+        SmoothedValue<SampleType> phaseOffset{};
+
+        void prepare(double newSampleRate);
+        void setFrequency(SampleType newFrequency);
+        SampleType processSample();
+    };
+
+    // everything that is kept for each channel
+    struct Channel
+    {
+        DelayLine delayLine;
+        Lfo lfo;
+        SmoothedValue<SampleType> depth;
+        std::array<SmoothedValue<SampleType>, maxVoices> delayTimes;
+
+        // at a control rate, the lfo offset at the current sample and the step to the next control point
+        SampleType lfoValue{ std::numeric_limits<SampleType>::quiet_NaN() };
+        SampleType nextLfoValue{};
+        SampleType lfoIncrement{};
+        std::array<SampleType, maxVoices> allpassStates{};
+
+        DelayLine dryDelay;
+        BiquadFilter<SampleType> boostFilter;
+        BiquadFilter<SampleType> cutFilter;
+        size_t partner{ 0 };
+        size_t side{ 0 };
+    };
+
+    std::vector<Channel> m_channels;
+    size_t m_numInputChannels{ 0 };
+    SampleType m_sampleRate{};
+
+    AudioBlockStorage<SampleType> m_wetStorage;
+    AudioBlock<SampleType> m_wetBlock;
+    AudioBlockStorage<SampleType> m_alignedStorage;
+    AudioBlock<SampleType> m_alignedBlock;
+
+    // the voices, see ChorusVoices and ModDelay
+    size_t m_activeVoices{ 1 };
+    SampleType m_delayTime{ SampleType(5e-3) };
+    SampleType m_delayWidth{ SampleType(0) };
+    SampleType m_spread{ 1 };
+    const SampleType m_maxDelayTime{ SampleType(1) };
+    const SampleType m_maxDepth{ SampleType(1e-3) };
+    Interpolation m_interpolation{ Interpolation::LINEAR };
+    SampleType m_lfoControlRate{ SampleType(0) };
+    size_t m_controlInterval{ 1 };
+
+    // the mix, the switch fade and the mode fade, see ChorusEngine
+    SmoothedValue<SampleType> m_mixLevel;
+    std::vector<SampleType> m_mixGains;
+
+    Mode m_mode{ Mode::STEREO };
+    Mode m_mixMode{ Mode::STEREO };
+    Mode m_fadeFromMode{ Mode::STEREO };
+    const SampleType m_modeFadeTime{ SampleType(2e-2) };
+    SmoothedValue<SampleType> m_modeFade{ SampleType(1) };
+    std::vector<SampleType> m_fadeOutGains;
+    std::vector<SampleType> m_fadeInGains;
+
+    Mode m_pendingMode{ Mode::STEREO };
+    size_t m_pendingNumVoices{ 1 };
+    WaveType m_pendingLfoType{ WaveType::TRI };
+    bool m_hasPendingSwitch{ false };
+    size_t m_voiceLimit{ maxVoices };
+
+    const SampleType m_switchFadeTime{ SampleType(1e-2) };
+    SmoothedValue<SampleType> m_switchFade{ SampleType(1) };
+    std::vector<SampleType> m_switchGains;
+    bool m_isWetMuted{ false };
+
+    BandLimiter<SampleType> m_bandLimiter;
+    const SampleType m_crossoverFreq{ SampleType(200) };
+
+    LatencyMode m_latencyMode{ LatencyMode::ZERO };
+    LatencyMode m_lastLatencyMode{ LatencyMode::ZERO };
+    SampleType m_referenceDelay{ SampleType(5e-3) };
+    const SampleType m_maxReferenceDelay{ SampleType(1e-1) };
+    size_t m_dryDelaySamples{ 0 };
+
+    void processBlock(const AudioBlock<const SampleType>& inputBlock, const AudioBlock<SampleType>& outputBlock) noexcept;
+
+    // writes dry + the voices of every channel to the wet block and pushes the input to the delay lines
+    void processVoices(const AudioBlock<const SampleType>& inputBlock, const AudioBlock<const SampleType>& dryBlock,
+        const AudioBlock<SampleType>& wetBlock) noexcept;
+
+    // mixes one sample of a channel in the given mode, a muted mix is only the dry signal
+    SampleType mixSample(Mode mode, size_t channel, SampleType dry, SampleType wetA, SampleType wetB,
+        SampleType mixLevel, bool isMuted) noexcept;
+
+    // returns true if the switch fade moves during the block
+    bool updateSwitchFade(size_t numSamples) noexcept;
+    void updateMixGains(size_t numSamples) noexcept;
+    bool updateModeFade(size_t numSamples) noexcept;
+    void applyPendingSwitch();
+    void setActiveVoices(size_t numVoices);
+    void updateDelayTime(size_t firstVoice, size_t lastVoice, bool force);
+    void clearAllpassStates();
+
+    // steps the lfo and the depth of a channel by a sample and returns the lfo offset in secs
+    SampleType getNextLfoValue(Channel& state) noexcept;
+    void clearLfoValues();
+};
+
+//==============================================================================
+} // dingus